@@ -32,7 +32,8 @@
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 CheatManager::CheatManager(OSystem& osystem)
   : myOSystem(osystem),
-    myListIsDirty(false)
+    myListIsDirty(false),
+    myDatabaseLoaded(false)
 {
 }
 
@@ -216,6 +217,10 @@ void CheatManager::enable(const string& code, bool enable)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void CheatManager::loadCheatDatabase()
 {
+  if(myDatabaseLoaded)
+    return;
+  myDatabaseLoaded = true;
+
   const string& cheatfile = myOSystem.cheatFile();
   ifstream in(cheatfile);
   if(!in)
@@ -278,6 +283,7 @@ void CheatManager::loadCheats(const string& md5sum)
   if(cheats != "")
     myOSystem.settings().setValue("cheat", "");
 
+  loadCheatDatabase();
   const auto& iter = myCheatMap.find(md5sum);
   if(iter == myCheatMap.end() && cheats == "")
     return;
@@ -292,6 +298,8 @@ void CheatManager::loadCheats(const string& md5sum)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void CheatManager::saveCheats(const string& md5sum)
 {
+  loadCheatDatabase();
+
   ostringstream cheats;
   for(uInt32 i = 0; i < myCheatList.size(); i++)
   {
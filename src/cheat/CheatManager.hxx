@@ -100,6 +100,8 @@ class CheatManager
 
     /**
       Load all cheats (for all ROMs) from disk to internal database.
+      This is done automatically the first time the database is needed,
+      and only once.
     */
     void loadCheatDatabase();
 
@@ -157,6 +159,9 @@ class CheatManager
     // Indicates that the list has been modified, and should be saved to disk
     bool myListIsDirty;
 
+    // Indicates that the database has been read from disk
+    bool myDatabaseLoaded;
+
   private:
     // Following constructors and assignment operators not supported
     CheatManager() = delete;
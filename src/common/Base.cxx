@@ -37,7 +37,7 @@ void Base::setHexUppercase(bool enable)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 string Base::toString(int value, Common::Base::Format outputBase)
 {
-  static char vToS_buf[32];
+  char vToS_buf[32];
 
   if(outputBase == Base::F_DEFAULT)
     outputBase = myDefaultBase;
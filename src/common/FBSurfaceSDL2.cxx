@@ -24,6 +24,7 @@ FBSurfaceSDL2::FBSurfaceSDL2(FrameBufferSDL2& buffer,
     mySurface(nullptr),
     myTexture(nullptr),
     mySurfaceIsDirty(true),
+    myTextureIsStale(true),
     myIsVisible(true),
     myTexAccess(SDL_TEXTUREACCESS_STREAMING),
     myInterpolate(false),
@@ -89,6 +90,7 @@ const GUI::Rect& FBSurfaceSDL2::dstRect() const
 void FBSurfaceSDL2::setSrcPos(uInt32 x, uInt32 y)
 {
   mySrcR.x = x;  mySrcR.y = y;
+  myTextureIsStale = true;
   mySrcGUIR.moveTo(x, y);
 }
 
@@ -96,6 +98,7 @@ void FBSurfaceSDL2::setSrcPos(uInt32 x, uInt32 y)
 void FBSurfaceSDL2::setSrcSize(uInt32 w, uInt32 h)
 {
   mySrcR.w = w;  mySrcR.h = h;
+  myTextureIsStale = true;
   mySrcGUIR.setWidth(w);  mySrcGUIR.setHeight(h);
 }
 
@@ -135,8 +138,11 @@ bool FBSurfaceSDL2::render()
 //cerr << "dst: x=" << myDstR.x << ", y=" << myDstR.y << ", w=" << myDstR.w << ", h=" << myDstR.h << endl;
 
 //cerr << "render()\n";
-    if(myTexAccess == SDL_TEXTUREACCESS_STREAMING)
+    if(myTexAccess == SDL_TEXTUREACCESS_STREAMING && myTextureIsStale)
+    {
       SDL_UpdateTexture(myTexture, &mySrcR, mySurface->pixels, mySurface->pitch);
+      myTextureIsStale = false;
+    }
     SDL_RenderCopy(myFB.myRenderer, myTexture, &mySrcR, &myDstR);
 
     mySurfaceIsDirty = false;
@@ -170,6 +176,7 @@ void FBSurfaceSDL2::reload()
   SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, myInterpolate ? "1" : "0");
   myTexture = SDL_CreateTexture(myFB.myRenderer, myFB.myPixelFormat->format,
       myTexAccess, mySurface->w, mySurface->h);
+  myTextureIsStale = true;
 
   // If the data is static, we only upload it once
   if(myTexAccess == SDL_TEXTUREACCESS_STATIC)
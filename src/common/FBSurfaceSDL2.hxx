@@ -39,7 +39,8 @@ class FBSurfaceSDL2 : public FBSurface
     //
     void fillRect(uInt32 x, uInt32 y, uInt32 w, uInt32 h, uInt32 color) override;
     // With hardware surfaces, it's faster to just update the entire surface
-    void setDirty() override { mySurfaceIsDirty = true; }
+    void setDirty() override { mySurfaceIsDirty = myTextureIsStale = true; }
+    void setRedrawOnly() override { mySurfaceIsDirty = true; }
 
     uInt32 width() const override;
     uInt32 height() const override;
@@ -80,6 +81,7 @@ class FBSurfaceSDL2 : public FBSurface
     SDL_Rect mySrcR, myDstR;
 
     bool mySurfaceIsDirty;
+    bool myTextureIsStale;  // Pixel data has changed since the last upload
     bool myIsVisible;
 
     SDL_TextureAccess myTexAccess;  // Is pixel data constant or can it change?
@@ -56,6 +56,7 @@ FilesystemNodeZIP::FilesystemNodeZIP(const string& p)
   _zipFile = p.substr(0, pos+4);
 
   // Open file at least once to initialize the virtual file count
+  std::lock_guard<std::mutex> lock(myZipMutex);
   ZipHandler& zip = open(_zipFile);
   _numFiles = zip.romFiles();
   if(_numFiles == 0)
@@ -147,6 +148,7 @@ bool FilesystemNodeZIP::getChildren(AbstractFSList& myList, ListMode mode,
     return false;
 
   std::set<string> dirs;
+  std::lock_guard<std::mutex> lock(myZipMutex);
   ZipHandler& zip = open(_zipFile);
   while(zip.hasNext())
   {
@@ -185,13 +187,10 @@ uInt32 FilesystemNodeZIP::read(BytePtr& image) const
     case ZIPERR_NO_ROMS:      throw runtime_error("ZIP file doesn't contain any ROMs");
   }
 
+  std::lock_guard<std::mutex> lock(myZipMutex);
   ZipHandler& zip = open(_zipFile);
 
-  bool found = false;
-  while(zip.hasNext() && !found)
-    found = zip.next() == _virtualPath;
-
-  return found ? zip.decompress(image) : 0;
+  return zip.find(_virtualPath) ? zip.decompress(image) : 0;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -208,3 +207,4 @@ AbstractFSNode* FilesystemNodeZIP::getParent() const
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 unique_ptr<ZipHandler> FilesystemNodeZIP::myZipHandler = make_unique<ZipHandler>();
+std::mutex FilesystemNodeZIP::myZipMutex;
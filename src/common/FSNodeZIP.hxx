@@ -18,6 +18,8 @@
 #ifndef FS_NODE_ZIP_HXX
 #define FS_NODE_ZIP_HXX
 
+#include <mutex>
+
 #include "ZipHandler.hxx"
 #include "FSNode.hxx"
 
@@ -61,6 +63,11 @@ class FilesystemNodeZIP : public AbstractFSNode
     bool rename(const string& newfile) { return false; }
     //////////////////////////////////////////////////////////
 
+    // The contents can only change when the archive itself does
+    bool getStamp(uInt64& size, uInt64& mtime) const {
+      return _realNode && _realNode->getStamp(size, mtime);
+    }
+
     bool getChildren(AbstractFSList& list, ListMode mode, bool hidden) const;
     AbstractFSNode* getParent() const;
 
@@ -101,7 +108,9 @@ class FilesystemNodeZIP : public AbstractFSNode
     bool _isDirectory, _isFile;
 
     // ZipHandler static reference variable responsible for accessing ZIP files
+    // Since it's shared by all nodes, the lock must be held while using it
     static unique_ptr<ZipHandler> myZipHandler;
+    static std::mutex myZipMutex;
     inline static ZipHandler& open(const string& file)
     {
       myZipHandler->open(file);
@@ -25,12 +25,46 @@
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 PNGLibrary::PNGLibrary(const FrameBuffer& fb)
-  : myFB(fb)
+  : myFB(fb),
+    myZLevel(PNG_Z_DEFAULT_COMPRESSION),
+    myFilter(PNG_ALL_FILTERS),
+    mySaveThreadQuit(false),
+    myDroppedImages(0)
 {
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+PNGLibrary::~PNGLibrary()
+{
+  // Images still in the queue are saved before the thread exits
+  if(mySaveThread.joinable())
+  {
+    {
+      std::lock_guard<std::mutex> lock(mySaveMutex);
+      mySaveThreadQuit = true;
+    }
+    mySaveCondition.notify_one();
+    mySaveThread.join();
+  }
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void PNGLibrary::loadImage(const string& filename, FBSurface& surface)
+{
+  readImage(filename, ReadInfo);
+
+  // Load image into the surface, setting the correct dimensions
+  loadImagetoSurface(ReadInfo, surface);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void PNGLibrary::loadImage(const ReadInfoType& info, FBSurface& surface)
+{
+  loadImagetoSurface(info, surface);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void PNGLibrary::readImage(const string& filename, ReadInfoType& info)
 {
   #define loadImageERROR(s) { err_message = s; goto done; }
 
@@ -89,22 +123,19 @@ void PNGLibrary::loadImage(const string& filename, FBSurface& surface)
   }
 
   // Create/initialize storage area for the current image
-  if(!allocateStorage(iwidth, iheight))
+  if(!allocateStorage(info, iwidth, iheight))
     loadImageERROR("Not enough memory to read PNG file");
 
   // The PNG read function expects an array of rows, not a single 1-D array
-  for(uInt32 irow = 0, offset = 0; irow < ReadInfo.height; ++irow, offset += ReadInfo.pitch)
-    ReadInfo.row_pointers[irow] = png_bytep(ReadInfo.buffer.get() + offset);
+  for(uInt32 irow = 0, offset = 0; irow < info.height; ++irow, offset += info.pitch)
+    info.row_pointers[irow] = png_bytep(info.buffer.get() + offset);
 
   // Read the entire image in one go
-  png_read_image(png_ptr, ReadInfo.row_pointers.get());
+  png_read_image(png_ptr, info.row_pointers.get());
 
   // We're finished reading
   png_read_end(png_ptr, info_ptr);
 
-  // Load image into the surface, setting the correct dimensions
-  loadImagetoSurface(surface);
-
   // Cleanup
 done:
   if(png_ptr)
@@ -134,7 +165,7 @@ void PNGLibrary::saveImage(const string& filename, const VariantList& comments)
     rows[k] = png_bytep(buffer.get() + k*width*4);
 
   // And save the image
-  saveImage(out, rows, width, height, comments);
+  saveImage(out, rows, width, height, comments, myZLevel, myFilter);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -163,12 +194,13 @@ void PNGLibrary::saveImage(const string& filename, const FBSurface& surface,
     rows[k] = png_bytep(buffer.get() + k*width*4);
 
   // And save the image
-  saveImage(out, rows, width, height, comments);
+  saveImage(out, rows, width, height, comments, myZLevel, myFilter);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void PNGLibrary::saveImage(ofstream& out, const unique_ptr<png_bytep[]>& rows,
-    png_uint_32 width, png_uint_32 height, const VariantList& comments)
+    png_uint_32 width, png_uint_32 height, const VariantList& comments,
+    int zlevel, int filter)
 {
   #define saveImageERROR(s) { err_message = s; goto done; }
 
@@ -190,6 +222,10 @@ void PNGLibrary::saveImage(ofstream& out, const unique_ptr<png_bytep[]>& rows,
   // Set up the output control
   png_set_write_fn(png_ptr, &out, png_write_data, png_io_flush);
 
+  // Set compression (this is much faster with lower levels or a fixed filter)
+  png_set_compression_level(png_ptr, zlevel);
+  png_set_filter(png_ptr, PNG_FILTER_TYPE_BASE, filter);
+
   // Write PNG header info
   png_set_IHDR(png_ptr, info_ptr, width, height, 8,
       PNG_COLOR_TYPE_RGB, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT,
@@ -228,40 +264,229 @@ done:
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool PNGLibrary::allocateStorage(png_uint_32 w, png_uint_32 h)
+bool PNGLibrary::saveImageAsync(const string& filename,
+                                const VariantList& comments, bool report)
+{
+  const GUI::Rect& rect = myFB.imageRect();
+  png_uint_32 width = rect.width(), height = rect.height();
+
+  std::unique_lock<std::mutex> lock(mySaveMutex);
+  SaveRequest request;
+  if(!prepareSaveRequest(request, filename, width, height, comments, report))
+    return false;
+
+  // Get framebuffer pixel data (we get ABGR format); the background thread
+  // doesn't need the lock for this
+  lock.unlock();
+  myFB.readPixels(request.buffer.get(), width*4, rect);
+  lock.lock();
+
+  queueSaveRequest(request);
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool PNGLibrary::saveImageAsync(const string& filename, const FBSurface& surface,
+                                const GUI::Rect& rect, const VariantList& comments,
+                                bool report)
+{
+  // Do we want the entire surface or just a section?
+  png_uint_32 width = rect.width(), height = rect.height();
+  if(rect.empty())
+  {
+    width = surface.width();
+    height = surface.height();
+  }
+
+  std::unique_lock<std::mutex> lock(mySaveMutex);
+  SaveRequest request;
+  if(!prepareSaveRequest(request, filename, width, height, comments, report))
+    return false;
+
+  // Get the surface pixel data (we get ABGR format)
+  lock.unlock();
+  surface.readPixels(request.buffer.get(), width, rect);
+  lock.lock();
+
+  queueSaveRequest(request);
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool PNGLibrary::saveResult(string& message)
+{
+  std::lock_guard<std::mutex> lock(mySaveMutex);
+  if(mySaveResult == "")
+    return false;
+
+  message = mySaveResult;
+  mySaveResult = "";
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool PNGLibrary::isSavePending(const string& filename)
+{
+  std::lock_guard<std::mutex> lock(mySaveMutex);
+  return myPendingSaves.count(filename) > 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void PNGLibrary::setCompression(uInt32 level, const string& filter)
+{
+  myZLevel = std::min(level, 9u);
+
+  if(filter == "none")        myFilter = PNG_FILTER_NONE;
+  else if(filter == "sub")    myFilter = PNG_FILTER_SUB;
+  else if(filter == "up")     myFilter = PNG_FILTER_UP;
+  else if(filter == "avg")    myFilter = PNG_FILTER_AVG;
+  else if(filter == "paeth")  myFilter = PNG_FILTER_PAETH;
+  else                        myFilter = PNG_ALL_FILTERS;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool PNGLibrary::prepareSaveRequest(SaveRequest& request, const string& filename,
+    png_uint_32 width, png_uint_32 height, const VariantList& comments,
+    bool report)
+{
+  if(mySaveQueue.size() >= kMaxPendingSaves)
+  {
+    ++myDroppedImages;
+    return false;
+  }
+
+  // Reuse the first pooled buffer that is large enough
+  uInt32 req_buffer_size = width * height * 4;
+  for(auto it = myBufferPool.begin(); it != myBufferPool.end(); ++it)
+  {
+    if(it->second >= req_buffer_size)
+    {
+      request.buffer = std::move(it->first);
+      request.buffer_size = it->second;
+      myBufferPool.erase(it);
+      break;
+    }
+  }
+  if(request.buffer == nullptr)
+  {
+    request.buffer = make_unique<uInt8[]>(req_buffer_size);
+    request.buffer_size = req_buffer_size;
+  }
+
+  request.filename = filename;
+  request.comments = comments;
+  request.width  = width;
+  request.height = height;
+  request.zlevel = myZLevel;
+  request.filter = myFilter;
+  request.report = report;
+
+  // The name is taken until the image is written
+  myPendingSaves.insert(filename);
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void PNGLibrary::queueSaveRequest(SaveRequest& request)
+{
+  mySaveQueue.push_back(std::move(request));
+
+  // The thread is only started when first needed
+  if(!mySaveThread.joinable())
+    mySaveThread = std::thread([this] { saveThread(); });
+
+  mySaveCondition.notify_one();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void PNGLibrary::saveThread()
+{
+  std::unique_lock<std::mutex> lock(mySaveMutex);
+  for(;;)
+  {
+    mySaveCondition.wait(lock, [this] {
+      return mySaveThreadQuit || !mySaveQueue.empty();
+    });
+    if(mySaveQueue.empty())  // only quit once everything is saved
+      break;
+
+    SaveRequest request = std::move(mySaveQueue.front());
+    mySaveQueue.pop_front();
+    lock.unlock();
+
+    string error;
+    try
+    {
+      ofstream out(request.filename, std::ios_base::binary);
+      if(!out.is_open())
+        throw runtime_error("ERROR: Couldn't create snapshot file");
+
+      // Set up pointers into "buffer" byte array
+      unique_ptr<png_bytep[]> rows = make_unique<png_bytep[]>(request.height);
+      for(png_uint_32 k = 0; k < request.height; ++k)
+        rows[k] = png_bytep(request.buffer.get() + k*request.width*4);
+
+      saveImage(out, rows, request.width, request.height, request.comments,
+                request.zlevel, request.filter);
+    }
+    catch(const runtime_error& e)
+    {
+      error = e.what();
+    }
+
+    // The file is closed by now, so the name can be released
+    lock.lock();
+    myPendingSaves.erase(request.filename);
+    if(error != "")
+      mySaveResult = error;
+    else if(request.report)
+      mySaveResult = "Snapshot saved";
+
+    // Return the buffer to the pool, which never holds more buffers
+    // than can be in use at once
+    if(myBufferPool.size() < kMaxPendingSaves)
+      myBufferPool.emplace_back(std::move(request.buffer), request.buffer_size);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool PNGLibrary::allocateStorage(ReadInfoType& info,
+                                 png_uint_32 w, png_uint_32 h)
 {
   // Create space for the entire image (3 bytes per pixel in RGB format)
   uInt32 req_buffer_size = w * h * 3;
-  if(req_buffer_size > ReadInfo.buffer_size)
+  if(req_buffer_size > info.buffer_size)
   {
-    ReadInfo.buffer = make_unique<png_byte[]>(req_buffer_size);
-    if(ReadInfo.buffer == nullptr)
+    info.buffer = make_unique<png_byte[]>(req_buffer_size);
+    if(info.buffer == nullptr)
       return false;
 
-    ReadInfo.buffer_size = req_buffer_size;
+    info.buffer_size = req_buffer_size;
   }
   uInt32 req_row_size = h;
-  if(req_row_size > ReadInfo.row_size)
+  if(req_row_size > info.row_size)
   {
-    ReadInfo.row_pointers = make_unique<png_bytep[]>(req_row_size);
-    if(ReadInfo.row_pointers == nullptr)
+    info.row_pointers = make_unique<png_bytep[]>(req_row_size);
+    if(info.row_pointers == nullptr)
       return false;
 
-    ReadInfo.row_size = req_row_size;
+    info.row_size = req_row_size;
   }
 
-  ReadInfo.width  = w;
-  ReadInfo.height = h;
-  ReadInfo.pitch  = w * 3;
+  info.width  = w;
+  info.height = h;
+  info.pitch  = w * 3;
 
   return true;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void PNGLibrary::loadImagetoSurface(FBSurface& surface)
+void PNGLibrary::loadImagetoSurface(const ReadInfoType& info,
+                                    FBSurface& surface)
 {
   // First determine if we need to resize the surface
-  uInt32 iw = ReadInfo.width, ih = ReadInfo.height;
+  uInt32 iw = info.width, ih = info.height;
   if(iw > surface.width() || ih > surface.height())
     surface.resize(iw, ih);
 
@@ -273,14 +498,14 @@ void PNGLibrary::loadImagetoSurface(FBSurface& surface)
   // Convert RGB triples into pixels and store in the surface
   uInt32 *s_buf, s_pitch;
   surface.basePtr(s_buf, s_pitch);
-  uInt8* i_buf = ReadInfo.buffer.get();
-  uInt32 i_pitch = ReadInfo.pitch;
+  uInt8* i_buf = info.buffer.get();
+  uInt32 i_pitch = info.pitch;
 
   for(uInt32 irow = 0; irow < ih; ++irow, i_buf += i_pitch, s_buf += s_pitch)
   {
     uInt8*  i_ptr = i_buf;
     uInt32* s_ptr = s_buf;
-    for(uInt32 icol = 0; icol < ReadInfo.width; ++icol, i_ptr += 3)
+    for(uInt32 icol = 0; icol < info.width; ++icol, i_ptr += 3)
       *s_ptr++ = myFB.mapRGB(*i_ptr, *(i_ptr+1), *(i_ptr+2));
   }
 }
@@ -25,6 +25,11 @@ class FBSurface;
 class Properties;
 
 #include <fstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <set>
 #include "bspf.hxx"
 
 /**
@@ -38,6 +43,7 @@ class PNGLibrary
 {
   public:
     PNGLibrary(const FrameBuffer& fb);
+    ~PNGLibrary();
 
     /**
       Read a PNG image from the specified file into a FBSurface structure,
@@ -52,6 +58,40 @@ class PNGLibrary
     */
     void loadImage(const string& filename, FBSurface& surface);
 
+    /**
+      The RGB data of a decoded PNG image (3 bytes per pixel).  The buffers
+      are only reallocated when a larger image is read into them.
+    */
+    struct ReadInfoType {
+      BytePtr buffer;
+      unique_ptr<png_bytep[]> row_pointers;
+      png_uint_32 width, height, pitch;
+      uInt32 buffer_size, row_size;
+    };
+
+    /**
+      Decode a PNG image from the specified file, without converting it
+      into a surface.  This doesn't use any state of the library, so it
+      can be called from any thread.
+
+      @param filename  The filename to load the PNG image
+      @param info      Receives the decoded image data
+
+      @return  On success, 'info' contains the image data, otherwise a
+               runtime_error is thrown containing a more detailed
+               error message.
+    */
+    static void readImage(const string& filename, ReadInfoType& info);
+
+    /**
+      Load a previously decoded image into a FBSurface structure, as in
+      loadImage() above.
+
+      @param info     The decoded image data
+      @param surface  The FBSurface into which to place the PNG data
+    */
+    void loadImage(const ReadInfoType& info, FBSurface& surface);
+
     /**
       Save the current FrameBuffer image to a PNG file.  Note that in most
       cases this will be a TIA image, but it could actually be used for
@@ -83,32 +123,125 @@ class PNGLibrary
                    const GUI::Rect& rect = GUI::EmptyRect,
                    const VariantList& comments = EmptyVarList);
 
+    /**
+      Queue the current FrameBuffer image to be saved to a PNG file.  The
+      pixels are read immediately, but compressing and writing the file
+      is done in a background thread, so this never waits on either.
+
+      @param filename  The filename to save the PNG image
+      @param comments  The text comments to add to the PNG image
+      @param report    Whether successfully saving the image is reported
+                       by saveResult() (errors always are)
+
+      @return  False if the image was dropped because too many images are
+               already waiting to be saved, otherwise true.  The outcome
+               of the save is available from saveResult().
+    */
+    bool saveImageAsync(const string& filename,
+                        const VariantList& comments = EmptyVarList,
+                        bool report = false);
+
+    /**
+      Queue the given surface to be saved to a PNG file, as above.
+
+      @param filename  The filename to save the PNG image
+      @param surface   The surface data for the PNG image
+      @param rect      The area of the surface to use
+      @param comments  The text comments to add to the PNG image
+      @param report    Whether successfully saving the image is reported
+
+      @return  False if the image was dropped, otherwise true
+    */
+    bool saveImageAsync(const string& filename, const FBSurface& surface,
+                        const GUI::Rect& rect = GUI::EmptyRect,
+                        const VariantList& comments = EmptyVarList,
+                        bool report = false);
+
+    /**
+      Get the message from a finished background save, if any; this is
+      either an error, or a success message for images queued with
+      'report' set.  The message is cleared afterwards.
+
+      @param message  Receives the message
+
+      @return  True if a save finished since the last call, otherwise false
+    */
+    bool saveResult(string& message);
+
+    /**
+      Answer whether an image is currently waiting to be saved (or being
+      saved) to the given file.  Together with checking whether the file
+      exists, this is used to find an unused name for a new image.
+    */
+    bool isSavePending(const string& filename);
+
+    /**
+      Answer the number of images dropped by saveImageAsync() so far.
+    */
+    uInt32 droppedImages() const { return myDroppedImages; }
+
+    /**
+      Set the compression used for saving PNG images.
+
+      @param level   The zlib compression level (0 - 9)
+      @param filter  The PNG row filter to use ('none', 'sub', 'up', 'avg',
+                     'paeth'), or 'all' to let libpng choose per row
+    */
+    void setCompression(uInt32 level, const string& filter);
+
   private:
     const FrameBuffer& myFB;
 
     // The following data remains between invocations of allocateStorage,
     // and is only changed when absolutely necessary.
-    struct ReadInfoType {
+    static ReadInfoType ReadInfo;
+
+    // Compression settings for saving images
+    int myZLevel, myFilter;
+
+    // An image waiting to be saved by the background thread
+    struct SaveRequest {
+      string filename;
+      VariantList comments;
       BytePtr buffer;
-      unique_ptr<png_bytep[]> row_pointers;
-      png_uint_32 width, height, pitch;
-      uInt32 buffer_size, row_size;
+      uInt32 buffer_size;
+      png_uint_32 width, height;
+      int zlevel, filter;
+      bool report;
     };
-    static ReadInfoType ReadInfo;
+
+    // Maximum number of images waiting to be saved; any more are dropped
+    static constexpr uInt32 kMaxPendingSaves = 4;
+
+    // Images waiting to be saved, and buffers available for reuse; the
+    // lock protects these and the remaining save state
+    std::deque<SaveRequest> mySaveQueue;
+    vector<std::pair<BytePtr, uInt32>> myBufferPool;
+    std::mutex mySaveMutex;
+    std::condition_variable mySaveCondition;
+    std::thread mySaveThread;
+    bool mySaveThreadQuit;
+    uInt32 myDroppedImages;
+    string mySaveResult;
+
+    // Names of all images in the queue or being saved
+    std::set<string> myPendingSaves;
 
     /**
       Allocate memory for PNG read operations.  This is used to provide a
       basic memory manager, so that we don't constantly allocate and deallocate
       memory for each image loaded.
 
-      The method fills the 'ReadInfo' struct with valid memory locations
+      The method fills the 'info' struct with valid memory locations
       dependent on the given dimensions.  If memory has been previously
       allocated and it can accommodate the given dimensions, it is used directly.
 
+      @param info    The struct to allocate memory in
       @param iwidth  The width of the PNG image
       @param iheight The height of the PNG image
     */
-    bool allocateStorage(png_uint_32 iwidth, png_uint_32 iheight);
+    static bool allocateStorage(ReadInfoType& info,
+                                png_uint_32 iwidth, png_uint_32 iheight);
 
     /** The actual method which saves a PNG image.
 
@@ -120,15 +253,39 @@ class PNGLibrary
     */
     void saveImage(ofstream& out, const unique_ptr<png_bytep[]>& rows,
                    png_uint_32 width, png_uint_32 height,
-                   const VariantList& comments);
+                   const VariantList& comments, int zlevel, int filter);
+
+    /**
+      Get a buffer from the pool for an image waiting to be saved (or
+      allocate one if none is large enough), and fill in the request.
+      Must be called with the lock held.
+
+      @return  False if the queue is full, otherwise true
+    */
+    bool prepareSaveRequest(SaveRequest& request, const string& filename,
+                            png_uint_32 width, png_uint_32 height,
+                            const VariantList& comments, bool report);
+
+    /**
+      Add the request to the queue, starting the background thread if
+      necessary.  Must be called with the lock held.
+    */
+    void queueSaveRequest(SaveRequest& request);
+
+    /**
+      The background thread; compresses and writes queued images until
+      the library is destroyed.
+    */
+    void saveThread();
 
     /**
-      Load the PNG data from 'ReadInfo' into the FBSurface.  The surface
+      Load the PNG data from 'info' into the FBSurface.  The surface
       is resized as necessary to accommodate the data.
 
+      @param info     The decoded image data
       @param surface  The FBSurface into which to place the PNG data
     */
-    void loadImagetoSurface(FBSurface& surface);
+    void loadImagetoSurface(const ReadInfoType& info, FBSurface& surface);
 
     /**
       Write PNG tEXt chunks to the image.
@@ -0,0 +1,169 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2017 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+
+#include <sstream>
+
+#include "SearchIndex.hxx"
+
+namespace {
+  inline string toLower(string s)
+  {
+    // Characters must be passed to tolower() as unsigned
+    std::transform(s.begin(), s.end(), s.begin(),
+                   [](unsigned char c) { return char(::tolower(c)); });
+    return s;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SearchIndex::add(uInt32 id, const string& text)
+{
+  if(id >= myTexts.size())
+  {
+    myTexts.resize(id + 1);
+    myValid.resize(id + 1, false);
+  }
+  myTexts[id] = toLower(text);
+  myValid[id] = true;
+
+  const string& s = myTexts[id];
+  const uInt32 length = uInt32(s.length());
+  for(uInt32 pos = 0; pos < length; ++pos)
+  {
+    for(uInt32 len = 1; len <= 3 && pos + len <= length; ++len)
+    {
+      // Since ids are increasing, the lists stay sorted, and any
+      // duplicate is at the end
+      IdList& list = myLists[makeKey(s.data() + pos, len)];
+      if(list.empty() || list.back() != id)
+        list.push_back(id);
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SearchIndex::remove(uInt32 id)
+{
+  if(!isValid(id))
+    return;
+
+  // Take the item out of the lists of all its substrings, so they don't
+  // keep growing with removed items
+  const string& s = myTexts[id];
+  const uInt32 length = uInt32(s.length());
+  for(uInt32 pos = 0; pos < length; ++pos)
+  {
+    for(uInt32 len = 1; len <= 3 && pos + len <= length; ++len)
+    {
+      const auto& iter = myLists.find(makeKey(s.data() + pos, len));
+      if(iter == myLists.end())
+        continue;  // already handled for an earlier occurrence
+
+      IdList& list = iter->second;
+      const auto& found = std::lower_bound(list.begin(), list.end(), id);
+      if(found != list.end() && *found == id)
+        list.erase(found);
+      if(list.empty())
+        myLists.erase(iter);
+    }
+  }
+
+  myValid[id] = false;
+  myTexts[id].clear();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SearchIndex::clear()
+{
+  myLists.clear();
+  myTexts.clear();
+  myValid.clear();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SearchIndex::find(const string& query, vector<uInt32>& result) const
+{
+  result.clear();
+
+  StringList words;
+  istringstream buf(toLower(query));
+  string word;
+  while(buf >> word)
+    words.push_back(word);
+
+  if(words.empty())
+  {
+    for(uInt32 id = 0; id < myValid.size(); ++id)
+      if(myValid[id])
+        result.push_back(id);
+    return;
+  }
+
+  // Collect the lists of (the substrings of) each word, since the
+  // result must be in all of them
+  vector<const IdList*> lists;
+  bool verify = false;
+  for(const auto& w: words)
+  {
+    const uInt32 length = uInt32(w.length());
+    const uInt32 len = std::min(length, 3u);
+    for(uInt32 pos = 0; pos + len <= length; ++pos)
+    {
+      const auto& iter = myLists.find(makeKey(w.data() + pos, len));
+      if(iter == myLists.end())
+        return;  // nothing contains this substring
+      lists.push_back(&iter->second);
+    }
+    verify = verify || length > 3;
+  }
+
+  // Intersecting the shortest lists first keeps the intermediate
+  // results as small as possible
+  std::sort(lists.begin(), lists.end(),
+            [](const IdList* a, const IdList* b) { return a->size() < b->size(); });
+
+  IdList candidates = *lists[0], tmp;
+  for(uInt32 i = 1; i < lists.size() && !candidates.empty(); ++i)
+  {
+    tmp.clear();
+    std::set_intersection(candidates.begin(), candidates.end(),
+                          lists[i]->begin(), lists[i]->end(),
+                          std::back_inserter(tmp));
+    candidates.swap(tmp);
+  }
+
+  // Containing all trigrams of a longer word doesn't mean containing
+  // the word itself, so those candidates must be checked
+  for(uInt32 id: candidates)
+  {
+    if(!isValid(id))
+      continue;
+
+    bool found = true;
+    if(verify)
+      for(const auto& w: words)
+        if(w.length() > 3 && myTexts[id].find(w) == string::npos)
+        {
+          found = false;
+          break;
+        }
+
+    if(found)
+      result.push_back(id);
+  }
+}
@@ -0,0 +1,112 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2017 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+
+#ifndef SEARCH_INDEX_HXX
+#define SEARCH_INDEX_HXX
+
+#include <unordered_map>
+
+#include "bspf.hxx"
+
+/**
+  This class implements a simple full-text index, for finding the items
+  whose text contains all the words of a query (ignoring case).
+
+  Each substring of one to three characters of an item's text maps to the
+  sorted list of items containing it.  A query word of up to three
+  characters is then answered directly by one list; for longer words the
+  lists of all their trigrams are intersected, and the few candidates left
+  are checked against the text.  This makes searching much faster than
+  scanning the text of each item, even for tens of thousands of items.
+
+  Items are identified by a number, which must increase as items are
+  added.  Removed items are taken out of all lists, but their numbers
+  aren't reused.
+*/
+class SearchIndex
+{
+  public:
+    SearchIndex() = default;
+
+    /**
+      Add an item to the index.
+
+      @param id    The item's number, which is larger than any added before
+      @param text  The text to search in
+    */
+    void add(uInt32 id, const string& text);
+
+    /**
+      Remove an item from the index.
+
+      @param id  The number of the item to remove
+    */
+    void remove(uInt32 id);
+
+    /**
+      Remove all items from the index.
+    */
+    void clear();
+
+    /**
+      Find the items containing all (whitespace separated) words of the
+      query; an empty query matches all items.
+
+      @param query   The words to search for
+      @param result  Receives the matching items, in increasing order
+    */
+    void find(const string& query, vector<uInt32>& result) const;
+
+  private:
+    using Key = uInt32;
+    using IdList = vector<uInt32>;
+
+    /**
+      Build the key of a substring of one to three characters.
+    */
+    static Key makeKey(const char* s, uInt32 length) {
+      Key key = 0;
+      for(uInt32 i = 0; i < length; ++i)
+        key = (key << 8) | uInt8(s[i]);
+      return key | (length << 24);
+    }
+
+    /**
+      Answer whether an item with the given number hasn't been removed.
+    */
+    bool isValid(uInt32 id) const {
+      return id < myValid.size() && myValid[id];
+    }
+
+  private:
+    // The items containing each substring (of up to three characters)
+    std::unordered_map<Key, IdList> myLists;
+
+    // The (lowercase) text of each item, and whether it's still valid
+    vector<string> myTexts;
+    vector<bool> myValid;
+
+  private:
+    // Following constructors and assignment operators not supported
+    SearchIndex(const SearchIndex&) = delete;
+    SearchIndex(SearchIndex&&) = delete;
+    SearchIndex& operator=(const SearchIndex&) = delete;
+    SearchIndex& operator=(SearchIndex&&) = delete;
+};
+
+#endif
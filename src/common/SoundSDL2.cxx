@@ -29,6 +29,7 @@
 #include "System.hxx"
 #include "OSystem.hxx"
 #include "Console.hxx"
+#include "TIACapture.hxx"
 #include "SoundSDL2.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -354,6 +355,12 @@ void SoundSDL2::callback(void* udata, uInt8* stream, int len)
     // emulator deals in 16-bit (signed) data
     // So, we need to convert the pointer and half the length
     sound->processFragment(reinterpret_cast<Int16*>(stream), uInt32(len) >> 1);
+
+    // Record the sound exactly as it's played
+    TIACapture& capture = sound->myOSystem.capture();
+    if(capture.isCapturing())
+      capture.addAudio(reinterpret_cast<Int16*>(stream), uInt32(len) >> 1,
+                       sound->myHardwareSpec.channels, sound->myHardwareSpec.freq);
   }
   else
     SDL_memset(stream, 0, len);  // Write 'silence'
@@ -0,0 +1,343 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2017 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include <zlib.h>
+
+#include "TIACapture.hxx"
+
+namespace {
+  // Store values in little-endian order
+  inline uInt8* put16(uInt8* buf, uInt32 value)
+  {
+    *buf++ = uInt8(value);
+    *buf++ = uInt8(value >> 8);
+    return buf;
+  }
+  inline uInt8* put32(uInt8* buf, uInt32 value)
+  {
+    return put16(put16(buf, value), value >> 16);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TIACapture::TIACapture()
+  : myThreadQuit(false),
+    myIsCapturing(false),
+    myAudioRate(0),
+    myAudioChannels(0),
+    myFrameNumber(0),
+    myDroppedFrames(0),
+    myPrevWidth(0),
+    myPrevHeight(0),
+    myFramesSinceKey(0)
+{
+  memset(myPalette, 0, sizeof(myPalette));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TIACapture::~TIACapture()
+{
+  stop();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIACapture::start(const string& filename, float framerate)
+{
+  stop();
+
+  myFile.open(filename, std::ios_base::binary | std::ios_base::trunc);
+  if(!myFile.is_open())
+    throw runtime_error("ERROR: Couldn't create capture file");
+
+  uInt8 header[16] = { 'S', 't', 'e', 'l', 'l', 'a', 'A', 'V' };
+  put32(put32(header + 8, kVersion), uInt32(framerate * 1000));
+  myFile.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+  std::lock_guard<std::mutex> lock(myMutex);
+  myFrameNumber = myDroppedFrames = 0;
+  myPrevWidth = myPrevHeight = myFramesSinceKey = 0;
+  myPrevFrame.clear();
+  myPendingAudio.clear();
+  myWriteError = "";
+  myThreadQuit = false;
+
+  // Every capture starts with the current palette
+  queuePalette();
+
+  myThread = std::thread([this] { writeThread(); });
+  myIsCapturing = true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIACapture::stop()
+{
+  if(!myThread.joinable())
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(myMutex);
+    myIsCapturing = false;
+
+    // Sound received after the last frame is written too
+    if(myPendingAudio.size() > 0)
+    {
+      Request request;
+      request.type = 'A';
+      request.audio.swap(myPendingAudio);
+      request.rate = myAudioRate;
+      request.channels = myAudioChannels;
+      queueRequest(request);
+    }
+    myThreadQuit = true;
+  }
+  myCondition.notify_one();
+  myThread.join();
+
+  myFile.close();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool TIACapture::checkError(string& message)
+{
+  {
+    std::lock_guard<std::mutex> lock(myMutex);
+    if(myWriteError == "")
+      return false;
+
+    // Each error is only reported once
+    message = myWriteError;
+    myWriteError.clear();
+  }
+  stop();
+
+  // Writing what was still queued has most likely failed as well
+  std::lock_guard<std::mutex> lock(myMutex);
+  myWriteError.clear();
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIACapture::addFrame(const uInt8* frame, uInt32 width, uInt32 height)
+{
+  std::lock_guard<std::mutex> lock(myMutex);
+  if(!myIsCapturing)
+    return;
+
+  uInt32 number = myFrameNumber++;
+  if(myQueue.size() >= kMaxPendingFrames)
+  {
+    // The frame is lost, but the sound is kept for the next frame
+    ++myDroppedFrames;
+    return;
+  }
+
+  Request request;
+  request.type = 'F';
+  request.frame = number;
+  request.width = width;
+  request.height = height;
+  if(myBufferPool.size() > 0)
+  {
+    request.data.swap(myBufferPool.back());
+    myBufferPool.pop_back();
+  }
+  request.data.assign(frame, frame + width * height);
+  request.audio.swap(myPendingAudio);
+  request.rate = myAudioRate;
+  request.channels = myAudioChannels;
+
+  queueRequest(request);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIACapture::setPalette(const uInt32* palette)
+{
+  std::lock_guard<std::mutex> lock(myMutex);
+  memcpy(myPalette, palette, sizeof(myPalette));
+
+  if(myIsCapturing)
+    queuePalette();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIACapture::addAudio(const Int16* samples, uInt32 count, uInt32 channels,
+                          uInt32 rate)
+{
+  std::lock_guard<std::mutex> lock(myMutex);
+  if(!myIsCapturing)
+    return;
+
+  // The format can only change between chunks
+  if((rate != myAudioRate || channels != myAudioChannels ||
+      myPendingAudio.size() >= 65536) && myPendingAudio.size() > 0)
+  {
+    Request request;
+    request.type = 'A';
+    request.audio.swap(myPendingAudio);
+    request.rate = myAudioRate;
+    request.channels = myAudioChannels;
+    queueRequest(request);
+  }
+  myAudioRate = rate;
+  myAudioChannels = channels;
+  myPendingAudio.insert(myPendingAudio.end(), samples, samples + count);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIACapture::queueRequest(Request& request)
+{
+  myQueue.push_back(std::move(request));
+  myCondition.notify_one();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIACapture::queuePalette()
+{
+  Request request;
+  request.type = 'P';
+  request.data.resize(256 * 3);
+  for(uInt32 i = 0; i < 256; ++i)
+  {
+    request.data[i*3]   = uInt8(myPalette[i] >> 16);
+    request.data[i*3+1] = uInt8(myPalette[i] >> 8);
+    request.data[i*3+2] = uInt8(myPalette[i]);
+  }
+  queueRequest(request);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIACapture::writeThread()
+{
+  std::unique_lock<std::mutex> lock(myMutex);
+  for(;;)
+  {
+    myCondition.wait(lock, [this] {
+      return myThreadQuit || !myQueue.empty();
+    });
+    if(myQueue.empty())  // only quit once everything is written
+      break;
+
+    Request request = std::move(myQueue.front());
+    myQueue.pop_front();
+    bool failed = myWriteError != "";
+    lock.unlock();
+
+    // Sound always precedes the frame it was received with; nothing more
+    // is written once writing failed
+    if(!failed && request.audio.size() > 0)
+      writeAudio(request);
+    if(!failed && request.type == 'F')
+      writeFrame(request);
+    else if(!failed && request.type == 'P')
+      writePalette(request);
+
+    lock.lock();
+    if(!failed && !myFile.good())
+    {
+      // Stop accepting data; the capture is stopped from the main thread
+      myWriteError = "ERROR: Couldn't write capture file, capture stopped";
+      myIsCapturing = false;
+    }
+    if(request.type == 'F' && myBufferPool.size() < kMaxPendingFrames)
+      myBufferPool.push_back(std::move(request.data));
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIACapture::writeFrame(const Request& request)
+{
+  const uInt32 size = request.width * request.height;
+
+  // Frames are XOR'ed with the previous one, except for keyframes
+  bool keyframe = request.width != myPrevWidth ||
+                  request.height != myPrevHeight ||
+                  ++myFramesSinceKey >= kKeyFrameInterval;
+  const uInt8* data = request.data.data();
+  if(keyframe)
+    myFramesSinceKey = 0;
+  else
+  {
+    myDelta.resize(size);
+    for(uInt32 i = 0; i < size; ++i)
+      myDelta[i] = data[i] ^ myPrevFrame[i];
+    data = myDelta.data();
+  }
+
+  uInt8 header[9];
+  put16(put16(put32(header, request.frame), request.width), request.height);
+  header[8] = keyframe ? 1 : 0;
+  if(writeChunk('F', header, sizeof(header), data, size, true))
+  {
+    myPrevFrame.assign(request.data.begin(), request.data.begin() + size);
+    myPrevWidth = request.width;
+    myPrevHeight = request.height;
+  }
+  else
+    myPrevWidth = myPrevHeight = 0;  // the next frame must be a keyframe
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIACapture::writePalette(const Request& request)
+{
+  writeChunk('P', nullptr, 0, request.data.data(), uInt32(request.data.size()),
+             false);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIACapture::writeAudio(const Request& request)
+{
+  // Samples are stored in little-endian order
+  const uInt32 count = uInt32(request.audio.size());
+  myDelta.resize(count * 2);
+  for(uInt32 i = 0; i < count; ++i)
+    put16(&myDelta[i * 2], uInt16(request.audio[i]));
+
+  uInt8 header[9];
+  put32(header, request.rate);
+  header[4] = uInt8(request.channels);
+  put32(header + 5, count);
+  writeChunk('A', header, sizeof(header), myDelta.data(), count * 2, true);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool TIACapture::writeChunk(uInt8 type, const uInt8* header, uInt32 headerSize,
+                            const uInt8* data, uInt32 size, bool compress)
+{
+  if(compress)
+  {
+    // Speed is much more important than size here; the deltas are mostly
+    // zero, and compress very well anyway
+    uLongf compressed = compressBound(size);
+    myCompressBuffer.resize(compressed);
+    if(compress2(myCompressBuffer.data(), &compressed, data, size, 1) != Z_OK)
+      return false;
+
+    data = myCompressBuffer.data();
+    size = uInt32(compressed);
+  }
+
+  uInt8 chunk[5];
+  chunk[0] = type;
+  put32(chunk + 1, headerSize + size);
+  myFile.write(reinterpret_cast<const char*>(chunk), sizeof(chunk));
+  if(headerSize > 0)
+    myFile.write(reinterpret_cast<const char*>(header), headerSize);
+  myFile.write(reinterpret_cast<const char*>(data), size);
+
+  return myFile.good();
+}
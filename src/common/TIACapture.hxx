@@ -0,0 +1,218 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2017 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef TIA_CAPTURE_HXX
+#define TIA_CAPTURE_HXX
+
+#include <fstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <atomic>
+#include "bspf.hxx"
+
+/**
+  This class records the TIA output (and the sound being played) into a
+  single file, in a lossless format which is much cheaper to create than
+  PNG snapshots.  Frames are stored as the TIA palette indices, XOR'ed with
+  the previous frame (so unchanged pixels become zero) and compressed with
+  zlib, along with the palette used and the raw PCM sound data.  All
+  compression and writing is done in a background thread.
+
+  The file starts with the 8 byte signature 'StellaAV', followed by the
+  format version and the framerate * 1000 (each a 32-bit value).  The rest
+  of the file is a list of chunks, each consisting of a one byte type,
+  the 32-bit size of the data, and the data itself:
+
+    'P' - palette: 256 RGB triples, used for all following frames
+    'F' - frame: 32-bit frame number, 16-bit width and height, one byte
+          which is 1 for a keyframe (not XOR'ed with the previous frame),
+          followed by the zlib compressed palette indices
+    'A' - audio: 32-bit sample rate, one byte number of channels, 32-bit
+          number of samples, followed by the zlib compressed signed 16-bit
+          samples
+
+  All values are stored in little-endian order.  The 'capconv' tool
+  (in src/tools) converts these files into PNG images and a WAV file.
+*/
+class TIACapture
+{
+  public:
+    TIACapture();
+    ~TIACapture();
+
+    /**
+      Start capturing into the given file.
+
+      @param filename   The file to create
+      @param framerate  The framerate of the captured frames
+
+      @return  On success, capturing has started, otherwise a runtime_error
+               is thrown containing a more detailed error message.
+    */
+    void start(const string& filename, float framerate);
+
+    /**
+      Stop capturing; anything still waiting to be written is written
+      before the file is closed.
+    */
+    void stop();
+
+    /**
+      Answer whether a capture is currently in progress.
+    */
+    bool isCapturing() const { return myIsCapturing; }
+
+    /**
+      Add a frame of TIA output.  The data is copied, and a frame is
+      dropped if too many are already waiting to be written.
+
+      @param frame   The palette indices of the frame
+      @param width   The width of the frame
+      @param height  The height of the frame
+    */
+    void addFrame(const uInt8* frame, uInt32 width, uInt32 height);
+
+    /**
+      Set the palette used for the following frames.  This is tracked even
+      when not capturing, so that a new capture starts with it.
+
+      @param palette  The 256 RGB colours, in 0x00RRGGBB format
+    */
+    void setPalette(const uInt32* palette);
+
+    /**
+      Add sound samples; this is normally called from the sound thread.
+
+      @param samples   The (interleaved) samples to add
+      @param count     The number of samples (in total, for all channels)
+      @param channels  The number of channels
+      @param rate      The sample rate of the data
+    */
+    void addAudio(const Int16* samples, uInt32 count, uInt32 channels,
+                  uInt32 rate);
+
+    /**
+      Answer the number of frames captured and dropped in the current
+      (or last) capture.
+    */
+    uInt32 capturedFrames() const { return myFrameNumber - myDroppedFrames; }
+    uInt32 droppedFrames() const { return myDroppedFrames; }
+
+    /**
+      Check whether writing the capture file failed in the background.
+      If so, the capture is stopped and the error message is returned.
+
+      @param message  Receives the error message
+
+      @return  True if the capture was stopped because of an error
+    */
+    bool checkError(string& message);
+
+  private:
+    enum {
+      kVersion = 1,
+      kMaxPendingFrames = 30,   // half a second of frames
+      kKeyFrameInterval = 600   // force a keyframe every 10 seconds or so
+    };
+
+    // A chunk waiting to be written by the background thread
+    struct Request {
+      uInt8 type;
+      uInt32 frame;
+      uInt32 width, height;
+      vector<uInt8> data;
+      vector<Int16> audio;
+      uInt32 rate, channels;
+    };
+
+    /**
+      Queue a request for the background thread.  Must be called with the
+      lock held.
+    */
+    void queueRequest(Request& request);
+
+    /**
+      Queue the current palette, in RGB format.  Must be called with the
+      lock held.
+    */
+    void queuePalette();
+
+    /**
+      The background thread; compresses and writes queued chunks until
+      the capture is stopped.
+    */
+    void writeThread();
+
+    /**
+      Write the request to the file; these are only used by the background
+      thread.
+    */
+    void writeFrame(const Request& request);
+    void writePalette(const Request& request);
+    void writeAudio(const Request& request);
+
+    /**
+      Write a chunk to the file, consisting of the given header followed by
+      the data, which is optionally compressed.
+
+      @return  False if the chunk couldn't be compressed or written
+    */
+    bool writeChunk(uInt8 type, const uInt8* header, uInt32 headerSize,
+                    const uInt8* data, uInt32 size, bool compress);
+
+  private:
+    // The lock protects all members used by both threads
+    std::mutex myMutex;
+    std::condition_variable myCondition;
+    std::thread myThread;
+    std::deque<Request> myQueue;
+    vector<vector<uInt8>> myBufferPool;
+    bool myThreadQuit;
+
+    std::atomic<bool> myIsCapturing;
+    ofstream myFile;
+
+    // The palette currently in use (0x00RRGGBB)
+    uInt32 myPalette[256];
+
+    // Sound data received since the last frame
+    vector<Int16> myPendingAudio;
+    uInt32 myAudioRate, myAudioChannels;
+
+    // Frames added and dropped since the capture started
+    uInt32 myFrameNumber, myDroppedFrames;
+
+    // Set by the background thread when the file couldn't be written
+    string myWriteError;
+
+    // Used by the background thread only: the last frame written, and
+    // the buffer for compressed data
+    vector<uInt8> myPrevFrame, myDelta;
+    uInt32 myPrevWidth, myPrevHeight, myFramesSinceKey;
+    vector<uInt8> myCompressBuffer;
+
+  private:
+    // Following constructors and assignment operators not supported
+    TIACapture(const TIACapture&) = delete;
+    TIACapture(TIACapture&&) = delete;
+    TIACapture& operator=(const TIACapture&) = delete;
+    TIACapture& operator=(TIACapture&&) = delete;
+};
+
+#endif
@@ -53,37 +53,45 @@ void ZipHandler::reset()
 {
   // Reset the position and go from there
   if(myZip)
-    myZip->cd_pos = 0;
+    myZip->index_pos = 0;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool ZipHandler::hasNext()
 {
-  return myZip && (myZip->cd_pos < myZip->ecd.cd_size);
+  return myZip && (myZip->index_pos < myZip->index->names.size());
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 string ZipHandler::next()
 {
-  if(myZip)
+  if(hasNext())
   {
-    bool valid = false;
-    const zip_file_header* header = nullptr;
-    do {
-      header = zip_file_next_file(myZip);
-
-      // Ignore zero-length files and '__MACOSX' virtual directories
-      valid = header && (header->uncompressed_length > 0) &&
-              !BSPF::startsWithIgnoreCase(header->filename, "__MACOSX");
-    }
-    while(!valid && myZip->cd_pos < myZip->ecd.cd_size);
+    // Select the file, so that it can be decompressed
+    myZip->cd_pos = myZip->index->offsets[myZip->index_pos];
+    zip_file_next_file(myZip);
 
-    return valid ? header->filename : EmptyString;
+    return myZip->index->names[myZip->index_pos++];
   }
   else
     return EmptyString;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ZipHandler::find(const string& filename)
+{
+  if(myZip)
+  {
+    const auto& iter = myZip->index->lookup.find(filename);
+    if(iter != myZip->index->lookup.end())
+    {
+      myZip->cd_pos = myZip->index->offsets[iter->second];
+      return zip_file_next_file(myZip) != nullptr;
+    }
+  }
+  return false;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt32 ZipHandler::decompress(BytePtr& image)
 {
@@ -258,17 +266,34 @@ ZipHandler::zip_error ZipHandler::zip_file_open(const char* filename, zip_file**
 
   strcpy(string, filename);
   newzip->filename = string;
-  *zip = newzip;
 
-  // Count ROM files (we do it at this level so it will be cached)
-  while(hasNext())
+  // Index the valid files, and count ROM files (we do it at this level so
+  // it will be cached)
+  newzip->index = new zip_index;
+  while(newzip->cd_pos < newzip->ecd.cd_size)
   {
-    const std::string& file = next();
+    uInt32 offset = newzip->cd_pos;
+    const zip_file_header* header = zip_file_next_file(newzip);
+    if(header == nullptr)
+      break;
+
+    // Ignore zero-length files and '__MACOSX' virtual directories
+    if(header->uncompressed_length == 0 ||
+       BSPF::startsWithIgnoreCase(header->filename, "__MACOSX"))
+      continue;
+
+    const std::string file = header->filename;
+    // The first of any duplicate filenames is used
+    newzip->index->lookup.emplace(file, uInt32(newzip->index->names.size()));
+    newzip->index->names.push_back(file);
+    newzip->index->offsets.push_back(offset);
+
     if(BSPF::endsWithIgnoreCase(file, ".a26") ||
        BSPF::endsWithIgnoreCase(file, ".bin") ||
        BSPF::endsWithIgnoreCase(file, ".rom"))
-      (*zip)->romfiles++;
+      newzip->romfiles++;
   }
+  *zip = newzip;
 
   return ZIPERR_NONE;
 
@@ -445,6 +470,7 @@ void ZipHandler::free_zip_file(zip_file* zip)
       free(zip->ecd.raw);
     if(zip->cd != nullptr)
       free(zip->cd);
+    delete zip->index;
     free(zip);
   }
 }
@@ -19,6 +19,7 @@
 #define ZIP_HANDLER_HXX
 
 #include <fstream>
+#include <unordered_map>
 #include "bspf.hxx"
 
 /***************************************************************************
@@ -60,6 +61,11 @@
   This class implements a thin wrapper around the zip file management code
   from the MAME project.
 
+  The central directory of each archive is parsed only once, when it is
+  first opened, into an index of the (valid) files it contains.  The index
+  is cached along with the rest of the archive information, so iterating
+  over the files or selecting one by name never rescans the directory.
+
   @author  Wrapper class by Stephen Anthony, with main functionality
            by Aaron Giles
 */
@@ -77,6 +83,10 @@ class ZipHandler
     bool hasNext();   // Answer whether there are more files present
     string next();    // Get next file
 
+    // Select the file with the given name, without iterating over the
+    // other files; answer whether the file exists in the archive
+    bool find(const string& filename);
+
     // Decompress the currently selected file and return its length
     // An exception will be thrown on any errors
     uInt32 decompress(BytePtr& image);
@@ -150,6 +160,14 @@ class ZipHandler
       uInt32      rawlength;        /* length of the raw data */
     };
 
+    /* index of the valid files in the central directory */
+    struct zip_index
+    {
+      vector<string> names;       /* filenames, in central directory order */
+      vector<uInt32> offsets;     /* position of each file in central directory */
+      std::unordered_map<string, uInt32> lookup;  /* filename to index */
+    };
+
     /* describes an open ZIP file */
     struct zip_file
     {
@@ -164,6 +182,9 @@ class ZipHandler
       uInt32          cd_pos;     /* position in central directory */
       zip_file_header header;     /* current file header */
 
+      zip_index*      index;      /* index of the files in central directory */
+      uInt32          index_pos;  /* position in index */
+
       uInt8 buffer[ZIP_DECOMPRESS_BUFSIZE]; /* buffer for decompression */
     };
 
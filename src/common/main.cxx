@@ -73,6 +73,7 @@ int main(int argc, char* argv[])
   // We do it once here, so the rest of the program can assume valid settings
   theOSystem->logMessage("Validating config options ...", 2);
   theOSystem->settings().validate();
+  theOSystem->startupPhase("Load settings");
 
   // Create the full OSystem after the settings, since settings are
   // probably needed for defaults
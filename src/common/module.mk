@@ -11,7 +11,9 @@ MODULE_OBJS := \
 	src/common/PNGLibrary.o \
 	src/common/MouseControl.o \
 	src/common/RewindManager.o \
+	src/common/SearchIndex.o \
 	src/common/StateManager.o \
+	src/common/TIACapture.o \
 	src/common/ZipHandler.o
 
 MODULE_DIRS += \
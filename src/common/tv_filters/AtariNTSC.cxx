@@ -30,6 +30,156 @@
   #endif
 #endif
 
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+  #define NTSC_SIMD
+  #include <immintrin.h>
+  #define SIMD_TARGET(isa) __attribute__((target(isa)))
+#elif defined(_MSC_VER) && (defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+  // MSVC can always use SSE2 on these targets; AVX2 would need a separate
+  // compilation unit, so it isn't used
+  #define NTSC_SIMD
+  #define NTSC_SSE2_ONLY
+  #include <emmintrin.h>
+  #define SIMD_TARGET(isa)
+#endif
+
+#ifdef NTSC_SIMD
+namespace {
+  // Each chunk turns two input pixels into seven output pixels; every output
+  // pixel is the sum of four entries from the colour table, taken from the
+  // current and previous two input pixels (see ATARI_NTSC_RGB_OUT_8888).
+  // For output pixels 0 - 3 and 4 - 6, these entries are consecutive, so
+  // they are summed four at a time (the eighth value is junk, and is
+  // overwritten by the next chunk or the end of the row).
+  using ColorTable = const uInt32 (*)[AtariNTSC::entry_size];
+
+  SIMD_TARGET("sse2")
+  inline __m128i sumSSE2(const uInt32* a, const uInt32* b, const uInt32* c,
+                         const uInt32* d)
+  {
+    return _mm_add_epi32(
+      _mm_add_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a)),
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(b))),
+      _mm_add_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(c)),
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(d))));
+  }
+
+  // Same as ATARI_NTSC_CLAMP_ and ATARI_NTSC_RGB_OUT_8888, on four pixels
+  template<uInt32 clamp_mask, uInt32 clamp_add>
+  SIMD_TARGET("sse2")
+  inline __m128i rgbOutSSE2(__m128i raw)
+  {
+    const __m128i sub = _mm_and_si128(_mm_srli_epi32(raw, 9),
+                                      _mm_set1_epi32(Int32(clamp_mask)));
+    __m128i clamp = _mm_sub_epi32(_mm_set1_epi32(Int32(clamp_add)), sub);
+    raw = _mm_or_si128(raw, clamp);
+    clamp = _mm_sub_epi32(clamp, sub);
+    raw = _mm_and_si128(raw, clamp);
+
+    return _mm_or_si128(
+      _mm_or_si128(
+        _mm_and_si128(_mm_srli_epi32(raw, 5), _mm_set1_epi32(0x00FF0000)),
+        _mm_and_si128(_mm_srli_epi32(raw, 3), _mm_set1_epi32(0x0000FF00))),
+      _mm_and_si128(_mm_srli_epi32(raw, 1), _mm_set1_epi32(0x000000FF)));
+  }
+
+  template<uInt32 clamp_mask, uInt32 clamp_add>
+  SIMD_TARGET("sse2")
+  void chunksSSE2(ColorTable table, const uInt8* line_in, uInt32 chunk_count,
+                  uInt32* line_out, uInt32 const*& kernel0,
+                  uInt32 const*& kernel1, uInt32 const*& kernelx1)
+  {
+    for(uInt32 n = chunk_count; n; --n)
+    {
+      uInt32 const* kernelx0 = kernel0;
+      kernel0 = table[line_in[0]];
+      uInt32 const* kernel2 = table[line_in[1]];
+
+      const __m128i lo = sumSSE2(kernel0,      kernel1 + 17, kernelx0 + 7,  kernelx1 + 24);
+      const __m128i hi = sumSSE2(kernel0 + 4,  kernel2 + 14, kernelx0 + 11, kernel1  + 21);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(line_out),
+                       rgbOutSSE2<clamp_mask, clamp_add>(lo));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(line_out + 4),
+                       rgbOutSSE2<clamp_mask, clamp_add>(hi));
+
+      kernelx1 = kernel1;
+      kernel1  = kernel2;
+      line_in += 2;
+      line_out += 7;
+    }
+  }
+
+#ifndef NTSC_SSE2_ONLY
+  // Same as ATARI_NTSC_CLAMP_ and ATARI_NTSC_RGB_OUT_8888, on eight pixels
+  template<uInt32 clamp_mask, uInt32 clamp_add>
+  SIMD_TARGET("avx2")
+  inline __m256i rgbOutAVX2(__m256i raw)
+  {
+    const __m256i sub = _mm256_and_si256(_mm256_srli_epi32(raw, 9),
+                                         _mm256_set1_epi32(Int32(clamp_mask)));
+    __m256i clamp = _mm256_sub_epi32(_mm256_set1_epi32(Int32(clamp_add)), sub);
+    raw = _mm256_or_si256(raw, clamp);
+    clamp = _mm256_sub_epi32(clamp, sub);
+    raw = _mm256_and_si256(raw, clamp);
+
+    return _mm256_or_si256(
+      _mm256_or_si256(
+        _mm256_and_si256(_mm256_srli_epi32(raw, 5), _mm256_set1_epi32(0x00FF0000)),
+        _mm256_and_si256(_mm256_srli_epi32(raw, 3), _mm256_set1_epi32(0x0000FF00))),
+      _mm256_and_si256(_mm256_srli_epi32(raw, 1), _mm256_set1_epi32(0x000000FF)));
+  }
+
+  template<uInt32 clamp_mask, uInt32 clamp_add>
+  SIMD_TARGET("avx2")
+  void chunksAVX2(ColorTable table, const uInt8* line_in, uInt32 chunk_count,
+                  uInt32* line_out, uInt32 const*& kernel0,
+                  uInt32 const*& kernel1, uInt32 const*& kernelx1)
+  {
+    for(uInt32 n = chunk_count; n; --n)
+    {
+      uInt32 const* kernelx0 = kernel0;
+      kernel0 = table[line_in[0]];
+      uInt32 const* kernel2 = table[line_in[1]];
+
+      // The sums are in 128-bit halves, but clamping and output is done
+      // on the whole chunk at once
+      const __m128i lo = sumSSE2(kernel0,      kernel1 + 17, kernelx0 + 7,  kernelx1 + 24);
+      const __m128i hi = sumSSE2(kernel0 + 4,  kernel2 + 14, kernelx0 + 11, kernel1  + 21);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(line_out),
+          rgbOutAVX2<clamp_mask, clamp_add>(
+            _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1)));
+
+      kernelx1 = kernel1;
+      kernel1  = kernel2;
+      line_in += 2;
+      line_out += 7;
+    }
+  }
+#endif
+}
+#endif
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+AtariNTSC::ChunkFunction AtariNTSC::detectChunkFunction()
+{
+#if defined(NTSC_SSE2_ONLY)
+  return chunksSSE2<atari_ntsc_clamp_mask, atari_ntsc_clamp_add>;
+#elif defined(NTSC_SIMD)
+  __builtin_cpu_init();
+  if(__builtin_cpu_supports("avx2"))
+    return chunksAVX2<atari_ntsc_clamp_mask, atari_ntsc_clamp_add>;
+  else if(__builtin_cpu_supports("sse2"))
+    return chunksSSE2<atari_ntsc_clamp_mask, atari_ntsc_clamp_add>;
+  else
+    return nullptr;
+#else
+  return nullptr;
+#endif
+}
+
+const AtariNTSC::ChunkFunction AtariNTSC::ourChunkFunction =
+    AtariNTSC::detectChunkFunction();
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void AtariNTSC::initialize(const Setup& setup, const uInt8* palette)
 {
@@ -106,10 +256,6 @@ void AtariNTSC::render(const uInt8* atari_in, const uInt32 in_width, const uInt3
   // ...and make them join again
   for(uInt32 i = 0; i < myWorkerThreads; ++i)
     myThreads[i].join();
-
-  // Copy phosphor values into out buffer
-  if(rgb_in != nullptr)
-    memcpy(rgb_out, rgb_in, in_height * out_pitch);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -132,7 +278,14 @@ void AtariNTSC::renderThread(const uInt8* atari_in, const uInt32 in_width,
     uInt32* restrict line_out = static_cast<uInt32*>(rgb_out);
     ++line_in;
 
-    for(uInt32 n = chunk_count; n; --n)
+    if(ourChunkFunction)
+    {
+      ourChunkFunction(myColorTable, line_in, chunk_count, line_out,
+                       kernel0, kernel1, kernelx1);
+      line_in  += chunk_count * PIXEL_in_chunk;
+      line_out += chunk_count * PIXEL_out_chunk;
+    }
+    else for(uInt32 n = chunk_count; n; --n)
     {
       // order of input and output pixels must not be altered
       ATARI_NTSC_COLOR_IN(0, line_in[0]);
@@ -205,7 +358,14 @@ void AtariNTSC::renderWithPhosphorThread(const uInt8* atari_in, const uInt32 in_
     uInt32* restrict line_out = static_cast<uInt32*>(rgb_out);
     ++line_in;
 
-    for(uInt32 n = chunk_count; n; --n)
+    if(ourChunkFunction)
+    {
+      ourChunkFunction(myColorTable, line_in, chunk_count, line_out,
+                       kernel0, kernel1, kernelx1);
+      line_in  += chunk_count * PIXEL_in_chunk;
+      line_out += chunk_count * PIXEL_out_chunk;
+    }
+    else for(uInt32 n = chunk_count; n; --n)
     {
       // order of input and output pixels must not be altered
       ATARI_NTSC_COLOR_IN(0, line_in[0]);
@@ -251,68 +411,17 @@ void AtariNTSC::renderWithPhosphorThread(const uInt8* atari_in, const uInt32 in_
     ATARI_NTSC_RGB_OUT_8888(6, line_out[6]);
 #endif
 
-    // Do phosphor mode (blend the resulting frames)
+    // Do phosphor mode (blend the resulting frames), storing the result
+    // into both the out buffer and the displayed frame buffer (for next frame)
     // Note: The code assumes that AtariNTSC::outWidth(kTIAW) == outPitch == 565
-    for (uInt32 x = AtariNTSC::outWidth(in_width) / 8; x; --x)
-    {
-      // Store back into displayed frame buffer (for next frame)
-      rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
-      bufofs++;
-      rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
-      bufofs++;
-      rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
-      bufofs++;
-      rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
-      bufofs++;
-      rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
-      bufofs++;
-      rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
-      bufofs++;
-      rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
-      bufofs++;
-      rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
-      bufofs++;
-    }
-    // finish final pixels
-    rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
-    bufofs++;
-    rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
-    bufofs++;
-    rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
-    bufofs++;
-    rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
-    bufofs++;
-    rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
-    bufofs++;
-#if 0
-    rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
-    bufofs++;
-    rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
-    bufofs++;
-#endif
+    myPhosphorBlend.blend(out + bufofs, rgb_in + bufofs, AtariNTSC::outWidth(in_width));
+    bufofs += AtariNTSC::outWidth(in_width);
 
     atari_in += in_width;
     rgb_out = static_cast<char*>(rgb_out) + out_pitch;
   }
 }
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-inline uInt32 AtariNTSC::getRGBPhosphor(const uInt32 c, const uInt32 p) const
-{
-#define TO_RGB(color, red, green, blue) \
-    const uInt8 red = color >> 16; const uInt8 green = color >> 8; const uInt8 blue = color;
-
-  TO_RGB(c, rc, gc, bc);
-  TO_RGB(p, rp, gp, bp);
-
-  // Mix current calculated frame with previous displayed frame
-  const uInt8 rn = myPhosphorPalette[rc][rp];
-  const uInt8 gn = myPhosphorPalette[gc][gp];
-  const uInt8 bn = myPhosphorPalette[bc][bp];
-
-  return (rn << 16) | (gn << 8) | bn;
-}
-
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void AtariNTSC::init(init_t& impl, const Setup& setup)
 {
@@ -42,6 +42,7 @@
 
 #include <cmath>
 #include "bspf.hxx"
+#include "PhosphorBlend.hxx"
 
 class AtariNTSC
 {
@@ -86,9 +87,9 @@ class AtariNTSC
     // Set up threading
     void enableThreading(bool enable);
 
-    // Set phosphor palette, for use in Blargg + phosphor mode
-    void setPhosphorPalette(uInt8 palette[256][256]) {
-      memcpy(myPhosphorPalette, palette, 256 * 256);
+    // Set phosphor blending, for use in Blargg + phosphor mode
+    void setPhosphorBlend(const PhosphorBlend& blend) {
+      myPhosphorBlend = blend;
     }
 
     // Filters one or more rows of pixels. Input pixels are 8-bit Atari
@@ -119,16 +120,6 @@ class AtariNTSC
     void renderWithPhosphorThread(const uInt8* atari_in, const uInt32 in_width,
       const uInt32 in_height, const uInt32 numThreads, const uInt32 threadNum, uInt32* rgb_in, void* rgb_out, const uInt32 out_pitch);
 
-    /**
-      Used to calculate an averaged color for the 'phosphor' effect.
-
-      @param c  RGB Color 1 (current frame)
-      @param p  RGB Color 2 (previous frame)
-
-      @return  Averaged value of the two RGB colors
-    */
-    uInt32 getRGBPhosphor(const uInt32 c, const uInt32 cp) const;
-
   private:
     enum {
       PIXEL_in_chunk  = 2,   // number of input pixels read per chunk
@@ -166,7 +157,18 @@ class AtariNTSC
     #define LUMA_CUTOFF 0.20
 
     uInt32 myColorTable[palette_size][entry_size];
-    uInt8 myPhosphorPalette[256][256];
+    PhosphorBlend myPhosphorBlend;
+
+    // Renders whole chunks of a row using SIMD instructions, starting from
+    // and updating the state of the ATARI_NTSC_xxx macros (nullptr when not
+    // available)
+    using ChunkFunction = void (*)(const uInt32 (*table)[entry_size],
+        const uInt8* line_in, uInt32 chunk_count, uInt32* line_out,
+        uInt32 const*& kernel0, uInt32 const*& kernel1, uInt32 const*& kernelx1);
+    static const ChunkFunction ourChunkFunction;
+
+    // Choose the widest instruction set supported by the CPU
+    static ChunkFunction detectChunkFunction();
 
     // Rendering threads
     unique_ptr<std::thread[]> myThreads;
@@ -0,0 +1,179 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2017 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include "PhosphorBlend.hxx"
+
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+  #define PHOSPHOR_SIMD
+  #include <immintrin.h>
+  #define SIMD_TARGET(isa) __attribute__((target(isa)))
+#elif defined(_MSC_VER) && (defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+  // MSVC can always use SSE2 on these targets; AVX2 would need a separate
+  // compilation unit, so it isn't used
+  #define PHOSPHOR_SIMD
+  #define PHOSPHOR_SSE2_ONLY
+  #include <emmintrin.h>
+  #define SIMD_TARGET(isa)
+#endif
+
+#ifdef PHOSPHOR_SIMD
+namespace {
+  SIMD_TARGET("sse2")
+  inline __m128i decaySSE2(__m128i p16, __m128i zero, __m128 percent)
+  {
+    // Widen to 32 bits, and decay in single precision exactly like
+    // PhosphorBlend::getPhosphor() does
+    __m128i lo = _mm_cvttps_epi32(_mm_mul_ps(
+        _mm_cvtepi32_ps(_mm_unpacklo_epi16(p16, zero)), percent));
+    __m128i hi = _mm_cvttps_epi32(_mm_mul_ps(
+        _mm_cvtepi32_ps(_mm_unpackhi_epi16(p16, zero)), percent));
+    return _mm_packs_epi32(lo, hi);
+  }
+
+  SIMD_TARGET("sse2")
+  void blendSSE2(uInt32* current, uInt32* previous, uInt32 count, float percent)
+  {
+    const __m128i zero = _mm_setzero_si128(),
+                  rgb  = _mm_set1_epi32(0x00ffffff);
+    const __m128 m = _mm_set1_ps(percent);
+    for(uInt32 i = 0; i + 4 <= count; i += 4)
+    {
+      __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(current + i));
+      __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(previous + i));
+
+      __m128i lo = decaySSE2(_mm_unpacklo_epi8(p, zero), zero, m);
+      __m128i hi = decaySSE2(_mm_unpackhi_epi8(p, zero), zero, m);
+      __m128i n  = _mm_and_si128(_mm_max_epu8(c, _mm_packus_epi16(lo, hi)), rgb);
+
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(current + i), n);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(previous + i), n);
+    }
+  }
+
+#ifndef PHOSPHOR_SSE2_ONLY
+  SIMD_TARGET("avx2")
+  inline __m256i decayAVX2(__m256i p16, __m256i zero, __m256 percent)
+  {
+    __m256i lo = _mm256_cvttps_epi32(_mm256_mul_ps(
+        _mm256_cvtepi32_ps(_mm256_unpacklo_epi16(p16, zero)), percent));
+    __m256i hi = _mm256_cvttps_epi32(_mm256_mul_ps(
+        _mm256_cvtepi32_ps(_mm256_unpackhi_epi16(p16, zero)), percent));
+    return _mm256_packs_epi32(lo, hi);
+  }
+
+  SIMD_TARGET("avx2")
+  void blendAVX2(uInt32* current, uInt32* previous, uInt32 count, float percent)
+  {
+    const __m256i zero = _mm256_setzero_si256(),
+                  rgb  = _mm256_set1_epi32(0x00ffffff);
+    const __m256 m = _mm256_set1_ps(percent);
+    uInt32 i = 0;
+    for(; i + 8 <= count; i += 8)
+    {
+      __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(current + i));
+      __m256i p = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(previous + i));
+
+      // Unpacking and packing both work within 128-bit lanes, so the
+      // pixel order is preserved
+      __m256i lo = decayAVX2(_mm256_unpacklo_epi8(p, zero), zero, m);
+      __m256i hi = decayAVX2(_mm256_unpackhi_epi8(p, zero), zero, m);
+      __m256i n  = _mm256_and_si256(_mm256_max_epu8(c, _mm256_packus_epi16(lo, hi)), rgb);
+
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(current + i), n);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(previous + i), n);
+    }
+    blendSSE2(current + i, previous + i, count - i, percent);
+  }
+#endif
+}
+#endif
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+PhosphorBlend::BlendFunction PhosphorBlend::detectBlendFunction()
+{
+#if defined(PHOSPHOR_SSE2_ONLY)
+  return blendSSE2;
+#elif defined(PHOSPHOR_SIMD)
+  __builtin_cpu_init();
+  if(__builtin_cpu_supports("avx2"))
+    return blendAVX2;
+  else if(__builtin_cpu_supports("sse2"))
+    return blendSSE2;
+  else
+    return nullptr;
+#else
+  return nullptr;
+#endif
+}
+
+const PhosphorBlend::BlendFunction PhosphorBlend::ourBlendFunction =
+    PhosphorBlend::detectBlendFunction();
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+PhosphorBlend::PhosphorBlend()
+  : myPercent(0.60f),
+    myUseSIMD(false)
+{
+  setPercent(myPercent);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void PhosphorBlend::setPercent(float percent)
+{
+  myPercent = percent;
+
+  // Precalculate the average colors for the 'phosphor' effect
+  for(Int16 c = 255; c >= 0; c--)
+    for(Int16 p = 255; p >= 0; p--)
+      myPalette[c][p] = getPhosphor(uInt8(c), uInt8(p));
+
+  // The SIMD kernels are only used when they reproduce the table exactly
+  // (the float calculation could differ, ie. with x87 excess precision);
+  // so run them once over every channel value and compare
+  myUseSIMD = false;
+  if(ourBlendFunction)
+  {
+    uInt32 current[88], previous[88];
+    for(uInt32 i = 0; i < 88; ++i)
+    {
+      current[i] = 0;
+      previous[i] = (((i * 3) & 0xff) << 16) | (((i * 3 + 1) & 0xff) << 8) |
+                    ((i * 3 + 2) & 0xff);
+    }
+    ourBlendFunction(current, previous, 88, myPercent);
+
+    myUseSIMD = true;
+    for(uInt32 i = 0; i < 88; ++i)
+      myUseSIMD = myUseSIMD && current[i] == previous[i] &&
+          current[i] == getRGBPhosphor(0, (((i * 3) & 0xff) << 16) |
+             (((i * 3 + 1) & 0xff) << 8) | ((i * 3 + 2) & 0xff));
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void PhosphorBlend::blend(uInt32* current, uInt32* previous, uInt32 count) const
+{
+  uInt32 i = 0;
+  if(myUseSIMD)
+  {
+    // Whole vectors are blended by the kernel, the remainder from the table
+    i = count & ~7u;
+    ourBlendFunction(current, previous, i, myPercent);
+  }
+  for(; i < count; ++i)
+    previous[i] = current[i] = getRGBPhosphor(current[i], previous[i]);
+}
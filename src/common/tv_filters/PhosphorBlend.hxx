@@ -0,0 +1,108 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2017 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef PHOSPHOR_BLEND_HXX
+#define PHOSPHOR_BLEND_HXX
+
+#include "bspf.hxx"
+
+/**
+  This class blends the current and previous frames for the 'phosphor'
+  effect, and is used in both normal and Blargg TV modes.
+
+  Each colour channel of the result is the maximum of the current value
+  and the decayed previous value.  This is precalculated in a lookup table,
+  but whole rows of pixels are normally blended using SSE2 or AVX2, doing
+  the same calculation the table is built from.  The instruction set is
+  chosen at runtime, based on what the CPU supports; the table is used
+  when no SIMD path is available.
+*/
+class PhosphorBlend
+{
+  public:
+    PhosphorBlend();
+
+    /**
+      Set the amount of the previous frame that remains after decay,
+      and precalculate the blending for it.
+
+      @param percent  The blend amount, from 0.0 to 1.0
+    */
+    void setPercent(float percent);
+
+    /**
+      Used to calculate an averaged color for the 'phosphor' effect.
+
+      @param c1  Color 1
+      @param c2  Color 2
+
+      @return  Averaged value of the two colors
+    */
+    inline uInt8 getPhosphor(const uInt8 c1, uInt8 c2) const {
+      // Use maximum of current and decayed previous values
+      c2 = uInt8(c2 * myPercent);
+      if(c1 > c2)  return c1; // raise (assumed immediate)
+      else         return c2; // decay
+    }
+
+    /**
+      Used to calculate an averaged color for the 'phosphor' effect.
+
+      @param c  RGB Color 1 (current frame)
+      @param p  RGB Color 2 (previous frame)
+
+      @return  Averaged value of the two RGB colors
+    */
+    inline uInt32 getRGBPhosphor(const uInt32 c, const uInt32 p) const {
+      // Mix current calculated frame with previous displayed frame
+      const uInt8 rn = myPalette[uInt8(c >> 16)][uInt8(p >> 16)];
+      const uInt8 gn = myPalette[uInt8(c >> 8)][uInt8(p >> 8)];
+      const uInt8 bn = myPalette[uInt8(c)][uInt8(p)];
+
+      return (rn << 16) | (gn << 8) | bn;
+    }
+
+    /**
+      Blend a row of pixels of the current frame with the previous frame.
+      The result is stored into both buffers, since it's both displayed
+      and needed as the previous frame for the next blend.
+
+      @param current   RGB pixels of the current frame
+      @param previous  RGB pixels of the previously displayed frame
+      @param count     The number of pixels to blend
+    */
+    void blend(uInt32* current, uInt32* previous, uInt32 count) const;
+
+  private:
+    // Amount of the previous frame that remains after decay
+    float myPercent;
+
+    // Precalculated averaged phosphor colors
+    uInt8 myPalette[256][256];
+
+    // Whether the SIMD kernel produces results identical to the table
+    bool myUseSIMD;
+
+    // Blends a row using SIMD instructions (nullptr when not available)
+    using BlendFunction = void (*)(uInt32*, uInt32*, uInt32, float);
+    static const BlendFunction ourBlendFunction;
+
+    // Choose the widest instruction set supported by the CPU
+    static BlendFunction detectBlendFunction();
+};
+
+#endif
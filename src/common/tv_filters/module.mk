@@ -2,7 +2,8 @@ MODULE := src/common/tv_filters
 
 MODULE_OBJS := \
 	src/common/tv_filters/NTSCFilter.o \
-	src/common/tv_filters/AtariNTSC.o
+	src/common/tv_filters/AtariNTSC.o \
+	src/common/tv_filters/PhosphorBlend.o
 
 MODULE_DIRS += \
 	src/common/tv_filters
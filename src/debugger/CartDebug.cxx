@@ -16,6 +16,8 @@
 //============================================================================
 
 #include <time.h>
+#include <atomic>
+#include <thread>
 
 #include "bspf.hxx"
 #include "System.hxx"
@@ -25,6 +27,7 @@
 #include "CpuDebug.hxx"
 #include "OSystem.hxx"
 #include "Settings.hxx"
+#include "Serializer.hxx"
 #include "Version.hxx"
 #include "CartDebug.hxx"
 #include "CartDebugWidget.hxx"
@@ -43,6 +46,7 @@ CartDebug::CartDebug(Debugger& dbg, Console& console, const OSystem& osystem)
     myOSystem(osystem),
     myDebugWidget(nullptr),
     myAddrToLineIsROM(true),
+    myLabelGeneration(0),
     myRWPortAddress(0),
     myLabelLength(8)   // longest pre-defined label
 {
@@ -272,9 +276,11 @@ bool CartDebug::disassemble(bool force)
         if (PC == *i)  // already present
           break;
       }
-      // Otherwise, add the item at the end
-      if (i == addresses.end())
-        addresses.push_back(PC); 
+      // Otherwise, add the item at the end; an address which the last
+      // disassembly already decoded as code would only be dropped again
+      // by DiStella, so the cached result remains valid without it
+      if (i == addresses.end() && !isCachedCode(info, PC))
+        addresses.push_back(PC);
     }
 
     // Always attempt to resolve code sections unless it's been
@@ -299,33 +305,133 @@ bool CartDebug::fillDisassemblyList(BankInfo& info, uInt16 search)
   if(info.addressList.size() == 0)
     return false;
 
-  myDisassembly.list.clear();
-  myDisassembly.fieldwidth = 14 + myLabelLength;
-  DiStella distella(*this, myDisassembly.list, info, DiStella::settings,
-                    myDisLabels, myDisDirectives, myReserved);
-
-  // Parts of the disassembly will be accessed later in different ways
-  // We place those parts in separate maps, to speed up access
-  bool found = false;
-  myAddrToLineList.clear();
-  myAddrToLineIsROM = info.offset & 0x1000;
-  for(uInt32 i = 0; i < myDisassembly.list.size(); ++i)
+  uInt64 key = disassemblyKey(info);
+  const auto& cached = myDisassemblyCache.find(key);
+  if(cached != myDisassemblyCache.end())
   {
-    const DisassemblyTag& tag = myDisassembly.list[i];
-    const uInt16 address = tag.address & 0xFFF;
+    const DisassemblyCacheEntry& entry = *cached->second;
+    myDisassembly = entry.disassembly;
+    myAddrToLineList = entry.addrToLine;
+    memcpy(myDisLabels, entry.labels, sizeof(myDisLabels));
+    memcpy(myDisDirectives, entry.directives, sizeof(myDisDirectives));
+    info.start = entry.start;
+    info.end = entry.end;
+    info.offset = entry.offset;
+  }
+  else
+  {
+    myDisassembly.list.clear();
+    myDisassembly.fieldwidth = 14 + myLabelLength;
+    DiStella distella(*this, myDisassembly.list, info, DiStella::settings,
+                      myDisLabels, myDisDirectives, myReserved);
 
-    // Exclude 'ROW'; they don't have a valid address
-    if(tag.type != CartDebug::ROW)
+    // Parts of the disassembly will be accessed later in different ways
+    // We place those parts in separate maps, to speed up access
+    myAddrToLineList.clear();
+    for(uInt32 i = 0; i < myDisassembly.list.size(); ++i)
     {
-      // Create a mapping from addresses to line numbers
-      myAddrToLineList.emplace(address, i);
+      const DisassemblyTag& tag = myDisassembly.list[i];
 
-      // Did we find the search value?
-      if(address == (search & 0xFFF))
-        found = true;
+      // Exclude 'ROW'; they don't have a valid address
+      // Create a mapping from addresses to line numbers
+      if(tag.type != CartDebug::ROW)
+        myAddrToLineList.emplace(tag.address & 0xFFF, i);
     }
+
+    if(myDisassemblyCache.size() >= kMaxCachedDisassemblies)
+      myDisassemblyCache.clear();
+
+    auto entry = make_shared<DisassemblyCacheEntry>();
+    entry->disassembly = myDisassembly;
+    entry->addrToLine = myAddrToLineList;
+    memcpy(entry->labels, myDisLabels, sizeof(myDisLabels));
+    memcpy(entry->directives, myDisDirectives, sizeof(myDisDirectives));
+    entry->start = info.start;
+    entry->end = info.end;
+    entry->offset = info.offset;
+    myDisassemblyCache[key] = entry;
+
+    // DiStella drops redundant entry points and sets the offset of a new
+    // bank; the result is the same when starting from that state too
+    uInt64 newKey = disassemblyKey(info);
+    if(newKey != key)
+      myDisassemblyCache[newKey] = entry;
+  }
+  myAddrToLineIsROM = info.offset & 0x1000;
+
+  // Did we find the search value?
+  return myAddrToLineList.find(search & 0xFFF) != myAddrToLineList.end();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt64 CartDebug::disassemblyKey(const BankInfo& info) const
+{
+  // FNV-1a, which is plenty for telling apart states of the same ROM
+  uInt64 hash = 0xcbf29ce484222325ULL;
+  auto add = [&hash](uInt32 value) {
+    for(int i = 0; i < 4; ++i, value >>= 8)
+      hash = (hash ^ (value & 0xFF)) * 0x100000001b3ULL;
+  };
+
+  // The same address range DiStella will use
+  uInt16 start = info.addressList.front(), base, size;
+  if(start & 0x1000)
+  {
+    size = info.size;
+    base = info.offset != 0 ? info.offset : start - (start % info.size);
+  }
+  else
+  {
+    size = 128;
+    base = 0x80;
+  }
+  add(base);
+  add(info.offset);
+  add(size);
+
+  // Bank contents, and how the emulation has accessed them (DiStella
+  // itself only ever adds TCODE, which it doesn't read back)
+  for(uInt32 addr = base; addr < uInt32(base + size); ++addr)
+    add(mySystem.peek(addr) |
+        ((myDebugger.getAccessFlags(addr) & ~CartDebug::TCODE) << 8));
+
+  for(uInt16 addr: info.addressList)
+    add(addr);
+  add(0xFFFFFFFF);
+  for(const auto& tag: info.directiveList)
+  {
+    add(tag.type);
+    add(tag.start | (tag.end << 16));
   }
-  return found;
+  add(0xFFFFFFFF);
+
+  add(myLabelGeneration);
+  add(myLabelLength);
+
+  const DiStella::Settings& s = DiStella::settings;
+  add(s.gfxFormat);
+  add(s.resolveCode | (s.showAddresses << 1) | (s.aFlag << 2) |
+      (s.fFlag << 3) | (s.rFlag << 4) | (s.bFlag << 5));
+  add(s.bytesWidth);
+
+  return hash;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool CartDebug::isCachedCode(const BankInfo& info, uInt16 address) const
+{
+  if(info.addressList.size() == 0)
+    return false;
+
+  const auto& cached = myDisassemblyCache.find(disassemblyKey(info));
+  if(cached == myDisassemblyCache.end())
+    return false;
+
+  const DisassemblyCacheEntry& entry = *cached->second;
+  const auto& line = entry.addrToLine.find(address & 0xFFF);
+  return line != entry.addrToLine.end() &&
+         entry.disassembly.list[line->second].type == CartDebug::CODE &&
+         entry.disassembly.list[line->second].disasm[0] != '.';
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -526,6 +632,7 @@ bool CartDebug::addLabel(const string& label, uInt16 address)
       myUserAddresses.emplace(label, address);
       myUserLabels.emplace(address, label);
       myLabelLength = std::max(myLabelLength, uInt16(label.size()));
+      ++myLabelGeneration;
       mySystem.setDirtyPage(address);
       return true;
   }
@@ -546,6 +653,7 @@ bool CartDebug::removeLabel(const string& label)
     // Erase the label itself
     mySystem.setDirtyPage(iter->second);
     myUserAddresses.erase(iter);
+    ++myLabelGeneration;
 
     return true;
   }
@@ -687,6 +795,7 @@ string CartDebug::loadListFile()
 
   myUserAddresses.clear();
   myUserLabels.clear();
+  ++myLabelGeneration;
 
   if(myListFile == "")
   {
@@ -950,12 +1059,22 @@ string CartDebug::saveConfigFile()
   return "saved " + node.getShortPath() + " OK";
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+struct CartDebug::BankDisassembly {
+  uInt32 bank;
+  BankInfo info;
+  DiStella::BankImage image;
+  uInt8 flags[0x1000];  // the access flags before disassembling
+  const DiStella::Settings* settings;
+  Disassembly disasm;
+  ReservedEquates reserved;
+  uInt8 labels[0x1000], directives[0x1000];
+  string output;  // the formatted disassembly
+};
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 string CartDebug::saveDisassembly()
 {
-  if(myConsole.cartridge().bankCount() > 1)
-    return DebuggerParser::red("disassembly for multi-bank ROM not yet supported");
-
   if(myDisasmFile == "")
   {
     const string& propsname =
@@ -971,15 +1090,6 @@ string CartDebug::saveDisassembly()
 
 #define ALIGN(x) setfill(' ') << left << setw(x)
 
-  // We can't print the header to the disassembly until it's actually
-  // been processed; therefore buffer output to a string first
-  ostringstream buf;
-  buf << "\n\n;***********************************************************\n"
-      << ";      Bank " << myConsole.cartridge().getBank();
-  if (myConsole.cartridge().bankCount() > 1)
-    buf << " / 0.." << myConsole.cartridge().bankCount() - 1;
-  buf << "\n;***********************************************************\n\n";
-
   // Use specific settings for disassembly output
   // This will most likely differ from what you see in the debugger
   DiStella::Settings settings;
@@ -992,83 +1102,110 @@ string CartDebug::saveDisassembly()
   settings.bytesWidth = 8+1;  // same as Stella debugger
   settings.bFlag = DiStella::settings.bFlag;; // process break routine (TODO)
 
-  Disassembly disasm;
-  disasm.list.reserve(2048);
-  for(int bank = 0; bank < myConsole.cartridge().bankCount(); ++bank)
+  // Only the bank currently mapped can be accessed through the System,
+  // so first a copy of each bank is made; these are then disassembled
+  // independently of the System and of each other
+  Cartridge& cart = myConsole.cartridge();
+  Serializer cartState;
+  cart.save(cartState);
+
+  vector<BankDisassembly> banks(cart.bankCount());
+  for(uInt32 b = 0; b < banks.size(); ++b)
   {
-    BankInfo& info = myBankInfo[bank];
+    BankDisassembly& bank = banks[b];
+    bank.bank = b;
+    bank.info = myBankInfo[b];
+    bank.settings = &settings;
+
     // An empty address list means that DiStella can't do a disassembly
-    if(info.addressList.size() == 0)
+    if(bank.info.addressList.size() == 0)
       continue;
 
-    // Disassemble bank
-    disasm.list.clear();
-    DiStella distella(*this, disasm.list, info, settings,
-                      myDisLabels, myDisDirectives, myReserved);
-    
-    if (myReserved.breakFound)
-      addLabel("Break", myDebugger.dpeek(0xfffe));
+    cart.unlockBank();
+    bool mapped = b == cart.getBank() || cart.bank(b);
+    cart.lockBank();
+    if(!mapped)
+    {
+      bank.info.addressList.clear();
+      continue;
+    }
+    for(uInt16 addr = 0; addr < 0x1000; ++addr)
+    {
+      bank.image.data[addr] = myDebugger.peek(0x1000 + addr);
+      bank.image.flags[addr] = myDebugger.getAccessFlags(0x1000 + addr);
+    }
+    std::copy_n(bank.image.flags, 0x1000, bank.flags);
+  }
+  disassembleBanks(banks, 0);
 
-    buf << "    SEG     CODE\n"
-        << "    ORG     $" << Base::HEX4 << info.offset << "\n\n";
+  // A BRK instruction in a bank defines the 'Break' label, which is then
+  // used by all following banks; these are done again when it changes
+  // the labels, so that the result doesn't depend on the order in which
+  // the banks were processed
+  for(uInt32 b = 0; b < banks.size(); ++b)
+  {
+    const BankDisassembly& bank = banks[b];
+    if(!bank.reserved.breakFound)
+      continue;
 
-    // Format in 'distella' style
-    for(uInt32 i = 0; i < disasm.list.size(); ++i)
+    AddrToLabel labels = myUserLabels;
+    addLabel("Break", bank.image.data[0xFFE] | (bank.image.data[0xFFF] << 8));
+    if(labels != myUserLabels)
     {
-      const DisassemblyTag& tag = disasm.list[i];
+      for(uInt32 i = b + 1; i < banks.size(); ++i)
+      {
+        BankDisassembly& redo = banks[i];
+        if(redo.info.addressList.size() == 0)
+          continue;
+        redo.info = myBankInfo[i];
+        redo.reserved = ReservedEquates();
+        std::copy_n(redo.flags, 0x1000, redo.image.flags);
+      }
+      disassembleBanks(banks, b + 1);
+    }
+  }
 
-      // Add label (if any)
-      if(tag.label != "")
-        buf << ALIGN(4) << (tag.label) << "\n";
-      buf << "    ";
+  // Merge the results in bank order, and add the code found by DiStella
+  // to the access flags
+  // We can't print the header to the disassembly until it's actually
+  // been processed; therefore buffer output to a string first
+  ostringstream buf;
+  for(BankDisassembly& bank: banks)
+  {
+    buf << bank.output;
+    if(bank.info.addressList.size() == 0)
+      continue;
 
-      switch(tag.type)
+    myBankInfo[bank.bank] = bank.info;
+    for(uInt32 i = 0; i < 16; ++i)
+      myReserved.TIARead[i] |= bank.reserved.TIARead[i];
+    for(uInt32 i = 0; i < 64; ++i)
+      myReserved.TIAWrite[i] |= bank.reserved.TIAWrite[i];
+    for(uInt32 i = 0; i < 24; ++i)
+      myReserved.IOReadWrite[i] |= bank.reserved.IOReadWrite[i];
+    for(uInt32 i = 0; i < 128; ++i)
+      myReserved.ZPRAM[i] |= bank.reserved.ZPRAM[i];
+    myReserved.Label.insert(bank.reserved.Label.begin(), bank.reserved.Label.end());
+
+    cart.unlockBank();
+    if(bank.bank == cart.getBank() || cart.bank(bank.bank))
+    {
+      for(uInt16 addr = 0; addr < 0x1000; ++addr)
       {
-        case CartDebug::CODE:
-        {
-          buf << ALIGN(32) << tag.disasm << tag.ccount.substr(0, 5) << tag.ctotal << tag.ccount.substr(5, 2);
-          if (tag.disasm.find("WSYNC") != std::string::npos)
-            buf << "\n;---------------------------------------";
-          break;
-        }
-        case CartDebug::ROW:
-        {
-          buf << ".byte   " << ALIGN(32) << tag.disasm.substr(6, 8*4-1) << "; $" << Base::HEX4 << tag.address << " (*)";
-          break;
-        }
-        case CartDebug::GFX:
-        {
-          buf << ".byte   " << (settings.gfxFormat == Base::F_2 ? "%" : "$")
-              << tag.bytes << " ; |";
-          for(int c = 12; c < 20; ++c)
-            buf << ((tag.disasm[c] == '\x1e') ? "#" : " ");
-          buf << ALIGN(13) << "|" << "$" << Base::HEX4 << tag.address << " (G)";
-          break;
-        }
-        case CartDebug::PGFX:
-        {
-          buf << ".byte   " << (settings.gfxFormat == Base::F_2 ? "%" : "$")
-              << tag.bytes << " ; |";
-          for(int c = 12; c < 20; ++c)
-            buf << ((tag.disasm[c] == '\x1f') ? "*" : " ");
-          buf << ALIGN(13) << "|" << "$" << Base::HEX4 << tag.address << " (P)";
-          break;
-        }
-        case CartDebug::DATA:
-        {          
-          buf << ".byte   " << ALIGN(32) << tag.disasm.substr(6, 8 * 4 - 1) << "; $" << Base::HEX4 << tag.address << " (D)";
-          break;
-        }
-        case CartDebug::NONE:
-        default:
-        {
-          break;
-        }        
-      } // switch
-      buf << "\n";
+        uInt8 added = bank.image.flags[addr] & ~myDebugger.getAccessFlags(0x1000 + addr);
+        if(added)
+          myDebugger.setAccessFlags(0x1000 + addr, added);
+      }
     }
+    cart.lockBank();
   }
 
+  // Return to the state the cart was in before
+  cartState.reset();
+  cart.unlockBank();
+  cart.load(cartState);
+  cart.lockBank();
+
   // Some boilerplate, similar to what DiStella adds
   time_t currtime;
   time(&currtime);
@@ -1200,6 +1337,108 @@ string CartDebug::saveDisassembly()
   return "saved " + node.getShortPath() + " OK";
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CartDebug::disassembleBanks(vector<BankDisassembly>& banks,
+                                 uInt32 first) const
+{
+  // Each thread takes the next bank which hasn't been started yet
+  std::atomic<uInt32> next(first);
+  auto worker = [&] {
+    for(uInt32 b = next++; b < banks.size(); b = next++)
+      disassembleBank(banks[b]);
+  };
+
+  uInt32 threads = std::min(std::max(std::thread::hardware_concurrency(), 1u),
+                            uInt32(banks.size() - first));
+  vector<std::thread> workers;
+  for(uInt32 i = 1; i < threads; ++i)
+    workers.emplace_back(worker);
+
+  // Make the main thread busy too
+  worker();
+  for(auto& t: workers)
+    t.join();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CartDebug::disassembleBank(BankDisassembly& bank) const
+{
+  ostringstream buf;
+  buf << "\n\n;***********************************************************\n"
+      << ";      Bank " << bank.bank;
+  if (myConsole.cartridge().bankCount() > 1)
+    buf << " / 0.." << myConsole.cartridge().bankCount() - 1;
+  buf << "\n;***********************************************************\n\n";
+
+  if(bank.info.addressList.size() > 0)
+  {
+    // Disassemble bank
+    bank.disasm.list.clear();
+    DiStella distella(*this, bank.disasm.list, bank.info, *bank.settings,
+                      bank.labels, bank.directives, bank.reserved, &bank.image);
+
+    buf << "    SEG     CODE\n"
+        << "    ORG     $" << Base::HEX4 << bank.info.offset << "\n\n";
+
+    // Format in 'distella' style
+    for(uInt32 i = 0; i < bank.disasm.list.size(); ++i)
+    {
+      const DisassemblyTag& tag = bank.disasm.list[i];
+
+      // Add label (if any)
+      if(tag.label != "")
+        buf << ALIGN(4) << (tag.label) << "\n";
+      buf << "    ";
+
+      switch(tag.type)
+      {
+        case CartDebug::CODE:
+        {
+          buf << ALIGN(32) << tag.disasm << tag.ccount.substr(0, 5) << tag.ctotal << tag.ccount.substr(5, 2);
+          if (tag.disasm.find("WSYNC") != std::string::npos)
+            buf << "\n;---------------------------------------";
+          break;
+        }
+        case CartDebug::ROW:
+        {
+          buf << ".byte   " << ALIGN(32) << tag.disasm.substr(6, 8*4-1) << "; $" << Base::HEX4 << tag.address << " (*)";
+          break;
+        }
+        case CartDebug::GFX:
+        {
+          buf << ".byte   " << (bank.settings->gfxFormat == Base::F_2 ? "%" : "$")
+              << tag.bytes << " ; |";
+          for(int c = 12; c < 20; ++c)
+            buf << ((tag.disasm[c] == '\x1e') ? "#" : " ");
+          buf << ALIGN(13) << "|" << "$" << Base::HEX4 << tag.address << " (G)";
+          break;
+        }
+        case CartDebug::PGFX:
+        {
+          buf << ".byte   " << (bank.settings->gfxFormat == Base::F_2 ? "%" : "$")
+              << tag.bytes << " ; |";
+          for(int c = 12; c < 20; ++c)
+            buf << ((tag.disasm[c] == '\x1f') ? "*" : " ");
+          buf << ALIGN(13) << "|" << "$" << Base::HEX4 << tag.address << " (P)";
+          break;
+        }
+        case CartDebug::DATA:
+        {          
+          buf << ".byte   " << ALIGN(32) << tag.disasm.substr(6, 8 * 4 - 1) << "; $" << Base::HEX4 << tag.address << " (D)";
+          break;
+        }
+        case CartDebug::NONE:
+        default:
+        {
+          break;
+        }        
+      } // switch
+      buf << "\n";
+    }
+  }
+  bank.output = buf.str();
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 string CartDebug::saveRom()
 {
@@ -323,10 +323,39 @@ class CartDebug : public DebuggerSystem
     };
     ReservedEquates myReserved;
 
+    // A finished disassembly of a bank, along with everything else
+    // DiStella produces for it
+    struct DisassemblyCacheEntry {
+      Disassembly disassembly;
+      std::map<uInt16, int> addrToLine;
+      uInt8 labels[0x1000], directives[0x1000];
+      uInt16 start, end, offset;
+    };
+    using DisassemblyCache = std::map<uInt64, shared_ptr<DisassemblyCacheEntry>>;
+
     // Actually call DiStella to fill the DisassemblyList structure
+    // (or reuse a cached result when nothing it depends on has changed)
     // Return whether the search address was actually in the list
     bool fillDisassemblyList(BankInfo& bankinfo, uInt16 search);
 
+    // Calculate a hash of everything the disassembly of a bank depends on:
+    // its contents and access flags, its entry points and directives,
+    // the user labels and the DiStella settings
+    uInt64 disassemblyKey(const BankInfo& info) const;
+
+    // Answer whether the cached disassembly of the bank already decodes
+    // the given address as code, so that adding it as an entry point
+    // would make no difference
+    bool isCachedCode(const BankInfo& info, uInt16 address) const;
+
+    // A single bank being disassembled by saveDisassembly()
+    struct BankDisassembly;
+
+    // Disassemble and format the given banks (from 'first' onwards)
+    // using as many threads as available
+    void disassembleBanks(vector<BankDisassembly>& banks, uInt32 first) const;
+    void disassembleBank(BankDisassembly& bank) const;
+
     // Analyze of bank of ROM, generating a list of Distella directives
     // based on its disassembly
     void getBankDirectives(ostream& buf, BankInfo& info) const;
@@ -358,6 +387,14 @@ class CartDebug : public DebuggerSystem
     std::map<uInt16, int> myAddrToLineList;
     bool myAddrToLineIsROM;
 
+    // Finished disassemblies, keyed by disassemblyKey(), so that switching
+    // back to a bank doesn't run DiStella again
+    DisassemblyCache myDisassemblyCache;
+    enum { kMaxCachedDisassemblies = 64 };
+
+    // Changed whenever a user label is added or removed
+    uInt32 myLabelGeneration;
+
     // Mappings from label to address (and vice versa) for items
     // defined by the user (either through a DASM symbol file or manually
     // from the commandline in the debugger)
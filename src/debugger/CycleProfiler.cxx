@@ -0,0 +1,321 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2017 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
+#include "Base.hxx"
+#include "Cart.hxx"
+#include "CartDebug.hxx"
+#include "Console.hxx"
+#include "System.hxx"
+#include "TIA.hxx"
+#include "CycleProfiler.hxx"
+
+using Common::Base;
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+CycleProfiler::CycleProfiler(const Console& console)
+  : mySystem(console.system()),
+    myTIA(console.tia()),
+    myCart(console.cartridge()),
+    myPending(nullptr),
+    myPendingStart(0),
+    myPendingHalt(0),
+    myPendingLine(0),
+    myPendingClock(0),
+    myTotalCycles(0),
+    myMaxCycles(0),
+    myStartFrame(0),
+    myStopFrame(0),
+    myIsProfiling(false)
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CycleProfiler::start()
+{
+  myROMCounters.assign(myCart.codeAccessBase() ? myCart.codeAccessSize() : 0,
+                       Counter());
+  myOtherCounters.assign(System::ADDRESS_MASK + 1, Counter());
+  myLineBusy.assign(kMaxScanlines, 0);
+  myLineHalt.assign(kMaxScanlines, 0);
+
+  myPending = nullptr;
+  myTotalCycles = myMaxCycles = 0;
+  myStartFrame = myStopFrame = myTIA.frameCount();
+  myIsProfiling = true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CycleProfiler::stop()
+{
+  if(!myIsProfiling)
+    return;
+
+  creditPending();
+  myStopFrame = myTIA.frameCount();
+  myIsProfiling = false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 CycleProfiler::frames() const
+{
+  return (myIsProfiling ? myTIA.frameCount() : myStopFrame) - myStartFrame;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CycleProfiler::addInstruction(uInt16 pc)
+{
+  creditPending();
+
+  myPending = const_cast<Counter*>(lookup(pc));
+  if(myPending->count++ == 0)
+  {
+    myPending->address = pc;
+    myPending->bank = myCart.getBank();
+  }
+  myPendingStart = mySystem.cycles();
+  myPendingHalt = 0;
+  myTIA.beamPosition(myPendingLine, myPendingClock);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CycleProfiler::creditPending()
+{
+  if(!myPending)
+    return;
+
+  const uInt64 now = mySystem.cycles();
+  if(now >= myPendingStart && now - myPendingStart <= kMaxInstructionCycles)
+  {
+    const uInt64 cycles = now - myPendingStart;
+    const uInt64 halt = std::min(uInt64(myPendingHalt), cycles);
+
+    myPending->cycles += cycles;
+    myPending->haltCycles += halt;
+    myMaxCycles = std::max(myMaxCycles, myPending->cycles);
+    myTotalCycles += cycles;
+
+    // The instruction is executed first, and then the CPU is halted
+    // (the CPU credits a halt before the next instruction is started)
+    uInt32 line = myPendingLine, clock = myPendingClock;
+    creditLines(myLineBusy, line, clock, (cycles - halt) * 3);
+    creditLines(myLineHalt, line, clock, halt * 3);
+  }
+  myPending = nullptr;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CycleProfiler::creditLines(vector<uInt64>& lines, uInt32& line,
+                                uInt32& clock, uInt64 clocks)
+{
+  while(clocks > 0)
+  {
+    const uInt32 n = uInt32(std::min(clocks, uInt64(228 - clock)));
+    lines[std::min(line, kMaxScanlines - 1)] += n;
+    clocks -= n;
+    clock += n;
+    if(clock >= 228)
+    {
+      clock = 0;
+      ++line;
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const CycleProfiler::Counter* CycleProfiler::lookup(uInt16 address) const
+{
+  // The code-access pointer of a page maps the address to the ROM
+  const uInt8* base = myCart.codeAccessBase();
+  const uInt8* access = mySystem.getPageAccess(address).codeAccessBase;
+  if(access && base)
+  {
+    access += address & System::PAGE_MASK;
+    if(access >= base && access < base + myROMCounters.size())
+      return &myROMCounters[access - base];
+  }
+  return &myOtherCounters[address & System::ADDRESS_MASK];
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const CycleProfiler::Counter* CycleProfiler::counter(uInt16 address) const
+{
+  if(myOtherCounters.empty())
+    return nullptr;
+
+  const Counter* c = lookup(address);
+  return c->count > 0 ? c : nullptr;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+vector<const CycleProfiler::Counter*> CycleProfiler::executed() const
+{
+  vector<const Counter*> result;
+  for(const auto& c: myROMCounters)
+    if(c.count > 0)
+      result.push_back(&c);
+  for(const auto& c: myOtherCounters)
+    if(c.count > 0)
+      result.push_back(&c);
+
+  return result;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CycleProfiler::dump(ostream& out, uInt32 count, const CartDebug& dbg) const
+{
+  const uInt32 numFrames = std::max(frames(), 1u);
+  out << std::dec << myTotalCycles << " cycles profiled in " << frames()
+      << " frames (" << (myTotalCycles / numFrames) << " per frame)" << endl;
+  if(myTotalCycles == 0)
+    return;
+
+  // The instructions taking the most time
+  vector<const Counter*> counters = executed();
+  count = std::min(count, uInt32(counters.size()));
+  std::partial_sort(counters.begin(), counters.begin() + count, counters.end(),
+      [](const Counter* a, const Counter* b) { return a->cycles > b->cycles; });
+
+  const std::ios_base::fmtflags flags = out.flags();
+  const std::streamsize precision = out.precision();
+  out << "  bank addr  label               cycles      %   wsync%  executed" << endl;
+  for(uInt32 i = 0; i < count; ++i)
+  {
+    const Counter& c = *counters[i];
+    out << "  " << std::setw(4) << std::setfill(' ') << std::dec << c.bank
+        << " " << Base::HEX4 << c.address << "  "
+        << std::setw(16) << std::setfill(' ') << std::left
+        << dbg.getLabel(c.address, true) << std::right << std::dec
+        << std::setw(11) << c.cycles << " " << std::fixed << std::setprecision(2)
+        << std::setw(6) << (100.0 * c.cycles / myTotalCycles) << " "
+        << std::setw(6) << (c.cycles ? 100.0 * c.haltCycles / c.cycles : 0.0) << " "
+        << std::setw(10) << c.count << endl;
+  }
+  out.flags(flags);
+  out.precision(precision);
+
+  // The scanline with the least time to spare
+  uInt32 busiest = 0;
+  for(uInt32 line = 1; line < kMaxScanlines; ++line)
+    if(myLineBusy[line] > myLineBusy[busiest])
+      busiest = line;
+  out << "busiest scanline: " << std::dec << busiest << ", using "
+      << (myLineBusy[busiest] / 3 / numFrames) << " of 76 cycles per frame"
+      << endl;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CycleProfiler::saveCSV(const string& filename, const CartDebug& dbg) const
+{
+  ofstream out(filename);
+  if(!out.is_open())
+    throw runtime_error("Unable to save profile to " + filename);
+
+  out << "rom offset,bank,address,label,executed,cycles,wsync cycles,percent"
+      << endl;
+  for(const Counter* c: executed())
+  {
+    if(c >= myROMCounters.data() && c < myROMCounters.data() + myROMCounters.size())
+      out << (c - myROMCounters.data());
+    out << "," << c->bank << ",$" << Base::HEX4 << c->address << ","
+        << dbg.getLabel(c->address, true) << "," << std::dec << c->count << ","
+        << c->cycles << "," << c->haltCycles << ","
+        << (myTotalCycles ? 100.0 * c->cycles / myTotalCycles : 0.0) << endl;
+  }
+
+  // The scanlines go into a separate file
+  string::size_type dot = filename.find_last_of('.');
+  string::size_type sep = filename.find_last_of("/\\");
+  string linename = (dot != string::npos && (sep == string::npos || dot > sep))
+      ? filename.substr(0, dot) + "_scanlines" + filename.substr(dot)
+      : filename + "_scanlines";
+  ofstream lines(linename);
+  if(!lines.is_open())
+    throw runtime_error("Unable to save profile to " + linename);
+
+  const double numFrames = std::max(frames(), 1u);
+  uInt32 last = kMaxScanlines;
+  while(last > 0 && myLineBusy[last-1] == 0 && myLineHalt[last-1] == 0)
+    --last;
+
+  lines << "scanline,cycles,wsync cycles,cycles per frame,wsync cycles per frame"
+        << endl;
+  for(uInt32 line = 0; line < last; ++line)
+    lines << line << "," << (myLineBusy[line] / 3) << ","
+          << (myLineHalt[line] / 3) << ","
+          << (myLineBusy[line] / 3.0 / numFrames) << ","
+          << (myLineHalt[line] / 3.0 / numFrames) << endl;
+
+  if(!out || !lines)
+    throw runtime_error("Unable to save profile to " + filename);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CycleProfiler::saveCallgrind(const string& filename,
+                                  const CartDebug& dbg) const
+{
+  ofstream out(filename);
+  if(!out.is_open())
+    throw runtime_error("Unable to save profile to " + filename);
+
+  const vector<const Counter*> counters = executed();
+  uInt64 halt = 0, count = 0;
+  for(const Counter* c: counters)
+  {
+    halt += c->haltCycles;
+    count += c->count;
+  }
+
+  out << "# callgrind format" << endl
+      << "version: 1" << endl
+      << "creator: Stella" << endl
+      << "positions: instr" << endl
+      << "events: Cycles WSYNC Executed" << endl
+      << "summary: " << myTotalCycles << " " << halt << " " << count << endl
+      << endl
+      << "fl=ROM" << endl;
+
+  // Each label starts a new function; instructions before the first
+  // label in a bank are in a function named after the bank
+  string function;
+  uInt32 bank = ~0u;
+  for(const Counter* c: counters)
+  {
+    string label = dbg.getLabel(c->address, true);
+    if(label == "" && c->bank != bank)
+    {
+      ostringstream buf;
+      buf << "bank " << c->bank;
+      label = buf.str();
+    }
+    bank = c->bank;
+    if(label != "" && label != function)
+    {
+      function = label;
+      out << "fn=" << function << endl;
+    }
+    out << "0x" << std::hex << c->address << std::dec << " " << c->cycles
+        << " " << c->haltCycles << " " << c->count << endl;
+  }
+
+  if(!out)
+    throw runtime_error("Unable to save profile to " + filename);
+}
@@ -0,0 +1,166 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2017 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+
+#ifndef CYCLE_PROFILER_HXX
+#define CYCLE_PROFILER_HXX
+
+class Console;
+class CartDebug;
+class Cartridge;
+class System;
+class TIA;
+
+#include "bspf.hxx"
+
+/**
+  This class profiles where the CPU spends its time.  Before each
+  instruction is executed, the cycles taken by the previous instruction
+  (including any time the CPU was halted by a write to WSYNC) are
+  credited to the ROM byte it was executed from.  Using the ROM offset
+  (found through the code-access arrays the cartridges already map into
+  the system) keeps instructions apart which share an address in
+  different banks, whatever the bankswitching scheme.
+
+  The time is also credited to the scanline(s) it was spent on, split
+  into the time spent executing and the time spent halted in WSYNC, which
+  shows how much of the cycle budget of each scanline is actually used.
+
+  The results can be viewed in the debugger disassembly, and saved as CSV
+  files or in the format of Valgrind's callgrind tool (for viewing with
+  KCachegrind and similar tools).
+*/
+class CycleProfiler
+{
+  public:
+    // The time spent on one instruction
+    struct Counter {
+      uInt64 cycles;      // including the time spent halted
+      uInt64 haltCycles;  // time spent halted (in WSYNC)
+      uInt32 count;       // number of times executed
+      uInt16 address;     // the address and bank it was first seen at
+      uInt16 bank;
+    };
+
+    CycleProfiler(const Console& console);
+
+    /**
+      Start or stop profiling; starting discards the previous results.
+    */
+    void start();
+    void stop();
+    bool isProfiling() const { return myIsProfiling; }
+
+    /**
+      Called by the CPU before each instruction is executed, and after
+      it was halted.
+    */
+    void addInstruction(uInt16 pc);
+    void addHalt(uInt32 cycles) { myPendingHalt += cycles; }
+
+    /**
+      Answer the number of cycles and frames profiled.
+    */
+    uInt64 totalCycles() const { return myTotalCycles; }
+    uInt32 frames() const;
+
+    /**
+      Answer the time spent on the instruction at the given address, in
+      the bank currently mapped there, or nullptr if it wasn't executed.
+    */
+    const Counter* counter(uInt16 address) const;
+
+    /**
+      Answer the most cycles spent on a single instruction.
+    */
+    uInt64 maxCycles() const { return myMaxCycles; }
+
+    /**
+      Write a summary, listing the instructions with the most cycles.
+
+      @param out    The stream to write to
+      @param count  The number of instructions to list
+      @param dbg    Supplies the labels to use for addresses
+    */
+    void dump(ostream& out, uInt32 count, const CartDebug& dbg) const;
+
+    /**
+      Save the results as CSV files (the scanlines go to a second file,
+      named like the first one with '_scanlines' appended to its base
+      name), or in callgrind format.
+
+      @return  On failure, a runtime_error is thrown containing a more
+               detailed error message.
+    */
+    void saveCSV(const string& filename, const CartDebug& dbg) const;
+    void saveCallgrind(const string& filename, const CartDebug& dbg) const;
+
+  private:
+    // Credit the pending instruction with the cycles since it started
+    void creditPending();
+
+    // Credit the given number of color clocks to the scanlines, starting
+    // at the given position (which is updated)
+    void creditLines(vector<uInt64>& lines, uInt32& line, uInt32& clock,
+                     uInt64 clocks);
+
+    // Find the counter for the instruction at the given address
+    const Counter* lookup(uInt16 address) const;
+
+    // Answer all instructions executed, in ROM order (followed by those
+    // outside of ROM)
+    vector<const Counter*> executed() const;
+
+  private:
+    // More cycles for one instruction means the state was changed
+    // (eg, by loading a state) between instructions
+    static constexpr uInt32 kMaxInstructionCycles = 1000;
+
+    // Scanlines beyond this are counted as the last one
+    static constexpr uInt32 kMaxScanlines = 512;
+
+    const System& mySystem;
+    const TIA& myTIA;
+    const Cartridge& myCart;
+
+    // One counter for each byte of ROM, and for each address when code
+    // is executed outside of ROM (eg, from RAM)
+    vector<Counter> myROMCounters, myOtherCounters;
+
+    // Color clocks spent executing and halted on each scanline
+    vector<uInt64> myLineBusy, myLineHalt;
+
+    // The instruction being executed, and where and when it was started
+    Counter* myPending;
+    uInt64 myPendingStart;
+    uInt32 myPendingHalt;
+    uInt32 myPendingLine, myPendingClock;
+
+    uInt64 myTotalCycles, myMaxCycles;
+    uInt32 myStartFrame, myStopFrame;
+    bool myIsProfiling;
+
+  private:
+    // Following constructors and assignment operators not supported
+    CycleProfiler() = delete;
+    CycleProfiler(const CycleProfiler&) = delete;
+    CycleProfiler(CycleProfiler&&) = delete;
+    CycleProfiler& operator=(const CycleProfiler&) = delete;
+    CycleProfiler& operator=(CycleProfiler&&) = delete;
+};
+
+#endif
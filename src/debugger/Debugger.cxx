@@ -50,7 +50,12 @@
 
 #include "RomWidget.hxx"
 #include "Expression.hxx"
+#include "ExpressionCode.hxx"
+#include "ExecutionTrace.hxx"
+#include "CycleProfiler.hxx"
+#include "ExecutionHistory.hxx"
 #include "PackedBitArray.hxx"
+#include "TIAWriteLog.hxx"
 #include "YaccParser.hxx"
 
 #include "TIA.hxx"
@@ -127,6 +132,10 @@ Debugger::Debugger(OSystem& osystem, Console& console)
   myCartDebug = make_unique<CartDebug>(*this, myConsole, osystem);
   myRiotDebug = make_unique<RiotDebug>(*this, myConsole);
   myTiaDebug  = make_unique<TIADebug>(*this, myConsole);
+  myTrace     = make_unique<ExecutionTrace>(myConsole);
+  myProfiler  = make_unique<CycleProfiler>(myConsole);
+  myHistory   = make_unique<ExecutionHistory>(myConsole);
+  myTIALog    = make_unique<TIAWriteLog>(myConsole);
 
   // Allow access to this object from any class
   // Technically this violates pure OO programming, but since I know
@@ -151,11 +160,18 @@ void Debugger::initialize()
 
   myOSystem.settings().setValue("dbg.res", GUI::Size(myWidth, myHeight));
 
+  // The dialog itself is created when first needed
   delete myBaseDialog;  myBaseDialog = myDialog = nullptr;
-  myDialog = new DebuggerDialog(myOSystem, *this, 0, 0, myWidth, myHeight);
-  myBaseDialog = myDialog;
+  myCartDebug->setDebugWidget(nullptr);
+}
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Dialog* Debugger::createBaseDialog()
+{
+  myDialog = new DebuggerDialog(myOSystem, *this, 0, 0, myWidth, myHeight);
   myCartDebug->setDebugWidget(&(myDialog->cartDebug()));
+
+  return myDialog;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -177,7 +193,7 @@ bool Debugger::start(const string& message, int address)
     if(address > -1)
       buf << Common::Base::HEX4 << address;
 
-    myDialog->message().setText(buf.str());
+    debuggerDialog().message().setText(buf.str());
     return true;
   }
   return false;
@@ -190,7 +206,7 @@ bool Debugger::startWithFatalError(const string& message)
   {
     // This must be done *after* we enter debug mode,
     // so the dialog is properly shown
-    myDialog->showFatalMessage(message);
+    debuggerDialog().showFatalMessage(message);
     return true;
   }
   return false;
@@ -297,6 +313,9 @@ void Debugger::loadState(int state)
   unlockBankswitchState();
   myOSystem.state().loadState(state);
   lockBankswitchState();
+
+  // The history doesn't lead up to the loaded state
+  myHistory->clear();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -441,6 +460,260 @@ void Debugger::nextFrame(int frames)
   lockBankswitchState();
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool Debugger::runTo(const PackedBitArray* addresses,
+                     const Expression* condition,
+                     const std::function<bool()>& accept, uInt64& cycles)
+{
+  saveOldState("run to");
+  mySystem.clearDirtyPages();
+
+  M6502& cpu = mySystem.m6502();
+  TIA& tia = myOSystem.console().tia();
+  uInt64 startCycle = mySystem.cycles();
+  bool found = false;
+  unique_ptr<ExpressionCode> code;
+  if(condition)
+    code = make_unique<ExpressionCode>(*condition);
+
+  unlockBankswitchState();
+
+  // The current instruction is always executed, so that running to the
+  // current PC runs to its next execution
+  tia.updateScanlineByStep();
+
+  // The CPU checks the stop points itself, so the emulation can run a
+  // frame at a time instead of single stepping; after a fatal error the
+  // CPU doesn't execute anything anymore, so there's no point continuing
+  const uInt32 lastFrame = tia.frameCount() + kRunToFrames;
+  const uInt64 lastCycle = startCycle + kRunToCycles;
+  while(!found && !cpu.fatalError() && tia.frameCount() < lastFrame &&
+        mySystem.cycles() < lastCycle)
+  {
+    cpu.setStopPoints(addresses, code.get());
+    tia.updateByStopPoint();
+    cpu.setStopPoints(nullptr, nullptr);
+
+    if(cpu.hitStopPoint())
+    {
+      found = !accept || accept();
+      if(!found)
+        tia.updateScanlineByStep();  // move past the rejected stop point
+    }
+  }
+
+  lockBankswitchState();
+  tia.flushLineCache();
+
+  cycles = mySystem.cycles() - startCycle;
+  return found;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Debugger::setTracing(bool enable)
+{
+  if(enable)
+    myTrace->start();
+  else
+    myTrace->stop();
+
+  mySystem.m6502().setTrace(enable ? myTrace.get() : nullptr);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string Debugger::saveTrace(const string& filename)
+{
+  if(myTrace->size() == 0)
+    return "No instructions traced";
+
+  string name = filename;
+  if(name == "")
+  {
+    // Traces are never overwritten, since they can't be recreated
+    const string& path = myOSystem.defaultSaveDir() +
+        myConsole.properties().get(Cartridge_Name);
+    name = path + ".a26trace";
+    for(uInt32 i = 1; FilesystemNode(name).exists(); ++i)
+    {
+      ostringstream buf;
+      buf << path << "_" << i << ".a26trace";
+      name = buf.str();
+    }
+  }
+
+  FilesystemNode node(name);
+  try
+  {
+    myTrace->save(node.getPath());
+  }
+  catch(const runtime_error& e)
+  {
+    return e.what();
+  }
+
+  ostringstream buf;
+  buf << "saved " << myTrace->size() << " instructions to "
+      << node.getShortPath();
+  return buf.str();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Debugger::setProfiling(bool enable)
+{
+  if(enable)
+    myProfiler->start();
+  else
+    myProfiler->stop();
+
+  mySystem.m6502().setProfiler(enable ? myProfiler.get() : nullptr);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string Debugger::saveProfile(const string& filename)
+{
+  if(myProfiler->totalCycles() == 0)
+    return "No cycles profiled";
+
+  string name = filename;
+  if(name == "")
+  {
+    const string& path = myOSystem.defaultSaveDir() +
+        myConsole.properties().get(Cartridge_Name) + "_profile";
+    name = path + ".csv";
+    for(uInt32 i = 1; FilesystemNode(name).exists(); ++i)
+    {
+      ostringstream buf;
+      buf << path << "_" << i << ".csv";
+      name = buf.str();
+    }
+  }
+
+  FilesystemNode node(name);
+  try
+  {
+    if(BSPF::containsIgnoreCase(node.getName(), "callgrind"))
+      myProfiler->saveCallgrind(node.getPath(), *myCartDebug);
+    else
+      myProfiler->saveCSV(node.getPath(), *myCartDebug);
+  }
+  catch(const runtime_error& e)
+  {
+    return e.what();
+  }
+
+  return "saved profile to " + node.getShortPath();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Debugger::setTIALogging(bool enable)
+{
+  if(enable)
+    myTIALog->start();
+  else
+    myTIALog->stop();
+
+  myOSystem.console().tia().setWriteLog(enable ? myTIALog.get() : nullptr);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string Debugger::saveTIALog(const string& filename)
+{
+  if(myTIALog->frames() == 0)
+    return "No TIA writes logged";
+
+  string name = filename;
+  if(name == "")
+  {
+    const string& path = myOSystem.defaultSaveDir() +
+        myConsole.properties().get(Cartridge_Name) + "_tialog";
+    name = path + ".csv";
+    for(uInt32 i = 1; FilesystemNode(name).exists(); ++i)
+    {
+      ostringstream buf;
+      buf << path << "_" << i << ".csv";
+      name = buf.str();
+    }
+  }
+
+  FilesystemNode node(name);
+  try
+  {
+    myTIALog->save(node.getPath(), *myCartDebug);
+  }
+  catch(const runtime_error& e)
+  {
+    return e.what();
+  }
+
+  return "saved TIA log to " + node.getShortPath();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Debugger::setHistory(bool enable)
+{
+  if(enable)
+    myHistory->start();
+  else
+    myHistory->stop();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 Debugger::reverseStep(uInt32 count)
+{
+  ostringstream buf;
+  buf << "reverse " << count << " step";
+  if(count > 1)
+    buf << "s";
+
+  uInt32 reversed = 0;
+  reverse(buf.str(), [&]() { reversed = myHistory->reverseStep(count); });
+
+  return reversed;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool Debugger::reverseToWrite(uInt16 address)
+{
+  bool found = false;
+  reverse("reverse to write",
+          [&]() { found = myHistory->reverseToWrite(address); });
+
+  return found;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool Debugger::reverseToScanline(uInt32 scanline)
+{
+  bool found = false;
+  reverse("reverse to scanline",
+          [&]() { found = myHistory->reverseToScanline(scanline); });
+
+  return found;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Debugger::reverse(const string& message, const std::function<void()>& run)
+{
+  saveOldState(message);
+  mySystem.clearDirtyPages();
+
+  // The instructions replayed were already traced, profiled and logged
+  M6502& cpu = mySystem.m6502();
+  TIA& tia = myOSystem.console().tia();
+  cpu.setTrace(nullptr);
+  cpu.setProfiler(nullptr);
+  tia.setWriteLog(nullptr);
+
+  unlockBankswitchState();
+  run();
+  lockBankswitchState();
+
+  cpu.setTrace(isTracing() ? myTrace.get() : nullptr);
+  cpu.setProfiler(isProfiling() ? myProfiler.get() : nullptr);
+  tia.setWriteLog(isTIALogging() ? myTIALog.get() : nullptr);
+  tia.flushLineCache();
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool Debugger::rewindState()
 {
@@ -452,7 +725,7 @@ bool Debugger::rewindState()
   bool result = r.rewindState();
   lockBankswitchState();
 
-  myDialog->rewindButton().setEnabled(!r.empty());
+  debuggerDialog().rewindButton().setEnabled(!r.empty());
 
   return result;
 }
@@ -495,7 +768,10 @@ void Debugger::saveOldState(string rewindMsg)
   {
     RewindManager& r = myOSystem.state().rewindManager();
     r.addState(rewindMsg);
-    myDialog->rewindButton().setEnabled(!r.empty());
+    debuggerDialog().rewindButton().setEnabled(!r.empty());
+
+    // The state may have been changed since the last checkpoint
+    myHistory->addCheckpoint();
   }
 }
 
@@ -509,13 +785,13 @@ void Debugger::setStartState()
   RewindManager& r = myOSystem.state().rewindManager();
   if(myOSystem.state().mode() == StateManager::Mode::Off)
     r.clear();
-  myDialog->rewindButton().setEnabled(!r.empty());
+  debuggerDialog().rewindButton().setEnabled(!r.empty());
 
   // Save initial state, but don't add it to the rewind list
   saveOldState();
 
   // Set the 're-disassemble' flag, but don't do it until the next scheduled time
-  myDialog->rom().invalidate(false);
+  debuggerDialog().rom().invalidate(false);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
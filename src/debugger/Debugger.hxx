@@ -41,6 +41,8 @@ class ButtonWidget;
 #include "Stack.hxx"
 #include "CartDebug.hxx"
 #include "CpuDebug.hxx"
+#include "ExecutionHistory.hxx"
+#include "TIAWriteLog.hxx"
 #include "RiotDebug.hxx"
 #include "TIADebug.hxx"
 #include "bspf.hxx"
@@ -115,7 +117,7 @@ class Debugger : public DialogContainer
     /**
       The dialog/GUI associated with the debugger
     */
-    Dialog& dialog() const { return *myDialog; }
+    Dialog& dialog() const { return debuggerDialog(); }
 
     /**
       The debugger subsystem responsible for all CPU state
@@ -137,12 +139,22 @@ class Debugger : public DialogContainer
     */
     TIADebug& tiaDebug() const { return *myTiaDebug; }
 
-    const GUI::Font& lfont() const      { return myDialog->lfont();     }
-    const GUI::Font& nlfont() const     { return myDialog->nfont();     }
-    DebuggerParser& parser() const      { return *myParser;             }
-    PromptWidget& prompt() const        { return myDialog->prompt();    }
-    RomWidget& rom() const              { return myDialog->rom();       }
-    TiaOutputWidget& tiaOutput() const  { return myDialog->tiaOutput(); }
+    /**
+      The profiler for the time taken by each instruction
+    */
+    CycleProfiler& cycleProfiler() const { return *myProfiler; }
+
+    /**
+      The log of TIA register writes
+    */
+    TIAWriteLog& tiaWriteLog() const { return *myTIALog; }
+
+    const GUI::Font& lfont() const      { return debuggerDialog().lfont();     }
+    const GUI::Font& nlfont() const     { return debuggerDialog().nfont();     }
+    DebuggerParser& parser() const      { return *myParser;                    }
+    PromptWidget& prompt() const        { return debuggerDialog().prompt();    }
+    RomWidget& rom() const              { return debuggerDialog().rom();       }
+    TiaOutputWidget& tiaOutput() const  { return debuggerDialog().tiaOutput(); }
 
     PackedBitArray& breakPoints() const { return mySystem.m6502().breakPoints(); }
     PackedBitArray& readTraps() const   { return mySystem.m6502().readTraps();   }
@@ -253,6 +265,100 @@ class Debugger : public DialogContainer
     void nextFrame(int frames);
     bool rewindState();
 
+    /**
+      Run the emulation at full speed until the CPU is about to execute an
+      instruction at one of the given addresses, or the condition becomes
+      true.  At least one instruction is always executed, and only one
+      state is added to the rewind list.
+
+      @param addresses  The addresses to stop at, or nullptr for none
+      @param condition  The condition to stop at, or nullptr for none
+      @param accept     Decides whether to stop at a stop point which was
+                        hit (eg, for an address in another bank), or
+                        nullptr to always stop
+      @param cycles     Receives the number of cycles run
+
+      @return  True if a stop point was reached, false if it wasn't
+               reached within kRunToFrames frames (or kRunToCycles
+               cycles), or if the CPU stopped with a fatal error
+    */
+    bool runTo(const PackedBitArray* addresses, const Expression* condition,
+               const std::function<bool()>& accept, uInt64& cycles);
+
+    // Maximum number of frames run by runTo(), and the maximum number of
+    // cycles in case the ROM doesn't generate frames (400 lines each)
+    static constexpr uInt32 kRunToFrames = 100;
+    static constexpr uInt64 kRunToCycles = kRunToFrames * 400 * 76;
+
+    /**
+      Start or stop recording every instruction executed by the CPU
+      (see ExecutionTrace).  Starting discards the previous recording.
+    */
+    void setTracing(bool enable);
+    bool isTracing() const { return myTrace->isRecording(); }
+    ExecutionTrace& executionTrace() const { return *myTrace; }
+
+    /**
+      Save the recorded instructions to the given file, or to a new file
+      named after the ROM (in the default save location) if no filename
+      is given.
+
+      @return  A message describing the result
+    */
+    string saveTrace(const string& filename = "");
+
+    /**
+      Start or stop profiling the time taken by each instruction (see
+      CycleProfiler).  Starting discards the previous results.
+    */
+    void setProfiling(bool enable);
+    bool isProfiling() const { return myProfiler->isProfiling(); }
+
+    /**
+      Save the profiling results to the given file, or to a new file named
+      after the ROM (in the default save location) if no filename is given.
+      Files with 'callgrind' in their name are saved in callgrind format,
+      all others as CSV.
+
+      @return  A message describing the result
+    */
+    string saveProfile(const string& filename = "");
+
+    /**
+      Start or stop logging every write to the TIA registers (see
+      TIAWriteLog).  Starting discards the previous log.
+    */
+    void setTIALogging(bool enable);
+    bool isTIALogging() const { return myTIALog->isRecording(); }
+
+    /**
+      Save the TIA write log as a CSV file, to the given file or to a new
+      file named after the ROM (in the default save location) if no
+      filename is given.
+
+      @return  A message describing the result
+    */
+    string saveTIALog(const string& filename = "");
+
+    /**
+      Start or stop recording the checkpoints and inputs needed to run
+      the emulation backwards (see ExecutionHistory).  Starting discards
+      the previous history.
+    */
+    void setHistory(bool enable);
+    bool isRecordingHistory() const { return myHistory->isRecording(); }
+    ExecutionHistory& executionHistory() const { return *myHistory; }
+
+    /**
+      Reverse the emulation by the given number of instructions, to the
+      last instruction which wrote to the given address, or to the last
+      visit to the given scanline.  Only one state is added to the rewind
+      list, so the reversal can be undone.
+    */
+    uInt32 reverseStep(uInt32 count);
+    bool reverseToWrite(uInt16 address);
+    bool reverseToScanline(uInt32 scanline);
+
     void toggleBreakPoint(uInt16 bp);
 
     bool breakPoint(uInt16 bp);
@@ -272,6 +378,20 @@ class Debugger : public DialogContainer
     void saveState(int state);
     void loadState(int state);
 
+  protected:
+    /**
+      Create the debugger dialog; this is only done when the debugger
+      is first entered (or the dialog is otherwise needed).
+    */
+    Dialog* createBaseDialog() override;
+
+  private:
+    DebuggerDialog& debuggerDialog() const { baseDialog(); return *myDialog; }
+
+    // Run the given reversal of the emulation (see reverseStep), with
+    // tracing and profiling suspended
+    void reverse(const string& message, const std::function<void()>& run);
+
   private:
     Console& myConsole;
     System&  mySystem;
@@ -282,6 +402,10 @@ class Debugger : public DialogContainer
     unique_ptr<CpuDebug>       myCpuDebug;
     unique_ptr<RiotDebug>      myRiotDebug;
     unique_ptr<TIADebug>       myTiaDebug;
+    unique_ptr<ExecutionTrace> myTrace;
+    unique_ptr<CycleProfiler>  myProfiler;
+    unique_ptr<ExecutionHistory> myHistory;
+    unique_ptr<TIAWriteLog>    myTIALog;
 
     static Debugger* myStaticDebugger;
 
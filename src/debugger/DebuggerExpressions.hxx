@@ -18,14 +18,13 @@
 #ifndef DEBUGGER_EXPRESSIONS_HXX
 #define DEBUGGER_EXPRESSIONS_HXX
 
-#include <functional>
-
 #include "bspf.hxx"
 #include "CartDebug.hxx"
 #include "CpuDebug.hxx"
 #include "TIADebug.hxx"
 #include "Debugger.hxx"
 #include "Expression.hxx"
+#include "ExpressionCode.hxx"
 
 /**
   All expressions currently supported by the debugger.
@@ -39,6 +38,8 @@ class BinAndExpression : public Expression
     BinAndExpression(Expression* left, Expression* right) : Expression(left, right) { }
     Int32 evaluate() const override
       { return myLHS->evaluate() & myRHS->evaluate(); }
+    void compile(ExpressionCode& code) const override
+      { code.emitBinary(ExpressionCode::kBinAnd, *myLHS, *myRHS); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -48,6 +49,8 @@ class BinNotExpression : public Expression
     BinNotExpression(Expression* left) : Expression(left) { }
     Int32 evaluate() const override
       { return ~(myLHS->evaluate()); }
+    void compile(ExpressionCode& code) const override
+      { code.emitUnary(ExpressionCode::kBinNot, *myLHS); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -57,6 +60,8 @@ class BinOrExpression : public Expression
     BinOrExpression(Expression* left, Expression* right) : Expression(left, right) { }
     Int32 evaluate() const override
       { return myLHS->evaluate() | myRHS->evaluate(); }
+    void compile(ExpressionCode& code) const override
+      { code.emitBinary(ExpressionCode::kBinOr, *myLHS, *myRHS); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -66,6 +71,8 @@ class BinXorExpression : public Expression
     BinXorExpression(Expression* left, Expression* right) : Expression(left, right) { }
     Int32 evaluate() const override
       { return myLHS->evaluate() ^ myRHS->evaluate(); }
+    void compile(ExpressionCode& code) const override
+      { code.emitBinary(ExpressionCode::kBinXor, *myLHS, *myRHS); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -75,6 +82,8 @@ class ByteDerefExpression : public Expression
     ByteDerefExpression(Expression* left): Expression(left) { }
     Int32 evaluate() const override
       { return Debugger::debugger().peek(myLHS->evaluate()); }
+    void compile(ExpressionCode& code) const override
+      { code.emitUnary(ExpressionCode::kByteDeref, *myLHS); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -84,6 +93,8 @@ class ByteDerefOffsetExpression : public Expression
     ByteDerefOffsetExpression(Expression* left, Expression* right) : Expression(left, right) { }
     Int32 evaluate() const override
       { return Debugger::debugger().peek(myLHS->evaluate() + myRHS->evaluate()); }
+    void compile(ExpressionCode& code) const override
+      { code.emitBinary(ExpressionCode::kByteDerefOffset, *myLHS, *myRHS); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -93,6 +104,8 @@ class ConstExpression : public Expression
     ConstExpression(const int value) : Expression(), myValue(value) { }
     Int32 evaluate() const override
       { return myValue; }
+    void compile(ExpressionCode& code) const override
+      { code.emitConst(myValue); }
 
   private:
     int myValue;
@@ -102,12 +115,14 @@ class ConstExpression : public Expression
 class CpuMethodExpression : public Expression
 {
   public:
-    CpuMethodExpression(CpuMethod method) : Expression(), myMethod(std::mem_fn(method)) { }
+    CpuMethodExpression(CpuMethod method) : Expression(), myMethod(method) { }
     Int32 evaluate() const override
-      { return myMethod(Debugger::debugger().cpuDebug()); }
+      { return (Debugger::debugger().cpuDebug().*myMethod)(); }
+    void compile(ExpressionCode& code) const override
+      { code.emitCpu(myMethod); }
 
   private:
-    std::function<int(const CpuDebug&)> myMethod;
+    CpuMethod myMethod;
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -118,6 +133,8 @@ class DivExpression : public Expression
     Int32 evaluate() const override
       { int denom = myRHS->evaluate();
         return denom == 0 ? 0 : myLHS->evaluate() / denom; }
+    void compile(ExpressionCode& code) const override
+      { code.emitBinary(ExpressionCode::kDiv, *myLHS, *myRHS); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -127,6 +144,8 @@ class EqualsExpression : public Expression
     EqualsExpression(Expression* left, Expression* right) : Expression(left, right) { }
     Int32 evaluate() const override
       { return myLHS->evaluate() == myRHS->evaluate(); }
+    void compile(ExpressionCode& code) const override
+      { code.emitBinary(ExpressionCode::kEquals, *myLHS, *myRHS); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -160,6 +179,8 @@ class GreaterEqualsExpression : public Expression
     GreaterEqualsExpression(Expression* left, Expression* right) : Expression(left, right) { }
     Int32 evaluate() const override
       { return myLHS->evaluate() >= myRHS->evaluate(); }
+    void compile(ExpressionCode& code) const override
+      { code.emitBinary(ExpressionCode::kGreaterEquals, *myLHS, *myRHS); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -169,6 +190,8 @@ class GreaterExpression : public Expression
     GreaterExpression(Expression* left, Expression* right) : Expression(left, right) { }
     Int32 evaluate() const override
       { return myLHS->evaluate() > myRHS->evaluate(); }
+    void compile(ExpressionCode& code) const override
+      { code.emitBinary(ExpressionCode::kGreater, *myLHS, *myRHS); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -178,6 +201,8 @@ class HiByteExpression : public Expression
     HiByteExpression(Expression* left) : Expression(left) { }
     Int32 evaluate() const override
       { return 0xff & (myLHS->evaluate() >> 8); }
+    void compile(ExpressionCode& code) const override
+      { code.emitUnary(ExpressionCode::kHiByte, *myLHS); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -187,6 +212,8 @@ class LessEqualsExpression : public Expression
     LessEqualsExpression(Expression* left, Expression* right) : Expression(left, right) { }
     Int32 evaluate() const override
       { return myLHS->evaluate() <= myRHS->evaluate(); }
+    void compile(ExpressionCode& code) const override
+      { code.emitBinary(ExpressionCode::kLessEquals, *myLHS, *myRHS); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -196,6 +223,8 @@ class LessExpression : public Expression
     LessExpression(Expression* left, Expression* right) : Expression(left, right) { }
     Int32 evaluate() const override
       { return myLHS->evaluate() < myRHS->evaluate(); }
+    void compile(ExpressionCode& code) const override
+      { code.emitBinary(ExpressionCode::kLess, *myLHS, *myRHS); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -205,6 +234,8 @@ class LoByteExpression : public Expression
     LoByteExpression(Expression* left) : Expression(left) { }
     Int32 evaluate() const override
       { return 0xff & myLHS->evaluate(); }
+    void compile(ExpressionCode& code) const override
+      { code.emitUnary(ExpressionCode::kLoByte, *myLHS); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -214,6 +245,8 @@ class LogAndExpression : public Expression
     LogAndExpression(Expression* left, Expression* right) : Expression(left, right) { }
     Int32 evaluate() const override
       { return myLHS->evaluate() && myRHS->evaluate(); }
+    void compile(ExpressionCode& code) const override
+      { code.emitLogical(ExpressionCode::kLogAnd, *myLHS, *myRHS); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -223,6 +256,8 @@ class LogNotExpression : public Expression
     LogNotExpression(Expression* left) : Expression(left) { }
     Int32 evaluate() const override
       { return !(myLHS->evaluate()); }
+    void compile(ExpressionCode& code) const override
+      { code.emitUnary(ExpressionCode::kLogNot, *myLHS); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -232,6 +267,8 @@ class LogOrExpression : public Expression
     LogOrExpression(Expression* left, Expression* right) : Expression(left, right) { }
     Int32 evaluate() const override
       { return myLHS->evaluate() || myRHS->evaluate(); }
+    void compile(ExpressionCode& code) const override
+      { code.emitLogical(ExpressionCode::kLogOr, *myLHS, *myRHS); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -241,6 +278,8 @@ class MinusExpression : public Expression
     MinusExpression(Expression* left, Expression* right) : Expression(left, right) { }
     Int32 evaluate() const override
       { return myLHS->evaluate() - myRHS->evaluate(); }
+    void compile(ExpressionCode& code) const override
+      { code.emitBinary(ExpressionCode::kMinus, *myLHS, *myRHS); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -251,6 +290,8 @@ class ModExpression : public Expression
     Int32 evaluate() const override
       { int rhs = myRHS->evaluate();
         return rhs == 0 ? 0 : myLHS->evaluate() % rhs; }
+    void compile(ExpressionCode& code) const override
+      { code.emitBinary(ExpressionCode::kMod, *myLHS, *myRHS); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -260,6 +301,8 @@ class MultExpression : public Expression
     MultExpression(Expression* left, Expression* right) : Expression(left, right) { }
     Int32 evaluate() const override
       { return myLHS->evaluate() * myRHS->evaluate(); }
+    void compile(ExpressionCode& code) const override
+      { code.emitBinary(ExpressionCode::kMult, *myLHS, *myRHS); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -269,6 +312,8 @@ class NotEqualsExpression : public Expression
     NotEqualsExpression(Expression* left, Expression* right) : Expression(left, right) { }
     Int32 evaluate() const override
       { return myLHS->evaluate() != myRHS->evaluate(); }
+    void compile(ExpressionCode& code) const override
+      { code.emitBinary(ExpressionCode::kNotEquals, *myLHS, *myRHS); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -278,18 +323,22 @@ class PlusExpression : public Expression
     PlusExpression(Expression* left, Expression* right) : Expression(left, right) { }
     Int32 evaluate() const override
       { return myLHS->evaluate() + myRHS->evaluate(); }
+    void compile(ExpressionCode& code) const override
+      { code.emitBinary(ExpressionCode::kPlus, *myLHS, *myRHS); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 class CartMethodExpression : public Expression
 {
   public:
-    CartMethodExpression(CartMethod method) : Expression(), myMethod(std::mem_fn(method)) { }
+    CartMethodExpression(CartMethod method) : Expression(), myMethod(method) { }
     Int32 evaluate() const override
-      { return myMethod(Debugger::debugger().cartDebug()); }
+      { return (Debugger::debugger().cartDebug().*myMethod)(); }
+    void compile(ExpressionCode& code) const override
+      { code.emitCart(myMethod); }
 
   private:
-    std::function<int(CartDebug&)> myMethod;
+    CartMethod myMethod;
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -299,6 +348,8 @@ class ShiftLeftExpression : public Expression
     ShiftLeftExpression(Expression* left, Expression* right) : Expression(left, right) { }
     Int32 evaluate() const override
       { return myLHS->evaluate() << myRHS->evaluate(); }
+    void compile(ExpressionCode& code) const override
+      { code.emitBinary(ExpressionCode::kShiftLeft, *myLHS, *myRHS); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -308,18 +359,22 @@ class ShiftRightExpression : public Expression
     ShiftRightExpression(Expression* left, Expression* right) : Expression(left, right) { }
     Int32 evaluate() const override
       { return myLHS->evaluate() >> myRHS->evaluate(); }
+    void compile(ExpressionCode& code) const override
+      { code.emitBinary(ExpressionCode::kShiftRight, *myLHS, *myRHS); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 class TiaMethodExpression : public Expression
 {
   public:
-    TiaMethodExpression(TiaMethod method) : Expression(), myMethod(std::mem_fn(method)) { }
+    TiaMethodExpression(TiaMethod method) : Expression(), myMethod(method) { }
     Int32 evaluate() const override
-      { return myMethod(Debugger::debugger().tiaDebug()); }
+      { return (Debugger::debugger().tiaDebug().*myMethod)(); }
+    void compile(ExpressionCode& code) const override
+      { code.emitTia(myMethod); }
 
   private:
-    std::function<int(const TIADebug&)> myMethod;
+    TiaMethod myMethod;
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -329,6 +384,8 @@ class UnaryMinusExpression : public Expression
     UnaryMinusExpression(Expression* left) : Expression(left) { }
     Int32 evaluate() const override
       { return -(myLHS->evaluate()); }
+    void compile(ExpressionCode& code) const override
+      { code.emitUnary(ExpressionCode::kUnaryMinus, *myLHS); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -338,6 +395,8 @@ class WordDerefExpression : public Expression
     WordDerefExpression(Expression* left) : Expression(left) { }
     Int32 evaluate() const override
       { return Debugger::debugger().dpeek(myLHS->evaluate()); }
+    void compile(ExpressionCode& code) const override
+      { code.emitUnary(ExpressionCode::kWordDeref, *myLHS); }
 };
 
 #endif
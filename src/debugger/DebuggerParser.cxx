@@ -20,6 +20,7 @@
 
 #include "Dialog.hxx"
 #include "Debugger.hxx"
+#include "DebuggerDialog.hxx"
 #include "CartDebug.hxx"
 #include "CpuDebug.hxx"
 #include "RiotDebug.hxx"
@@ -29,10 +30,11 @@
 #include "YaccParser.hxx"
 #include "M6502.hxx"
 #include "Expression.hxx"
+#include "ExecutionTrace.hxx"
+#include "CycleProfiler.hxx"
 #include "FSNode.hxx"
 #include "PromptWidget.hxx"
 #include "RomWidget.hxx"
-#include "ProgressDialog.hxx"
 #include "PackedBitArray.hxx"
 #include "Vec.hxx"
 
@@ -112,8 +114,10 @@ string DebuggerParser::run(const string& command)
       if(validateArgs(i))
         commands[i].executor(this);
 
+      // The widgets are reloaded before they're next drawn, so a batch of
+      // commands (ie, from a script) refreshes them only once
       if(commands[i].refreshRequired)
-        debugger.myBaseDialog->loadConfig();
+        debugger.debuggerDialog().requestRefresh();
 
       return commandResult.str();
     }
@@ -533,6 +537,28 @@ string DebuggerParser::eval()
   return buf.str();
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void DebuggerParser::setStopAddress(PackedBitArray& addresses, uInt16 addr)
+{
+  // The CPU only uses 13 address lines, so the upper three are ignored
+  for(uInt32 mirror = addr & 0x1fff; mirror <= 0xffff; mirror += 0x2000)
+    addresses.set(mirror);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string DebuggerParser::runToFailure(uInt64 cycles) const
+{
+  ostringstream buf;
+  if(debugger.cpuDebug().m6502().fatalError())
+    buf << " (stopped by a fatal CPU error)";
+  else if(cycles >= Debugger::kRunToCycles)
+    buf << " (" << Debugger::kRunToCycles << " cycles)";
+  else
+    buf << " (" << Debugger::kRunToFrames << " frames)";
+
+  return buf.str();
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 string DebuggerParser::trapStatus(uInt32 addr, bool& enabled)
 {
@@ -1027,6 +1053,17 @@ void DebuggerParser::executeHelp()
   }
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// "history"
+void DebuggerParser::executeHistory()
+{
+  debugger.setHistory(!debugger.isRecordingHistory());
+  if(debugger.isRecordingHistory())
+    commandResult << "execution history enabled";
+  else
+    commandResult << "execution history disabled";
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // "jump"
 void DebuggerParser::executeJump()
@@ -1198,6 +1235,35 @@ void DebuggerParser::executePrint()
   commandResult << eval();
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// "profile"
+void DebuggerParser::executeProfile()
+{
+  debugger.setProfiling(!debugger.isProfiling());
+  if(debugger.isProfiling())
+    commandResult << "cycle profiling enabled";
+  else
+  {
+    commandResult << "cycle profiling disabled, ";
+    debugger.cycleProfiler().dump(commandResult, 10, debugger.cartDebug());
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// "profiledump"
+void DebuggerParser::executeProfiledump()
+{
+  debugger.cycleProfiler().dump(commandResult, argCount > 0 ? args[0] : 20,
+                                debugger.cartDebug());
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// "profilesave"
+void DebuggerParser::executeProfilesave()
+{
+  commandResult << debugger.saveProfile(argCount > 0 ? argStrings[0] : "");
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // "ram"
 void DebuggerParser::executeRam()
@@ -1251,8 +1317,8 @@ void DebuggerParser::executeRom()
     }
   }
 
-  // Normally the run() method calls loadConfig() on the debugger,
-  // which results in all child widgets being redrawn.
+  // Normally the run() method has the debugger reload all its widgets,
+  // which results in all changed child widgets being redrawn.
   // The RomWidget is a special case, since we don't want to re-disassemble
   // any more than necessary.  So we only do it by calling the following
   // method ...
@@ -1283,6 +1349,39 @@ void DebuggerParser::executeRow()
   debugger.rom().invalidate();
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// "rscanline"
+void DebuggerParser::executeRscanline()
+{
+  if(!debugger.isRecordingHistory())
+  {
+    commandResult << red("execution history not enabled (see history)");
+    return;
+  }
+
+  if(debugger.reverseToScanline(args[0]))
+    commandResult << "reversed to scanline " << dec << args[0];
+  else
+    commandResult << "scanline " << dec << args[0] << " not found in history";
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// "rstep"
+void DebuggerParser::executeRstep()
+{
+  if(!debugger.isRecordingHistory())
+  {
+    commandResult << red("execution history not enabled (see history)");
+    return;
+  }
+
+  uInt32 count = argCount > 0 ? args[0] : 1;
+  uInt32 reversed = debugger.reverseStep(count);
+  commandResult << "reversed " << dec << reversed << " instruction(s)";
+  if(reversed < count)
+    commandResult << ", reached start of history";
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // "run"
 void DebuggerParser::executeRun()
@@ -1299,67 +1398,85 @@ void DebuggerParser::executeRunTo()
   const CartDebug& cartdbg = debugger.cartDebug();
   const CartDebug::DisassemblyList& list = cartdbg.disassembly().list;
 
-  uInt32 count = 0, max_iterations = uInt32(list.size());
-
-  // Create a progress dialog box to show the progress searching through the
-  // disassembly, since this may be a time-consuming operation
-  ostringstream buf;
-  buf << "RunTo searching through " << max_iterations << " disassembled instructions";
-  ProgressDialog progress(debugger.myBaseDialog, debugger.lfont(), buf.str());
-  progress.setRange(0, max_iterations, 5);
-
-  bool done = false;
-  do {
-    debugger.step();
+  // Only the addresses of lines containing the string can match, so the
+  // emulation only has to stop there
+  PackedBitArray addresses;
+  for(const auto& line: list)
+    if(line.address != 0 &&
+       BSPF::findIgnoreCase(line.disasm, argStrings[0]) != string::npos)
+      setStopAddress(addresses, line.address);
 
-    // Update romlist to point to current PC
+  // The same address in another bank may contain something else
+  const auto matches = [&]() {
     int pcline = cartdbg.addressToLine(debugger.cpuDebug().pc());
-    if(pcline >= 0)
-    {
-      const string& next = list[pcline].disasm;
-      done = (BSPF::findIgnoreCase(next, argStrings[0]) != string::npos);
-    }
-    // Update the progress bar
-    progress.setProgress(count);
-  } while(!done && ++count < max_iterations);
-
-  progress.close();
+    return pcline >= 0 &&
+           BSPF::findIgnoreCase(list[pcline].disasm, argStrings[0]) != string::npos;
+  };
 
-  if(done)
+  uInt64 cycles = 0;
+  if(debugger.runTo(&addresses, nullptr, matches, cycles))
     commandResult
-      << "found " << argStrings[0] << " in " << dec << count
-      << " disassembled instructions";
+      << "found " << argStrings[0] << " after " << dec << cycles << " cycles";
   else
     commandResult
-      << argStrings[0] << " not found in " << dec << count
-      << " disassembled instructions";
+      << argStrings[0] << " not found in " << dec << cycles << " cycles"
+      << runToFailure(cycles);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // "runtopc"
 void DebuggerParser::executeRunToPc()
 {
-  const CartDebug& cartdbg = debugger.cartDebug();
-  const CartDebug::DisassemblyList& list = cartdbg.disassembly().list;
+  PackedBitArray addresses;
+  setStopAddress(addresses, args[0]);
 
-  uInt32 count = 0;
-  bool done = false;
-  do {
-    debugger.step();
+  uInt64 cycles = 0;
+  if(debugger.runTo(&addresses, nullptr, nullptr, cycles))
+    commandResult
+      << "set PC to " << Base::HEX4 << args[0] << " after "
+      << dec << cycles << " cycles";
+  else
+    commandResult
+      << "PC " << Base::HEX4 << args[0] << " not reached in "
+      << dec << cycles << " cycles" << runToFailure(cycles);
+}
 
-    // Update romlist to point to current PC
-    int pcline = cartdbg.addressToLine(debugger.cpuDebug().pc());
-    done = (pcline >= 0) && (list[pcline].address == args[0]);
-  } while(!done && ++count < list.size());
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// "rununtil"
+void DebuggerParser::executeRunUntil()
+{
+  if(YaccParser::parse(argStrings[0].c_str()) != 0)
+  {
+    commandResult << red("invalid expression");
+    return;
+  }
+  unique_ptr<Expression> condition(YaccParser::getResult());
 
-  if(done)
+  uInt64 cycles = 0;
+  if(debugger.runTo(nullptr, condition.get(), nullptr, cycles))
     commandResult
-      << "set PC to " << Base::HEX4 << args[0] << " in "
-      << dec << count << " disassembled instructions";
+      << argStrings[0] << " is true after " << dec << cycles << " cycles";
   else
     commandResult
-      << "PC " << Base::HEX4 << args[0] << " not reached or found in "
-      << dec << count << " disassembled instructions";
+      << argStrings[0] << " not true in " << dec << cycles << " cycles"
+      << runToFailure(cycles);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// "rwrite"
+void DebuggerParser::executeRwrite()
+{
+  if(!debugger.isRecordingHistory())
+  {
+    commandResult << red("execution history not enabled (see history)");
+    return;
+  }
+
+  const string& label = debugger.cartDebug().getLabel(args[0], false, 4);
+  if(debugger.reverseToWrite(args[0]))
+    commandResult << "reversed to write to " << label;
+  else
+    commandResult << "no write to " << label << " found in history";
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -1462,6 +1579,37 @@ void DebuggerParser::executeTia()
   commandResult << debugger.tiaDebug().toString();
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// "tialog"
+void DebuggerParser::executeTialog()
+{
+  debugger.setTIALogging(!debugger.isTIALogging());
+  if(debugger.isTIALogging())
+    commandResult << "TIA write logging enabled";
+  else
+    commandResult << "TIA write logging disabled";
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// "tialogdump"
+void DebuggerParser::executeTialogdump()
+{
+  const TIAWriteLog& log = debugger.tiaWriteLog();
+  if(log.frames() == 0)
+  {
+    commandResult << "no TIA writes logged";
+    return;
+  }
+  log.dump(commandResult, argCount > 0 ? args[0] : 20, debugger.cartDebug());
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// "tialogsave"
+void DebuggerParser::executeTialogsave()
+{
+  commandResult << debugger.saveTIALog(argCount > 0 ? argStrings[0] : "");
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // "trace"
 void DebuggerParser::executeTrace()
@@ -1469,6 +1617,70 @@ void DebuggerParser::executeTrace()
   commandResult << "executed " << dec << debugger.trace() << " cycles";
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// "tracedecode"
+void DebuggerParser::executeTracedecode()
+{
+  ExecutionTrace& trace = debugger.executionTrace();
+  FilesystemNode node(argStrings[0]);
+
+  // The loaded trace replaces the one being recorded
+  debugger.setTracing(false);
+  try
+  {
+    trace.load(node.getPath());
+  }
+  catch(const runtime_error& e)
+  {
+    commandResult << red(e.what());
+    return;
+  }
+
+  FilesystemNode txt(node.getPath() + ".txt");
+  ofstream out(txt.getPath());
+  if(!out.is_open())
+  {
+    commandResult << red("Unable to save decoded trace to " + txt.getShortPath());
+    return;
+  }
+  trace.decode(out, 0, trace.size(), debugger.cartDebug());
+  commandResult << "decoded " << dec << trace.size() << " instructions to "
+                << txt.getShortPath();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// "tracedump"
+void DebuggerParser::executeTracedump()
+{
+  const ExecutionTrace& trace = debugger.executionTrace();
+  uInt32 count = std::min(argCount > 0 ? uInt32(args[0]) : 20u, trace.size());
+  if(count == 0)
+  {
+    commandResult << "no instructions traced";
+    return;
+  }
+  trace.decode(commandResult, trace.size() - count, count, debugger.cartDebug());
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// "tracelog"
+void DebuggerParser::executeTracelog()
+{
+  debugger.setTracing(!debugger.isTracing());
+  if(debugger.isTracing())
+    commandResult << "instruction tracing enabled";
+  else
+    commandResult << "instruction tracing disabled, " << dec
+                  << debugger.executionTrace().size() << " instructions traced";
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// "tracesave"
+void DebuggerParser::executeTracesave()
+{
+  commandResult << debugger.saveTrace(argCount > 0 ? argStrings[0] : "");
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // "trap"
 void DebuggerParser::executeTrap()
@@ -1977,6 +2189,18 @@ DebuggerParser::Command DebuggerParser::commands[kNumCommands] = {
     std::mem_fn(&DebuggerParser::executeHelp)
   },
 
+  {
+    "history",
+    "Toggle recording of execution history, for rstep/rwrite/rscanline",
+    "Keeps checkpoints and inputs for the last 40 seconds or so, so the\n"
+    "emulation can be run backwards\n"
+    "Example: history",
+    false,
+    false,
+    { kARG_END_ARGS },
+    std::mem_fn(&DebuggerParser::executeHistory)
+  },
+
   {
     "jump",
     "Scroll disassembly to address xx",
@@ -2098,6 +2322,41 @@ DebuggerParser::Command DebuggerParser::commands[kNumCommands] = {
     std::mem_fn(&DebuggerParser::executePrint)
   },
 
+  {
+    "profile",
+    "Toggle profiling of the cycles taken by each instruction",
+    "Cycles (including WSYNC) are credited to each address and bank, and to\n"
+    "each scanline; the disassembly shows the results as bars\n"
+    "Example: profile",
+    false,
+    true,
+    { kARG_END_ARGS },
+    std::mem_fn(&DebuggerParser::executeProfile)
+  },
+
+  {
+    "profiledump",
+    "Show the [xx] instructions taking the most cycles",
+    "Example: profiledump, profiledump #50",
+    false,
+    false,
+    { kARG_WORD, kARG_END_ARGS },
+    std::mem_fn(&DebuggerParser::executeProfiledump)
+  },
+
+  {
+    "profilesave",
+    "Save cycle profile [to file xx]",
+    "Saves as CSV (scanlines in a second file), or in callgrind format\n"
+    "if the filename contains 'callgrind'\n"
+    "Example: profilesave, profilesave callgrind.out.game\n"
+    "NOTE: saves to default save location without filename",
+    false,
+    false,
+    { kARG_FILE, kARG_END_ARGS },
+    std::mem_fn(&DebuggerParser::executeProfilesave)
+  },
+
   {
     "ram",
     "Show ZP RAM, or set address xx to yy1 [yy2 ...]",
@@ -2159,6 +2418,27 @@ DebuggerParser::Command DebuggerParser::commands[kNumCommands] = {
     std::mem_fn(&DebuggerParser::executeRow)
   },
 
+  {
+    "rscanline",
+    "Reverse to the start of scanline xx",
+    "Goes back to the last time the beam entered the scanline\n"
+    "Requires history, Example: rscanline #100",
+    true,
+    true,
+    { kARG_WORD, kARG_END_ARGS },
+    std::mem_fn(&DebuggerParser::executeRscanline)
+  },
+
+  {
+    "rstep",
+    "Reverse step CPU [with count xx]",
+    "Requires history, Example: rstep, rstep 100",
+    false,
+    true,
+    { kARG_WORD, kARG_END_ARGS },
+    std::mem_fn(&DebuggerParser::executeRstep)
+  },
+
   {
     "run",
     "Exit debugger, return to emulator",
@@ -2190,6 +2470,28 @@ DebuggerParser::Command DebuggerParser::commands[kNumCommands] = {
     std::mem_fn(&DebuggerParser::executeRunToPc)
   },
 
+  {
+    "rununtil",
+    "Run until <condition> is true",
+    "Condition can include multiple items, see documentation\nExample: rununtil _scan>100",
+    true,
+    true,
+    { kARG_WORD, kARG_END_ARGS },
+    std::mem_fn(&DebuggerParser::executeRunUntil)
+  },
+
+  {
+    "rwrite",
+    "Reverse to the last write to address xx",
+    "Goes back to the start of the instruction which last wrote to the\n"
+    "address (or one of its mirrors)\n"
+    "Requires history, Example: rwrite 80, rwrite COLUBK",
+    true,
+    true,
+    { kARG_WORD, kARG_END_ARGS },
+    std::mem_fn(&DebuggerParser::executeRwrite)
+  },
+
   {
     "s",
     "Set Stack Pointer to value xx",
@@ -2304,6 +2606,41 @@ DebuggerParser::Command DebuggerParser::commands[kNumCommands] = {
     std::mem_fn(&DebuggerParser::executeTia)
   },
 
+  {
+    "tialog",
+    "Toggle logging of all TIA register writes",
+    "Logs register, value, beam position and address of each write for the\n"
+    "last 64 frames; the writes are marked on the TIA output\n"
+    "Example: tialog",
+    false,
+    true,
+    { kARG_END_ARGS },
+    std::mem_fn(&DebuggerParser::executeTialog)
+  },
+
+  {
+    "tialogdump",
+    "Show the last [xx] logged TIA writes",
+    "Shows frame, scanline/color clock, register, value and bank/address\n"
+    "Example: tialogdump, tialogdump #100",
+    false,
+    false,
+    { kARG_WORD, kARG_END_ARGS },
+    std::mem_fn(&DebuggerParser::executeTialogdump)
+  },
+
+  {
+    "tialogsave",
+    "Save logged TIA writes [to file xx]",
+    "Saves as CSV, oldest write first\n"
+    "Example: tialogsave, tialogsave writes.csv\n"
+    "NOTE: saves to default save location without filename",
+    false,
+    false,
+    { kARG_FILE, kARG_END_ARGS },
+    std::mem_fn(&DebuggerParser::executeTialogsave)
+  },
+
   {
     "trace",
     "Single step CPU over subroutines [with count xx]",
@@ -2314,6 +2651,52 @@ DebuggerParser::Command DebuggerParser::commands[kNumCommands] = {
     std::mem_fn(&DebuggerParser::executeTrace)
   },
 
+  {
+    "tracedecode",
+    "Decode trace file xx to text (in xx.txt)",
+    "Loads the trace (replacing the current one), and writes it as text\n"
+    "using the labels of the current ROM\n"
+    "Example: tracedecode game.a26trace",
+    true,
+    false,
+    { kARG_FILE, kARG_END_ARGS },
+    std::mem_fn(&DebuggerParser::executeTracedecode)
+  },
+
+  {
+    "tracedump",
+    "Show the last [xx] traced instructions",
+    "Shows bank, scanline/color clock, address, instruction and registers\n"
+    "Example: tracedump, tracedump #100",
+    false,
+    false,
+    { kARG_WORD, kARG_END_ARGS },
+    std::mem_fn(&DebuggerParser::executeTracedump)
+  },
+
+  {
+    "tracelog",
+    "Toggle recording of all executed instructions",
+    "The last 1M instructions are kept, see tracedump and tracesave\n"
+    "Example: tracelog",
+    false,
+    false,
+    { kARG_END_ARGS },
+    std::mem_fn(&DebuggerParser::executeTracelog)
+  },
+
+  {
+    "tracesave",
+    "Save traced instructions [to file xx]",
+    "Saves in binary format, see tracedecode\n"
+    "Example: tracesave, tracesave game.a26trace\n"
+    "NOTE: saves to default save location without filename",
+    false,
+    false,
+    { kARG_FILE, kARG_END_ARGS },
+    std::mem_fn(&DebuggerParser::executeTracesave)
+  },
+
   {
     "trap",
     "Trap read/write access to address(es) xx [yy]",
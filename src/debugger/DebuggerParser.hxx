@@ -24,6 +24,7 @@
 
 class Debugger;
 class FilesystemNode;
+class PackedBitArray;
 struct Command;
 
 #include "bspf.hxx"
@@ -68,7 +69,7 @@ class DebuggerParser
     bool saveScriptFile(string file);
 
   private:
-    enum { kNumCommands = 72 };
+    enum { kNumCommands = 87 };
 
     // Constants for argument processing
     enum {
@@ -120,6 +121,13 @@ class DebuggerParser
     std::set<uInt32> myTraps;
     string trapStatus(uInt32 addr, bool& enabled);
 
+    // Set an address to stop at (for 'runto' etc) in all its mirrors
+    static void setStopAddress(PackedBitArray& addresses, uInt16 addr);
+
+    // Explain why 'runto' etc didn't reach their target, after running
+    // the given number of cycles
+    string runToFailure(uInt64 cycles) const;
+
     // List of available command methods
     void executeA();
     void executeBase();
@@ -149,6 +157,7 @@ class DebuggerParser
     void executeFunction();
     void executeGfx();
     void executeHelp();
+    void executeHistory();
     void executeJump();
     void executeListbreaks();
     void executeListconfig();
@@ -161,15 +170,22 @@ class DebuggerParser
     void executePc();
     void executePGfx();
     void executePrint();
+    void executeProfile();
+    void executeProfiledump();
+    void executeProfilesave();
     void executeRam();
     void executeReset();
     void executeRewind();
     void executeRiot();
     void executeRom();
     void executeRow();
+    void executeRscanline();
+    void executeRstep();
     void executeRun();
     void executeRunTo();
     void executeRunToPc();
+    void executeRunUntil();
+    void executeRwrite();
     void executeS();
     void executeSave();
     void executeSaveconfig();
@@ -181,7 +197,14 @@ class DebuggerParser
     void executeScanline();
     void executeStep();
     void executeTia();
+    void executeTialog();
+    void executeTialogdump();
+    void executeTialogsave();
     void executeTrace();
+    void executeTracedecode();
+    void executeTracedump();
+    void executeTracelog();
+    void executeTracesave();
     void executeTrap();
     void executeTrapread();
     void executeTrapwrite();
@@ -24,7 +24,7 @@ using Common::Base;
 DiStella::DiStella(const CartDebug& dbg, CartDebug::DisassemblyList& list,
                    CartDebug::BankInfo& info, const DiStella::Settings& s,
                    uInt8* labels, uInt8* directives,
-                   CartDebug::ReservedEquates& reserved)
+                   CartDebug::ReservedEquates& reserved, BankImage* image)
   : myDbg(dbg),
     myList(list),
     mySettings(s),
@@ -33,7 +33,8 @@ DiStella::DiStella(const CartDebug& dbg, CartDebug::DisassemblyList& list,
     myPC(0),
     myPCEnd(0),
     myLabels(labels),
-    myDirectives(directives)
+    myDirectives(directives),
+    myImage(image)
 {
   bool resolve_code = mySettings.resolveCode;
   CartDebug::AddressList& debuggerAddresses = info.addressList;
@@ -160,7 +161,7 @@ void DiStella::disasm(uInt32 distart, int pass)
         mark(myPC + myOffset, CartDebug::VALID_ENTRY);
 
       // get opcode
-      opcode = Debugger::debugger().peek(myPC + myOffset);
+      opcode = peek(myPC + myOffset);
       // get address mode for opcode
       addrMode = ourLookup[opcode].addr_mode;
 
@@ -185,7 +186,7 @@ void DiStella::disasm(uInt32 distart, int pass)
           // the opcode's operand address matches a label address
           if (pass == 3) {
             // output the byte of the opcode incl. cycles
-            Uint8 nextOpcode = Debugger::debugger().peek(myPC + myOffset);
+            Uint8 nextOpcode = peek(myPC + myOffset);
 
             cycles += int(ourLookup[opcode].cycles) - int(ourLookup[nextOpcode].cycles);
             nextLine << ".byte   $" << Base::HEX2 << int(opcode) << " ;";
@@ -245,7 +246,7 @@ void DiStella::disasm(uInt32 distart, int pass)
                 else
                   myDisasmBuf << Base::HEX4 << myPC + myOffset << "'     '";
 
-                opcode = Debugger::debugger().peek(myPC + myOffset);  myPC++;
+                opcode = peek(myPC + myOffset);  myPC++;
                 myDisasmBuf << ".byte $" << Base::HEX2 << int(opcode) << "              $"
                   << Base::HEX4 << myPC + myOffset << "'"
                   << Base::HEX2 << int(opcode);
@@ -293,7 +294,7 @@ void DiStella::disasm(uInt32 distart, int pass)
 
         case ABSOLUTE:
         {
-          ad = Debugger::debugger().dpeek(myPC + myOffset);  myPC += 2;
+          ad = dpeek(myPC + myOffset);  myPC += 2;
           labelFound = mark(ad, CartDebug::REFERENCED);
           if (pass == 3) {
             if (ad < 0x100 && mySettings.fFlag)
@@ -323,7 +324,7 @@ void DiStella::disasm(uInt32 distart, int pass)
 
         case ZERO_PAGE:
         {
-          d1 = Debugger::debugger().peek(myPC + myOffset);  myPC++;
+          d1 = peek(myPC + myOffset);  myPC++;
           labelFound = mark(d1, CartDebug::REFERENCED);
           if (pass == 3) {
             nextLine << "     ";
@@ -335,7 +336,7 @@ void DiStella::disasm(uInt32 distart, int pass)
 
         case IMMEDIATE:
         {
-          d1 = Debugger::debugger().peek(myPC + myOffset);  myPC++;
+          d1 = peek(myPC + myOffset);  myPC++;
           if (pass == 3) {
             nextLine << "     #$" << Base::HEX2 << int(d1) << " ";
             nextLineBytes << Base::HEX2 << int(d1);
@@ -345,7 +346,7 @@ void DiStella::disasm(uInt32 distart, int pass)
 
         case ABSOLUTE_X:
         {
-          ad = Debugger::debugger().dpeek(myPC + myOffset);  myPC += 2;
+          ad = dpeek(myPC + myOffset);  myPC += 2;
           labelFound = mark(ad, CartDebug::REFERENCED);
           if (pass == 2 && !checkBit(ad & myAppData.end, CartDebug::CODE)) {
             // Since we can't know what address is being accessed unless we also
@@ -384,7 +385,7 @@ void DiStella::disasm(uInt32 distart, int pass)
 
         case ABSOLUTE_Y:
         {
-          ad = Debugger::debugger().dpeek(myPC + myOffset);  myPC += 2;
+          ad = dpeek(myPC + myOffset);  myPC += 2;
           labelFound = mark(ad, CartDebug::REFERENCED);
           if (pass == 2 && !checkBit(ad & myAppData.end, CartDebug::CODE)) {
             // Since we can't know what address is being accessed unless we also
@@ -423,7 +424,7 @@ void DiStella::disasm(uInt32 distart, int pass)
 
         case INDIRECT_X:
         {
-          d1 = Debugger::debugger().peek(myPC + myOffset);  myPC++;
+          d1 = peek(myPC + myOffset);  myPC++;
           if (pass == 3) {
             labelFound = mark(d1, 0);  // dummy call to get address type
             nextLine << "     (";
@@ -436,7 +437,7 @@ void DiStella::disasm(uInt32 distart, int pass)
 
         case INDIRECT_Y:
         {
-          d1 = Debugger::debugger().peek(myPC + myOffset);  myPC++;
+          d1 = peek(myPC + myOffset);  myPC++;
           if (pass == 3) {
             labelFound = mark(d1, 0);  // dummy call to get address type
             nextLine << "     (";
@@ -449,7 +450,7 @@ void DiStella::disasm(uInt32 distart, int pass)
 
         case ZERO_PAGE_X:
         {
-          d1 = Debugger::debugger().peek(myPC + myOffset);  myPC++;
+          d1 = peek(myPC + myOffset);  myPC++;
           labelFound = mark(d1, CartDebug::REFERENCED);
           if (pass == 3) {
             nextLine << "     ";
@@ -462,7 +463,7 @@ void DiStella::disasm(uInt32 distart, int pass)
 
         case ZERO_PAGE_Y:
         {
-          d1 = Debugger::debugger().peek(myPC + myOffset);  myPC++;
+          d1 = peek(myPC + myOffset);  myPC++;
           labelFound = mark(d1, CartDebug::REFERENCED);
           if (pass == 3) {
             nextLine << "     ";
@@ -478,7 +479,7 @@ void DiStella::disasm(uInt32 distart, int pass)
           // SA - 04-06-2010: there seemed to be a bug in distella,
           // where wraparound occurred on a 32-bit int, and subsequent
           // indexing into the labels array caused a crash
-          d1 = Debugger::debugger().peek(myPC + myOffset);  myPC++;
+          d1 = peek(myPC + myOffset);  myPC++;
           ad = ((myPC + Int8(d1)) & 0xfff) + myOffset;
 
           labelFound = mark(ad, CartDebug::REFERENCED);
@@ -496,7 +497,7 @@ void DiStella::disasm(uInt32 distart, int pass)
 
         case ABS_INDIRECT:
         {
-          ad = Debugger::debugger().dpeek(myPC + myOffset);  myPC += 2;
+          ad = dpeek(myPC + myOffset);  myPC += 2;
           labelFound = mark(ad, CartDebug::REFERENCED);
           if (pass == 2 && !checkBit(ad & myAppData.end, CartDebug::CODE)) {
             // Since we can't know what address is being accessed unless we also
@@ -603,10 +604,10 @@ void DiStella::disasmPass1(CartDebug::AddressList& debuggerAddresses)
       for (uInt32 k = pcBeg; k <= myPCEnd; k++) {
         if (checkBits(k, CartDebug::CartDebug::DATA | CartDebug::GFX | CartDebug::PGFX,
                       CartDebug::CODE)) {
-          //if (Debugger::debugger().getAccessFlags(k) &
+          //if (getAccessFlags(k) &
           //    (CartDebug::DATA | CartDebug::GFX | CartDebug::PGFX)) {
           // TODO: this should never happen, remove when we are sure
-          // TODO: NOT USED: uInt8 flags = Debugger::debugger().getAccessFlags(k);
+          // TODO: NOT USED: uInt8 flags = getAccessFlags(k);
           myPCEnd = k - 1;
           break;
         }
@@ -642,7 +643,7 @@ void DiStella::disasmPass1(CartDebug::AddressList& debuggerAddresses)
     // Stella itself can provide hints on whether an address has ever
     // been referenced as CODE
     while (myAddressQueue.empty() && codeAccessPoint <= myAppData.end) {
-      if ((Debugger::debugger().getAccessFlags(codeAccessPoint + myOffset) & CartDebug::CODE)
+      if ((getAccessFlags(codeAccessPoint + myOffset) & CartDebug::CODE)
           && !(myLabels[codeAccessPoint & myAppData.end] & CartDebug::CODE)) {
         myAddressQueue.push(codeAccessPoint + myOffset);
         ++codeAccessPoint;
@@ -656,9 +657,9 @@ void DiStella::disasmPass1(CartDebug::AddressList& debuggerAddresses)
   for (int k = 0; k <= myAppData.end; k++) {
     // Let the emulation core know about tentative code
     if (checkBit(k, CartDebug::CODE) &&
-      !(Debugger::debugger().getAccessFlags(k + myOffset) & CartDebug::CODE)
+      !(getAccessFlags(k + myOffset) & CartDebug::CODE)
       && myOffset != 0) {
-      Debugger::debugger().setAccessFlags(k + myOffset, CartDebug::TCODE);
+      setAccessFlags(k + myOffset, CartDebug::TCODE);
     }
 
     // Must be ROW / unused bytes
@@ -687,7 +688,7 @@ void DiStella::disasmFromAddress(uInt32 distart)
 
     // so this should be code now...
     // get opcode
-    opcode = Debugger::debugger().peek(myPC + myOffset);  myPC++;
+    opcode = peek(myPC + myOffset);  myPC++;
     // get address mode for opcode
     addrMode = ourLookup[opcode].addr_mode;
 
@@ -722,7 +723,7 @@ void DiStella::disasmFromAddress(uInt32 distart)
     // Add operand(s)
     switch (addrMode) {
       case ABSOLUTE:
-        ad = Debugger::debugger().dpeek(myPC + myOffset);  myPC += 2;
+        ad = dpeek(myPC + myOffset);  myPC += 2;
         mark(ad, CartDebug::REFERENCED);
         // handle JMP/JSR
         if (ourLookup[opcode].source == M_ADDR) {
@@ -737,7 +738,7 @@ void DiStella::disasmFromAddress(uInt32 distart)
         break;
 
       case ZERO_PAGE:
-        d1 = Debugger::debugger().peek(myPC + myOffset);  myPC++;
+        d1 = peek(myPC + myOffset);  myPC++;
         mark(d1, CartDebug::REFERENCED);
         break;
 
@@ -746,12 +747,12 @@ void DiStella::disasmFromAddress(uInt32 distart)
         break;
 
       case ABSOLUTE_X:
-        ad = Debugger::debugger().dpeek(myPC + myOffset);  myPC += 2;
+        ad = dpeek(myPC + myOffset);  myPC += 2;
         mark(ad, CartDebug::REFERENCED);
         break;
 
       case ABSOLUTE_Y:
-        ad = Debugger::debugger().dpeek(myPC + myOffset);  myPC += 2;
+        ad = dpeek(myPC + myOffset);  myPC += 2;
         mark(ad, CartDebug::REFERENCED);
         break;
 
@@ -764,12 +765,12 @@ void DiStella::disasmFromAddress(uInt32 distart)
         break;
 
       case ZERO_PAGE_X:
-        d1 = Debugger::debugger().peek(myPC + myOffset);  myPC++;
+        d1 = peek(myPC + myOffset);  myPC++;
         mark(d1, CartDebug::REFERENCED);
         break;
 
       case ZERO_PAGE_Y:
-        d1 = Debugger::debugger().peek(myPC + myOffset);  myPC++;
+        d1 = peek(myPC + myOffset);  myPC++;
         mark(d1, CartDebug::REFERENCED);
         break;
 
@@ -777,7 +778,7 @@ void DiStella::disasmFromAddress(uInt32 distart)
         // SA - 04-06-2010: there seemed to be a bug in distella,
         // where wraparound occurred on a 32-bit int, and subsequent
         // indexing into the labels array caused a crash
-        d1 = Debugger::debugger().peek(myPC + myOffset);  myPC++;
+        d1 = peek(myPC + myOffset);  myPC++;
         ad = ((myPC + Int8(d1)) & 0xfff) + myOffset;
         mark(ad, CartDebug::REFERENCED);
         // do NOT use flags set by debugger, else known CODE will not analyzed statically.
@@ -788,7 +789,7 @@ void DiStella::disasmFromAddress(uInt32 distart)
         break;
 
       case ABS_INDIRECT:
-        ad = Debugger::debugger().dpeek(myPC + myOffset);  myPC += 2;
+        ad = dpeek(myPC + myOffset);  myPC += 2;
         mark(ad, CartDebug::REFERENCED);
         break;
 
@@ -798,7 +799,7 @@ void DiStella::disasmFromAddress(uInt32 distart)
 
     // mark BRK vector
     if (opcode == 0x00) {
-      ad = Debugger::debugger().dpeek(0xfffe, CartDebug::DATA);
+      ad = dpeek(0xfffe, CartDebug::DATA);
       if (!myReserved.breakFound) {
         myAddressQueue.push(ad);
         mark(ad, CartDebug::CODE);
@@ -899,7 +900,7 @@ bool DiStella::checkBit(uInt16 address, uInt8 mask, bool useDebugger) const
   uInt8 label = myLabels[address & myAppData.end],
     lastbits = label & 0x03,
     directive = myDirectives[address & myAppData.end] & 0xFC,
-    debugger = Debugger::debugger().getAccessFlags(address | myOffset) & 0xFC;
+    debugger = getAccessFlags(address | myOffset) & 0xFC;
 
   // Any address marked by a manual directive always takes priority
   if (directive)
@@ -917,6 +918,38 @@ bool DiStella::checkBits(uInt16 address, uInt8 mask, uInt8 notMask, bool useDebu
   return checkBit(address, mask, useDebugger) && !checkBit(address, notMask, useDebugger);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt8 DiStella::peek(uInt16 address, uInt8 flags)
+{
+  if(!myImage)
+    return Debugger::debugger().peek(address, flags);
+
+  myImage->flags[address & 0xFFF] |= flags;
+  return myImage->data[address & 0xFFF];
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt16 DiStella::dpeek(uInt16 address, uInt8 flags)
+{
+  return peek(address, flags) | (peek(address + 1, flags) << 8);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt8 DiStella::getAccessFlags(uInt16 address) const
+{
+  return myImage ? myImage->flags[address & 0xFFF] :
+                   Debugger::debugger().getAccessFlags(address);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void DiStella::setAccessFlags(uInt16 address, uInt8 flags)
+{
+  if(myImage)
+    myImage->flags[address & 0xFFF] |= flags;
+  else
+    Debugger::debugger().setAccessFlags(address, flags);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool DiStella::check_range(uInt16 beg, uInt16 end) const
 {
@@ -987,10 +1020,10 @@ void DiStella::addEntry(CartDebug::DisasmType type)
       // but it could also indicate that code will *never* be accessed
       // Since it is impossible to tell the difference, marking the address
       // in the disassembly at least tells the user about it
-      if (!(Debugger::debugger().getAccessFlags(tag.address) & CartDebug::CODE)
+      if (!(getAccessFlags(tag.address) & CartDebug::CODE)
           && myOffset != 0) {
         tag.ccount += " *";
-        Debugger::debugger().setAccessFlags(tag.address, CartDebug::TCODE);
+        setAccessFlags(tag.address, CartDebug::TCODE);
       }
       break;
     case CartDebug::GFX:
@@ -1022,7 +1055,7 @@ void DiStella::outputGraphics()
 {
   bool isPGfx = checkBit(myPC, CartDebug::PGFX);
   const string& bitString = isPGfx ? "\x1f" : "\x1e";
-  uInt8 byte = Debugger::debugger().peek(myPC + myOffset);
+  uInt8 byte = peek(myPC + myOffset);
 
   // add extra spacing line when switching from non-graphics to graphics
   if (mySegType != CartDebug::GFX && mySegType != CartDebug::NONE) {
@@ -1070,14 +1103,14 @@ void DiStella::outputBytes(CartDebug::DisasmType type)
 
       myDisasmBuf << Base::HEX4 << myPC + myOffset << "'L" << Base::HEX4
         << myPC + myOffset << "'.byte " << "$" << Base::HEX2
-        << int(Debugger::debugger().peek(myPC + myOffset));
+        << int(peek(myPC + myOffset));
       myPC++;
       numBytes = 1;
       lineEmpty = false;
     } else if (lineEmpty) {
       // start a new line without a label
       myDisasmBuf << Base::HEX4 << myPC + myOffset << "'     '"
-        << ".byte $" << Base::HEX2 << int(Debugger::debugger().peek(myPC + myOffset));
+        << ".byte $" << Base::HEX2 << int(peek(myPC + myOffset));
       myPC++;
       numBytes = 1;
       lineEmpty = false;
@@ -1087,7 +1120,7 @@ void DiStella::outputBytes(CartDebug::DisasmType type)
       addEntry(type);
       lineEmpty = true;
     } else {
-      myDisasmBuf << ",$" << Base::HEX2 << int(Debugger::debugger().peek(myPC + myOffset));
+      myDisasmBuf << ",$" << Base::HEX2 << int(peek(myPC + myOffset));
       myPC++;
     }
     isType = checkBits(myPC, type,
@@ -54,6 +54,14 @@ class DiStella
     };
     static Settings settings;  // Default settings
 
+    // A copy of the contents and access flags of the cart address space
+    // ($1000 - $1FFF) while a specific bank was mapped in, so that the bank
+    // can be disassembled without the System (and from any thread)
+    struct BankImage {
+      uInt8 data[0x1000];
+      uInt8 flags[0x1000];
+    };
+
   public:
     /**
       Disassemble the current state of the System from the given start address.
@@ -65,11 +73,13 @@ class DiStella
       @param labels      Array storing label info determined by Distella
       @param directives  Array storing directive info determined by Distella
       @param reserved    The TIA/RIOT addresses referenced in the disassembled code
+      @param image       The bank contents to use instead of the System;
+                         tentative code is marked in its flags
     */
     DiStella(const CartDebug& dbg, CartDebug::DisassemblyList& list,
              CartDebug::BankInfo& info, const DiStella::Settings& settings,
              uInt8* labels, uInt8* directives,
-             CartDebug::ReservedEquates& reserved);
+             CartDebug::ReservedEquates& reserved, BankImage* image = nullptr);
 
   private:
     // Indicate that a new line of disassembly has been completed
@@ -91,6 +101,13 @@ class DiStella
     bool checkBit(uInt16 address, uInt8 mask, bool useDebugger = true) const;
 
     bool checkBits(uInt16 address, uInt8 mask, uInt8 notMask, bool useDebugger = true) const;
+
+    // Access the bank contents and flags, either through the System or
+    // the bank image
+    uInt8 peek(uInt16 address, uInt8 flags = 0);
+    uInt16 dpeek(uInt16 address, uInt8 flags = 0);
+    uInt8 getAccessFlags(uInt16 address) const;
+    void setAccessFlags(uInt16 address, uInt8 flags);
     void outputGraphics();
     void outputBytes(CartDebug::DisasmType type);
 
@@ -139,6 +156,12 @@ class DiStella
     */
     uInt8 *myLabels, *myDirectives;
 
+    // The bank being disassembled, when not using the System
+    BankImage* myImage;
+
+  public:
+    // The opcode information is also used to decode execution traces
+
     /**
       Enumeration of the 6502 addressing modes
     */
@@ -0,0 +1,438 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2017 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+
+#include "Console.hxx"
+#include "M6502.hxx"
+#include "M6532.hxx"
+#include "PackedBitArray.hxx"
+#include "Serializer.hxx"
+#include "System.hxx"
+#include "TIA.hxx"
+#include "ExecutionHistory.hxx"
+
+namespace {
+  // Used for cycles which weren't found
+  constexpr uInt64 kNoCycle = ~uInt64(0);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ExecutionHistory::ExecutionHistory(Console& console)
+  : myConsole(console),
+    mySystem(console.system()),
+    myTIA(console.tia()),
+    myIsRecording(false),
+    myFirstInput(0),
+    myNextInput(0),
+    myFramesSinceCheckpoint(0),
+    myLoadCount(0)
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ExecutionHistory::~ExecutionHistory()
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ExecutionHistory::start()
+{
+  clear();
+  myIsRecording = true;
+  addCheckpoint();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ExecutionHistory::stop()
+{
+  myIsRecording = false;
+  clear();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ExecutionHistory::clear()
+{
+  myCheckpoints.clear();
+  myInputs.clear();
+  myFirstInput = myNextInput = 0;
+  myFramesSinceCheckpoint = 0;
+  myLoadCount = myConsole.loadCount();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ExecutionHistory::addFrame()
+{
+  if(!myIsRecording)
+    return;
+
+  checkContinuity();
+
+  const uInt64 cycle = mySystem.cycles();
+  Input input;
+  input.cycle = cycle;
+  input.data = make_unique<Serializer>();
+  if(!myConsole.riot().saveInputs(*input.data))
+    return;
+  myInputs.push_back(std::move(input));
+
+  if(++myFramesSinceCheckpoint >= kCheckpointFrames || myCheckpoints.empty())
+    addCheckpoint();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ExecutionHistory::addCheckpoint()
+{
+  if(!myIsRecording)
+    return;
+
+  checkContinuity();
+
+  const uInt64 cycle = mySystem.cycles();
+
+  // The state at the same cycle may have been changed since (in the
+  // debugger), so only the newest one is kept
+  if(!myCheckpoints.empty() && myCheckpoints.back().cycle == cycle)
+    myCheckpoints.pop_back();
+
+  Checkpoint checkpoint;
+  checkpoint.cycle = cycle;
+  checkpoint.input = myFirstInput + myInputs.size();
+  checkpoint.state = make_unique<Serializer>();
+  if(!myConsole.save(*checkpoint.state))
+    return;
+  myCheckpoints.push_back(std::move(checkpoint));
+  myFramesSinceCheckpoint = 0;
+
+  while(myCheckpoints.size() > kMaxCheckpoints)
+    myCheckpoints.pop_front();
+
+  // Inputs before the first checkpoint can't be replayed anymore
+  while(!myInputs.empty() && myFirstInput < myCheckpoints.front().input)
+  {
+    myInputs.pop_front();
+    ++myFirstInput;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt64 ExecutionHistory::firstCycle() const
+{
+  return myCheckpoints.empty() ? mySystem.cycles() : myCheckpoints.front().cycle;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 ExecutionHistory::reverseStep(uInt32 count)
+{
+  if(!myIsRecording || count == 0)
+    return 0;
+
+  addCheckpoint();
+
+  // The instructions before the current cycle are counted one segment
+  // (between two checkpoints) at a time, going backwards
+  uInt64 end = mySystem.cycles(), target = kNoCycle;
+  uInt32 reversed = 0;
+  vector<uInt64> starts;
+  for(int cp = findCheckpoint(end); cp >= 0; cp = findCheckpoint(end))
+  {
+    const uInt64 first = myCheckpoints[cp].cycle;
+    const uInt32 needed = count - reversed;
+
+    // Most of the segment is run at full speed, and only its end is
+    // single stepped to find the instruction starts; that part is made
+    // longer until it contains enough instructions
+    uInt64 window = 8 * uInt64(needed) + 64;
+    for(;;)
+    {
+      const uInt64 from = end - first > window ? end - window : first;
+      restore(cp);
+      runTo(from);
+
+      starts.clear();
+      while(mySystem.cycles() < end)
+      {
+        starts.push_back(mySystem.cycles());
+        if(!step())
+          break;
+      }
+      if(starts.size() >= needed || from == first)
+        break;
+      window *= 4;
+    }
+
+    if(starts.size() >= needed)
+    {
+      target = starts[starts.size() - needed];
+      reversed = count;
+      break;
+    }
+    reversed += uInt32(starts.size());
+    end = first;
+  }
+
+  // Without enough instructions, the start of the history is used
+  returnTo(target != kNoCycle ? target : end);
+  truncate();
+
+  return reversed;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ExecutionHistory::reverseToWrite(uInt16 address)
+{
+  if(!myIsRecording)
+    return false;
+
+  addCheckpoint();
+
+  // The CPU records the start of the instructions writing to any of the
+  // addresses which access the same location
+  const uInt16 base = mirrorBase(address);
+  PackedBitArray watch;
+  for(uInt32 a = 0; a < 0x10000; ++a)
+    if(mirrorBase(uInt16(a)) == base)
+      watch.set(uInt16(a));
+  watch.initialize();
+
+  M6502& cpu = mySystem.m6502();
+  const uInt64 current = mySystem.cycles();
+  uInt64 end = current, target = kNoCycle;
+  for(int cp = findCheckpoint(end); cp >= 0 && target == kNoCycle;
+      cp = findCheckpoint(end))
+  {
+    restore(cp);
+    cpu.setWriteWatch(&watch, &target);
+    runTo(end);
+    cpu.setWriteWatch(nullptr, nullptr);
+
+    end = myCheckpoints[cp].cycle;
+  }
+
+  returnTo(target != kNoCycle ? target : current);
+  truncate();
+
+  return target != kNoCycle;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ExecutionHistory::reverseToScanline(uInt32 scanline)
+{
+  if(!myIsRecording)
+    return false;
+
+  addCheckpoint();
+
+  // A stretch of the emulation which starts at the given frame and line
+  struct Hop {
+    uInt64 start, end;
+    uInt32 frame, line;
+  };
+  const auto position = [&](uInt32& frame, uInt32& line) {
+    uInt32 clock;
+    myTIA.beamPosition(line, clock);
+    frame = myTIA.frameCount();
+  };
+  // Answer whether the beam has entered the scanline since the start of
+  // the hop
+  const auto entered = [&](const Hop& hop, uInt32 frame, uInt32 line) {
+    return line >= scanline && (hop.line < scanline || frame != hop.frame);
+  };
+
+  const uInt64 current = mySystem.cycles();
+  uInt64 end = current, target = kNoCycle;
+  vector<Hop> hops;
+  for(int cp = findCheckpoint(end); cp >= 0 && target == kNoCycle;
+      cp = findCheckpoint(end))
+  {
+    // Run the segment a scanline at a time, keeping the stretches in
+    // which the beam may have entered the scanline
+    restore(cp);
+    hops.clear();
+    Hop hop;
+    position(hop.frame, hop.line);
+    while(mySystem.cycles() < end)
+    {
+      hop.start = mySystem.cycles();
+      runTo(std::min(hop.start + 76, end));
+      hop.end = mySystem.cycles();
+      if(hop.end == hop.start)
+        break;
+
+      uInt32 frame, line;
+      position(frame, line);
+      if(entered(hop, frame, line) ||
+         (hop.line < scanline && frame != hop.frame))
+        hops.push_back(hop);
+      hop.frame = frame;
+      hop.line = line;
+    }
+
+    // The last of them in which the scanline was really entered (before
+    // the current cycle) contains the instruction to stop at
+    for(auto h = hops.rbegin(); h != hops.rend() && target == kNoCycle; ++h)
+    {
+      restore(cp);
+      runTo(h->start);
+      while(mySystem.cycles() < current)
+      {
+        uInt32 frame, line;
+        position(frame, line);
+        if(entered(*h, frame, line))
+        {
+          target = mySystem.cycles();
+          break;
+        }
+        if(mySystem.cycles() >= h->end || !step())
+          break;
+      }
+    }
+
+    end = myCheckpoints[cp].cycle;
+  }
+
+  returnTo(target != kNoCycle ? target : current);
+  truncate();
+
+  return target != kNoCycle;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt64 ExecutionHistory::lastCycle() const
+{
+  uInt64 cycle = 0;
+  if(!myCheckpoints.empty())
+    cycle = myCheckpoints.back().cycle;
+  if(!myInputs.empty())
+    cycle = std::max(cycle, myInputs.back().cycle);
+
+  return cycle;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ExecutionHistory::checkContinuity()
+{
+  if(myConsole.loadCount() != myLoadCount || mySystem.cycles() < lastCycle())
+    clear();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+int ExecutionHistory::findCheckpoint(uInt64 cycle, bool inclusive) const
+{
+  for(int i = int(myCheckpoints.size()) - 1; i >= 0; --i)
+    if(myCheckpoints[i].cycle < cycle ||
+       (inclusive && myCheckpoints[i].cycle == cycle))
+      return i;
+
+  return -1;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ExecutionHistory::restore(uInt32 checkpoint)
+{
+  Checkpoint& cp = myCheckpoints[checkpoint];
+  cp.state->reset();
+  myConsole.load(*cp.state);
+  myLoadCount = myConsole.loadCount();
+  myNextInput = cp.input;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ExecutionHistory::returnTo(uInt64 cycle)
+{
+  int cp = findCheckpoint(cycle, true);
+  if(cp < 0)
+    return;
+
+  restore(cp);
+  runTo(cycle);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ExecutionHistory::runTo(uInt64 cycle)
+{
+  M6502& cpu = mySystem.m6502();
+  while(mySystem.cycles() < cycle)
+  {
+    applyInputs();
+
+    // Stop for the next input as well, so it's applied at the same cycle
+    // as it was originally
+    uInt64 stop = cycle;
+    if(myNextInput < myFirstInput + myInputs.size())
+      stop = std::min(stop, myInputs[myNextInput - myFirstInput].cycle);
+
+    const uInt64 start = mySystem.cycles();
+    cpu.setStopCycle(stop);
+    myTIA.updateByStopPoint();
+    cpu.setStopCycle(M6502::kNoStopCycle);
+
+    if(mySystem.cycles() == start)  // the CPU is stuck (illegal instruction)
+      break;
+  }
+  applyInputs();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ExecutionHistory::step()
+{
+  applyInputs();
+
+  const uInt64 start = mySystem.cycles();
+  myTIA.updateScanlineByStep();
+
+  return mySystem.cycles() != start;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ExecutionHistory::applyInputs()
+{
+  while(myNextInput < myFirstInput + myInputs.size() &&
+        myInputs[myNextInput - myFirstInput].cycle <= mySystem.cycles())
+  {
+    Serializer& data = *myInputs[myNextInput - myFirstInput].data;
+    data.reset();
+    myConsole.riot().loadInputs(data);
+    ++myNextInput;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ExecutionHistory::truncate()
+{
+  const uInt64 cycle = mySystem.cycles();
+  while(!myCheckpoints.empty() && myCheckpoints.back().cycle > cycle)
+    myCheckpoints.pop_back();
+  while(!myInputs.empty() && myInputs.back().cycle > cycle)
+    myInputs.pop_back();
+  myFramesSinceCheckpoint = 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt16 ExecutionHistory::mirrorBase(uInt16 address)
+{
+  // Only 13 address lines are connected to the cartridge slot
+  address &= 0x1fff;
+
+  if(address & 0x1000)
+    return address;                       // cartridge
+  else if(!(address & 0x0080))
+    return address & 0x003f;              // TIA
+  else if(!(address & 0x0200))
+    return 0x0080 | (address & 0x007f);   // RAM
+  else
+    return 0x0280 | (address & 0x001f);   // RIOT registers
+}
@@ -0,0 +1,194 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2017 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+
+#ifndef EXECUTION_HISTORY_HXX
+#define EXECUTION_HISTORY_HXX
+
+class Console;
+class Serializer;
+class System;
+class TIA;
+
+#include <deque>
+
+#include "bspf.hxx"
+
+/**
+  This class makes it possible to run the emulation backwards in the
+  debugger.  While recording, a checkpoint of the complete state is
+  taken every few frames (and whenever the debugger advances the
+  emulation), and the controller and switch state read at the start of
+  each frame is recorded.  Since the emulation is deterministic (the
+  random generator is part of the state), any earlier cycle can then be
+  reached by loading the last checkpoint before it and running the
+  emulation again, applying the recorded inputs at the cycles they were
+  originally read at.
+
+  Searches (eg, for the last write to an address) run at full speed,
+  using the stop cycle and write watch of the CPU; only the short
+  stretch of instructions which has to be counted is single stepped.
+  Reversing within the last few seconds therefore only takes a few
+  frames worth of emulation.
+
+  Going back to a cycle discards the history after it, since it is no
+  longer certain to be repeated.
+*/
+class ExecutionHistory
+{
+  public:
+    ExecutionHistory(Console& console);
+    ~ExecutionHistory();
+
+    /**
+      Start or stop recording; starting discards the previous history.
+    */
+    void start();
+    void stop();
+    bool isRecording() const { return myIsRecording; }
+
+    /**
+      Discard the recorded history.
+    */
+    void clear();
+
+    /**
+      Called once per frame while emulating, after the inputs for the
+      frame were read.  The inputs are recorded, along with a checkpoint
+      every kCheckpointFrames frames.
+    */
+    void addFrame();
+
+    /**
+      Add a checkpoint of the current state.  The debugger does this
+      before it advances the emulation, since the state may have been
+      changed by the user.
+    */
+    void addCheckpoint();
+
+    /**
+      Answer the number of checkpoints, and the first cycle the emulation
+      can be reversed to.
+    */
+    uInt32 checkpoints() const { return uInt32(myCheckpoints.size()); }
+    uInt64 firstCycle() const;
+
+    /**
+      Reverse the emulation by the given number of instructions.
+
+      @return  The number of instructions reversed, which is less than
+               requested if the start of the history was reached
+    */
+    uInt32 reverseStep(uInt32 count);
+
+    /**
+      Reverse the emulation to the start of the last instruction which
+      wrote to the given address (or one of its mirrors).
+
+      @return  True if a write was found, otherwise nothing is changed
+    */
+    bool reverseToWrite(uInt16 address);
+
+    /**
+      Reverse the emulation to the first instruction of the last visit
+      to the given scanline.
+
+      @return  True if the scanline was found, otherwise nothing is changed
+    */
+    bool reverseToScanline(uInt32 scanline);
+
+  private:
+    enum {
+      kCheckpointFrames = 4,   // frames between checkpoints while emulating
+      kMaxCheckpoints = 600    // 40 seconds of emulation, at 60 frames/sec
+    };
+
+    struct Checkpoint {
+      uInt64 cycle;
+      uInt64 input;   // the number of the first input not yet applied
+      unique_ptr<Serializer> state;
+    };
+    struct Input {
+      uInt64 cycle;
+      unique_ptr<Serializer> data;
+    };
+
+    // The last cycle anything was recorded at
+    uInt64 lastCycle() const;
+
+    // Discard the history if it doesn't lead up to the current state
+    // anymore, since the emulation went back or a state was loaded
+    void checkContinuity();
+
+    // Answer the last checkpoint before the given cycle (or at it, if
+    // inclusive is true), or -1 if there is none
+    int findCheckpoint(uInt64 cycle, bool inclusive = false) const;
+
+    // Load the given checkpoint
+    void restore(uInt32 checkpoint);
+
+    // Go back to the given cycle, from the checkpoint before it
+    void returnTo(uInt64 cycle);
+
+    // Run the emulation up to the first instruction starting at or after
+    // the given cycle, applying the recorded inputs along the way
+    void runTo(uInt64 cycle);
+
+    // Execute a single instruction, applying the recorded inputs first;
+    // answer false if no progress was made
+    bool step();
+
+    // Apply the recorded inputs which are due at the current cycle
+    void applyInputs();
+
+    // Discard everything recorded after the current cycle
+    void truncate();
+
+    // Answer the address of the device location the given address
+    // accesses, so that mirrors of an address can be found
+    static uInt16 mirrorBase(uInt16 address);
+
+  private:
+    Console& myConsole;
+    System& mySystem;
+    TIA& myTIA;
+
+    bool myIsRecording;
+
+    std::deque<Checkpoint> myCheckpoints;
+    std::deque<Input> myInputs;
+
+    // The number of the first recorded input, and of the next input to
+    // be applied while replaying
+    uInt64 myFirstInput, myNextInput;
+
+    uInt32 myFramesSinceCheckpoint;
+
+    // The load count of the console after the last checkpoint was
+    // restored; any other load replaces the state the history leads to
+    uInt32 myLoadCount;
+
+  private:
+    // Following constructors and assignment operators not supported
+    ExecutionHistory() = delete;
+    ExecutionHistory(const ExecutionHistory&) = delete;
+    ExecutionHistory(ExecutionHistory&&) = delete;
+    ExecutionHistory& operator=(const ExecutionHistory&) = delete;
+    ExecutionHistory& operator=(ExecutionHistory&&) = delete;
+};
+
+#endif
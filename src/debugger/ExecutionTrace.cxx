@@ -0,0 +1,262 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2017 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+
+#include <fstream>
+#include <iomanip>
+
+#include "Base.hxx"
+#include "Cart.hxx"
+#include "CartDebug.hxx"
+#include "Console.hxx"
+#include "DiStella.hxx"
+#include "TIA.hxx"
+#include "ExecutionTrace.hxx"
+
+using Common::Base;
+
+namespace {
+  // Store values in little-endian order
+  inline uInt8* put16(uInt8* buf, uInt32 value)
+  {
+    *buf++ = uInt8(value);
+    *buf++ = uInt8(value >> 8);
+    return buf;
+  }
+  inline uInt8* put32(uInt8* buf, uInt32 value)
+  {
+    return put16(put16(buf, value), value >> 16);
+  }
+  inline uInt32 get16(const uInt8* buf) { return buf[0] | (buf[1] << 8); }
+  inline uInt32 get32(const uInt8* buf) { return get16(buf) | (get16(buf + 2) << 16); }
+
+  constexpr uInt32 kEntrySize = 16;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ExecutionTrace::ExecutionTrace(const Console& console)
+  : myTIA(console.tia()),
+    myCart(console.cartridge()),
+    myNext(0),
+    myCount(0),
+    myIsRecording(false)
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ExecutionTrace::start()
+{
+  // The buffer is only allocated once it's actually needed
+  if(!myEntries)
+    myEntries = make_unique<Entry[]>(kSize);
+
+  myNext = myCount = 0;
+  myIsRecording = true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ExecutionTrace::stop()
+{
+  myIsRecording = false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ExecutionTrace::Entry& ExecutionTrace::add(uInt16 pc, uInt8 a, uInt8 x,
+                                           uInt8 y, uInt8 sp, uInt8 ps)
+{
+  Entry& e = myEntries[myNext];
+  myNext = (myNext + 1) & (kSize - 1);
+  if(myCount < kSize)
+    ++myCount;
+
+  uInt32 scanline, clock;
+  myTIA.beamPosition(scanline, clock);
+
+  e.pc = pc;
+  e.bank = myCart.getBank();
+  e.scanline = uInt16(scanline);
+  e.clock = uInt8(clock);
+  e.size = 0;
+  e.bytes[0] = e.bytes[1] = e.bytes[2] = 0;
+  e.a = a;  e.x = x;  e.y = y;  e.sp = sp;  e.ps = ps;
+
+  return e;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ExecutionTrace::save(const string& filename) const
+{
+  ofstream out(filename, std::ios_base::binary | std::ios_base::trunc);
+  if(!out.is_open())
+    throw runtime_error("Unable to save trace to " + filename);
+
+  uInt8 header[16] = { 'S', 't', 'e', 'l', 'l', 'a', 'T', 'R' };
+  put32(put32(header + 8, kVersion), myCount);
+  out.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+  // Convert to the file format in blocks, to keep the number of writes low
+  uInt8 buffer[kEntrySize * 1024];
+  for(uInt32 i = 0; i < myCount; )
+  {
+    uInt8* p = buffer;
+    for(uInt32 n = 0; n < 1024 && i < myCount; ++n, ++i)
+    {
+      const Entry& e = entry(i);
+      p = put16(put16(put16(p, e.pc), e.bank), e.scanline);
+      *p++ = e.clock;   *p++ = e.size;
+      *p++ = e.bytes[0];  *p++ = e.bytes[1];  *p++ = e.bytes[2];
+      *p++ = e.a;  *p++ = e.x;  *p++ = e.y;  *p++ = e.sp;  *p++ = e.ps;
+    }
+    out.write(reinterpret_cast<const char*>(buffer), p - buffer);
+  }
+
+  if(!out)
+    throw runtime_error("Unable to save trace to " + filename);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ExecutionTrace::load(const string& filename)
+{
+  ifstream in(filename, std::ios_base::binary);
+  uInt8 header[16];
+  if(!in.read(reinterpret_cast<char*>(header), sizeof(header)) ||
+     memcmp(header, "StellaTR", 8) != 0 || get32(header + 8) != kVersion)
+    throw runtime_error(filename + " is not a (supported) trace file");
+
+  stop();
+  if(!myEntries)
+    myEntries = make_unique<Entry[]>(kSize);
+  myNext = myCount = 0;
+
+  // Only the newest instructions are kept if the file is too large
+  uInt32 count = get32(header + 12);
+  if(count > kSize)
+    in.seekg(std::streamoff(count - kSize) * kEntrySize, std::ios_base::cur);
+
+  uInt8 buffer[kEntrySize];
+  while(in.read(reinterpret_cast<char*>(buffer), kEntrySize))
+  {
+    Entry& e = myEntries[myNext];
+    myNext = (myNext + 1) & (kSize - 1);
+    if(myCount < kSize)
+      ++myCount;
+
+    e.pc = get16(buffer);
+    e.bank = get16(buffer + 2);
+    e.scanline = get16(buffer + 4);
+    e.clock = buffer[6];
+    e.size = std::min(buffer[7], uInt8(3));
+    e.bytes[0] = buffer[8];  e.bytes[1] = buffer[9];  e.bytes[2] = buffer[10];
+    e.a = buffer[11];  e.x = buffer[12];  e.y = buffer[13];
+    e.sp = buffer[14];  e.ps = buffer[15];
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ExecutionTrace::decode(ostream& out, uInt32 first, uInt32 count,
+                            const CartDebug& dbg) const
+{
+  for(uInt32 i = first; i < first + count && i < myCount; ++i)
+  {
+    out << std::setw(7) << std::setfill(' ') << std::dec << i << "  ";
+    decode(out, entry(i), dbg);
+    out << endl;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ExecutionTrace::decode(ostream& out, const Entry& e,
+                            const CartDebug& dbg) const
+{
+  using std::setw;
+  using std::left;
+  using std::right;
+
+  // Where and when the instruction was executed
+  out << "B" << setw(2) << std::setfill(' ') << left << std::dec << e.bank
+      << " " << setw(3) << right << e.scanline << "/" << setw(3) << int(e.clock)
+      << "  " << Base::HEX4 << e.pc << "  ";
+
+  string label = dbg.getLabel(e.pc, true);
+  out << setw(16) << std::setfill(' ') << left
+      << (label != "" ? label + ":" : "");
+
+  // The raw bytes
+  ostringstream bytes;
+  for(uInt32 b = 0; b < e.size; ++b)
+    bytes << Base::HEX2 << int(e.bytes[b]) << " ";
+  out << setw(10) << std::setfill(' ') << left << bytes.str();
+
+  // The instruction itself
+  ostringstream ins;
+  if(e.size > 0)
+  {
+    const DiStella::Instruction_tag& info = DiStella::ourLookup[e.bytes[0]];
+    const bool isRead = info.rw_mode == DiStella::READ;
+    const uInt16 zp = e.bytes[1];
+    const uInt16 abs = e.bytes[1] | (e.bytes[2] << 8);
+
+    ins << info.mnemonic;
+    switch(info.addr_mode)
+    {
+      case DiStella::IMMEDIATE:
+        ins << " #$" << Base::HEX2 << int(zp);
+        break;
+      case DiStella::ZERO_PAGE:
+        ins << " ";  dbg.getLabel(ins, zp, isRead, 2);
+        break;
+      case DiStella::ZERO_PAGE_X:
+        ins << " ";  dbg.getLabel(ins, zp, isRead, 2);  ins << ",x";
+        break;
+      case DiStella::ZERO_PAGE_Y:
+        ins << " ";  dbg.getLabel(ins, zp, isRead, 2);  ins << ",y";
+        break;
+      case DiStella::ABSOLUTE:
+        ins << " ";  dbg.getLabel(ins, abs, isRead, 4);
+        break;
+      case DiStella::ABSOLUTE_X:
+        ins << " ";  dbg.getLabel(ins, abs, isRead, 4);  ins << ",x";
+        break;
+      case DiStella::ABSOLUTE_Y:
+        ins << " ";  dbg.getLabel(ins, abs, isRead, 4);  ins << ",y";
+        break;
+      case DiStella::ABS_INDIRECT:
+        ins << " (";  dbg.getLabel(ins, abs, isRead, 4);  ins << ")";
+        break;
+      case DiStella::INDIRECT_X:
+        ins << " (";  dbg.getLabel(ins, zp, isRead, 2);  ins << ",x)";
+        break;
+      case DiStella::INDIRECT_Y:
+        ins << " (";  dbg.getLabel(ins, zp, isRead, 2);  ins << "),y";
+        break;
+      case DiStella::RELATIVE:
+        ins << " ";  dbg.getLabel(ins, e.pc + 2 + Int8(zp), true, 4);
+        break;
+      default:
+        break;
+    }
+  }
+  out << setw(20) << std::setfill(' ') << left << ins.str();
+
+  // The registers before the instruction was executed
+  static constexpr char flags[] = "NV-BDIZC";
+  out << "A=" << Base::HEX2 << int(e.a) << " X=" << Base::HEX2 << int(e.x)
+      << " Y=" << Base::HEX2 << int(e.y) << " SP=" << Base::HEX2 << int(e.sp)
+      << " PS=";
+  for(int b = 0; b < 8; ++b)
+    out << char(e.ps & (0x80 >> b) ? flags[b] : tolower(flags[b]));
+}
@@ -0,0 +1,131 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2017 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+
+#ifndef EXECUTION_TRACE_HXX
+#define EXECUTION_TRACE_HXX
+
+class Console;
+class CartDebug;
+class TIA;
+class Cartridge;
+
+#include "bspf.hxx"
+
+/**
+  This class records every instruction the CPU executes into a ring
+  buffer, along with the CPU registers and the position of the beam, so
+  that the path leading up to a bug can be examined after the fact.
+  Recording costs little more than a memory write per instruction, so
+  it can be left running during normal play.
+
+  The recorded instructions can be saved to a binary file, and decoded
+  into text later (using the labels of the currently loaded ROM).  The
+  file starts with the 8 byte signature 'StellaTR', followed by the
+  format version and the number of instructions (each a 32-bit value),
+  and then the instructions, 16 bytes each, oldest first:
+
+    PC (16 bits), bank (16 bits), scanline (16 bits), color clock,
+    the number of instruction bytes (1 - 3), the instruction bytes
+    (3 bytes, unused ones are zero), A, X, Y, SP and PS
+
+  All values are stored in little-endian order.
+*/
+class ExecutionTrace
+{
+  public:
+    struct Entry {
+      uInt16 pc, bank, scanline;
+      uInt8 clock;
+      uInt8 size;      // number of valid bytes below
+      uInt8 bytes[3];  // opcode and operands
+      uInt8 a, x, y, sp, ps;
+    };
+
+    ExecutionTrace(const Console& console);
+
+    /**
+      Start or stop recording; the instructions already recorded are kept
+      until recording is started again.
+    */
+    void start();
+    void stop();
+    bool isRecording() const { return myIsRecording; }
+
+    /**
+      Answer the number of instructions recorded, and get one of them
+      (0 is the oldest).
+    */
+    uInt32 size() const { return myCount; }
+    const Entry& entry(uInt32 i) const {
+      return myEntries[(myNext + kSize - myCount + i) & (kSize - 1)];
+    }
+
+    /**
+      Add an instruction to the trace; this is called by the CPU before
+      each instruction is executed, and the instruction bytes are added
+      to the returned entry as they're fetched.
+    */
+    Entry& add(uInt16 pc, uInt8 a, uInt8 x, uInt8 y, uInt8 sp, uInt8 ps);
+
+    /**
+      Save the recorded instructions to the given file, or replace them
+      with the ones in the given file.
+
+      @return  On failure, a runtime_error is thrown containing a more
+               detailed error message.
+    */
+    void save(const string& filename) const;
+    void load(const string& filename);
+
+    /**
+      Write the given instructions as text, one per line.
+
+      @param out    The stream to write to
+      @param first  The first instruction (0 is the oldest)
+      @param count  The number of instructions to write
+      @param dbg    Supplies the labels to use for addresses
+    */
+    void decode(ostream& out, uInt32 first, uInt32 count,
+                const CartDebug& dbg) const;
+
+  private:
+    // Number of instructions kept (16 MB worth), must be a power of two
+    static constexpr uInt32 kSize = 1 << 20;
+    static constexpr uInt32 kVersion = 1;
+
+    // Write one instruction as text
+    void decode(ostream& out, const Entry& entry, const CartDebug& dbg) const;
+
+  private:
+    const TIA& myTIA;
+    const Cartridge& myCart;
+
+    unique_ptr<Entry[]> myEntries;
+    uInt32 myNext, myCount;
+    bool myIsRecording;
+
+  private:
+    // Following constructors and assignment operators not supported
+    ExecutionTrace() = delete;
+    ExecutionTrace(const ExecutionTrace&) = delete;
+    ExecutionTrace(ExecutionTrace&&) = delete;
+    ExecutionTrace& operator=(const ExecutionTrace&) = delete;
+    ExecutionTrace& operator=(ExecutionTrace&&) = delete;
+};
+
+#endif
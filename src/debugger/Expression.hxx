@@ -18,6 +18,8 @@
 #ifndef EXPRESSION_HXX
 #define EXPRESSION_HXX
 
+class ExpressionCode;
+
 #include "bspf.hxx"
 
 /**
@@ -37,6 +39,12 @@ class Expression
 
     virtual Int32 evaluate() const { return 0; }
 
+    /**
+      Add the code for this expression to the given compiled expression
+      (see ExpressionCode); by default, the code calls evaluate().
+    */
+    virtual void compile(ExpressionCode& code) const;
+
   protected:
     unique_ptr<Expression> myLHS, myRHS;
 
@@ -0,0 +1,245 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2017 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+
+#include "Debugger.hxx"
+#include "ExpressionCode.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Expression::compile(ExpressionCode& code) const
+{
+  // Anything not compiled by a subclass is evaluated by the tree
+  code.emitEval(*this);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ExpressionCode::ExpressionCode(const Expression& expression)
+  : myDepth(0),
+    myMaxDepth(0),
+    myRAMOnly(false),
+    myDebugger(Debugger::debugger()),
+    myCpuDebug(Debugger::debugger().cpuDebug()),
+    myCartDebug(Debugger::debugger().cartDebug()),
+    myTiaDebug(Debugger::debugger().tiaDebug())
+{
+  expression.compile(*this);
+  if(myMaxDepth > Int32(kMaxStack))
+  {
+    myCode.clear();
+    emitEval(expression);
+  }
+  emit(kReturn);
+
+  findRAMAddresses();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Int32 ExpressionCode::evaluate() const
+{
+  Int32 stack[kMaxStack];
+  Int32* sp = stack;  // points past the top of the stack
+  const Instruction* code = myCode.data();
+
+  for(const Instruction* i = code; ; ++i)
+  {
+    switch(i->op)
+    {
+      case kConst:      *sp++ = i->value;                             break;
+      case kPeekConst:  *sp++ = myDebugger.peek(i->value);            break;
+      case kCpu:        *sp++ = (myCpuDebug.*i->cpu)();               break;
+      case kCart:       *sp++ = (myCartDebug.*i->cart)();             break;
+      case kTia:        *sp++ = (myTiaDebug.*i->tia)();               break;
+      case kEval:       *sp++ = i->expression->evaluate();            break;
+
+      case kByteDeref:  sp[-1] = myDebugger.peek(sp[-1]);             break;
+      case kWordDeref:  sp[-1] = myDebugger.dpeek(sp[-1]);            break;
+      case kByteDerefOffset:
+        --sp;  sp[-1] = myDebugger.peek(sp[-1] + sp[0]);              break;
+
+      case kPlus:       --sp;  sp[-1] = sp[-1] + sp[0];               break;
+      case kMinus:      --sp;  sp[-1] = sp[-1] - sp[0];               break;
+      case kMult:       --sp;  sp[-1] = sp[-1] * sp[0];               break;
+      case kDiv:   --sp;  sp[-1] = sp[0] == 0 ? 0 : sp[-1] / sp[0];   break;
+      case kMod:   --sp;  sp[-1] = sp[0] == 0 ? 0 : sp[-1] % sp[0];   break;
+      case kBinAnd:     --sp;  sp[-1] = sp[-1] & sp[0];               break;
+      case kBinOr:      --sp;  sp[-1] = sp[-1] | sp[0];               break;
+      case kBinXor:     --sp;  sp[-1] = sp[-1] ^ sp[0];               break;
+      case kShiftLeft:  --sp;  sp[-1] = sp[-1] << sp[0];              break;
+      case kShiftRight: --sp;  sp[-1] = sp[-1] >> sp[0];              break;
+
+      case kEquals:        --sp;  sp[-1] = sp[-1] == sp[0];           break;
+      case kNotEquals:     --sp;  sp[-1] = sp[-1] != sp[0];           break;
+      case kLess:          --sp;  sp[-1] = sp[-1] < sp[0];            break;
+      case kLessEquals:    --sp;  sp[-1] = sp[-1] <= sp[0];           break;
+      case kGreater:       --sp;  sp[-1] = sp[-1] > sp[0];            break;
+      case kGreaterEquals: --sp;  sp[-1] = sp[-1] >= sp[0];           break;
+
+      case kUnaryMinus: sp[-1] = -sp[-1];                             break;
+      case kBinNot:     sp[-1] = ~sp[-1];                             break;
+      case kLogNot:     sp[-1] = !sp[-1];                             break;
+      case kLoByte:     sp[-1] = 0xff & sp[-1];                       break;
+      case kHiByte:     sp[-1] = 0xff & (sp[-1] >> 8);                break;
+      case kBool:       sp[-1] = sp[-1] != 0;                         break;
+
+      // The left operand decides the result by itself if it's false (for
+      // &&) or true (for ||); otherwise the result is the right operand
+      case kLogAnd:
+        if(sp[-1] == 0)  i = code + i->value - 1;
+        else             --sp;
+        break;
+      case kLogOr:
+        if(sp[-1] != 0)  { sp[-1] = 1;  i = code + i->value - 1; }
+        else             --sp;
+        break;
+
+      case kReturn:
+        return sp[-1];
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ExpressionCode::emitConst(Int32 value)
+{
+  emit(kConst, value);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ExpressionCode::emitCpu(CpuMethod method)
+{
+  emit(kCpu).cpu = method;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ExpressionCode::emitCart(CartMethod method)
+{
+  emit(kCart).cart = method;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ExpressionCode::emitTia(TiaMethod method)
+{
+  emit(kTia).tia = method;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ExpressionCode::emitEval(const Expression& expression)
+{
+  emit(kEval).expression = &expression;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ExpressionCode::emitUnary(Op op, const Expression& operand)
+{
+  size_t start = myCode.size();
+  operand.compile(*this);
+
+  // Reading a constant address is the most common case by far
+  if(op == kByteDeref && myCode.size() == start + 1 &&
+     myCode[start].op == kConst)
+    myCode[start].op = kPeekConst;
+  else
+    emit(op);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ExpressionCode::emitBinary(Op op, const Expression& lhs,
+                                const Expression& rhs)
+{
+  size_t start = myCode.size();
+  lhs.compile(*this);
+  rhs.compile(*this);
+
+  // A constant address with a constant offset
+  if(op == kByteDerefOffset && myCode.size() == start + 2 &&
+     myCode[start].op == kConst && myCode[start+1].op == kConst)
+  {
+    myCode[start].op = kPeekConst;
+    myCode[start].value += myCode[start+1].value;
+    myCode.pop_back();
+    --myDepth;
+  }
+  else
+    emit(op);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ExpressionCode::emitLogical(Op op, const Expression& lhs,
+                                 const Expression& rhs)
+{
+  lhs.compile(*this);
+  size_t jump = myCode.size();
+  emit(op);
+  rhs.compile(*this);
+  emit(kBool);
+  myCode[jump].value = Int32(myCode.size());
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ExpressionCode::Instruction& ExpressionCode::emit(Op op, Int32 value)
+{
+  switch(op)
+  {
+    case kConst: case kPeekConst: case kCpu: case kCart: case kTia: case kEval:
+      ++myDepth;
+      break;
+    case kByteDeref: case kWordDeref:
+    case kUnaryMinus: case kBinNot: case kLogNot: case kLoByte: case kHiByte:
+    case kBool: case kReturn:
+      break;
+    default:  // binary operators, and the left operand of && and ||
+      --myDepth;
+      break;
+  }
+  myMaxDepth = std::max(myMaxDepth, myDepth);
+
+  Instruction instruction;
+  instruction.op = op;
+  instruction.value = value;
+  instruction.expression = nullptr;
+  myCode.push_back(instruction);
+
+  return myCode.back();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ExpressionCode::findRAMAddresses()
+{
+  myRAMOnly = true;
+  myRAMAddresses.clear();
+
+  for(const auto& i: myCode)
+  {
+    switch(i.op)
+    {
+      case kCpu: case kCart: case kTia: case kEval:
+      case kByteDeref: case kByteDerefOffset: case kWordDeref:
+        myRAMOnly = false;
+        break;
+      case kPeekConst:
+        if(isRAM(i.value))
+          myRAMAddresses.push_back(i.value & 0x7f);
+        else
+          myRAMOnly = false;
+        break;
+      default:
+        break;
+    }
+  }
+  if(!myRAMOnly)
+    myRAMAddresses.clear();
+}
@@ -0,0 +1,137 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2017 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+
+#ifndef EXPRESSION_CODE_HXX
+#define EXPRESSION_CODE_HXX
+
+class Debugger;
+
+#include "bspf.hxx"
+#include "CartDebug.hxx"
+#include "CpuDebug.hxx"
+#include "TIADebug.hxx"
+#include "Expression.hxx"
+
+/**
+  This class compiles an expression tree into a flat list of instructions
+  for a small stack machine.  Conditional breakpoints are evaluated before
+  every instruction the CPU executes, and walking the compiled code is much
+  cheaper than the virtual calls (and std::function calls) of the tree.
+
+  The expression tree itself must stay alive as long as the code, since
+  nodes which can't be compiled (labels and user functions) are evaluated
+  by calling into the tree.
+
+  The code also records whether the result depends on nothing but the
+  contents of RIOT RAM at fixed addresses; in that case the result can
+  only change when one of those bytes is written, and the CPU doesn't
+  need to evaluate it after every instruction.
+*/
+class ExpressionCode
+{
+  public:
+    enum Op : uInt8 {
+      kConst, kPeekConst, kCpu, kCart, kTia, kEval,
+      kByteDeref, kByteDerefOffset, kWordDeref,
+      kPlus, kMinus, kMult, kDiv, kMod,
+      kBinAnd, kBinOr, kBinXor, kShiftLeft, kShiftRight,
+      kEquals, kNotEquals, kLess, kLessEquals, kGreater, kGreaterEquals,
+      kUnaryMinus, kBinNot, kLogNot, kLoByte, kHiByte,
+      kLogAnd, kLogOr, kBool, kReturn
+    };
+
+    /**
+      Compile the given expression; the code refers to the expression,
+      which must outlive it.
+    */
+    explicit ExpressionCode(const Expression& expression);
+
+    /**
+      Evaluate the code; the result is the same as calling evaluate()
+      on the expression it was compiled from.
+    */
+    Int32 evaluate() const;
+
+    /**
+      Answer whether the result depends only on RIOT RAM, and which bytes
+      of it (as offsets 0 - 127) are read.
+    */
+    bool isRAMOnly() const { return myRAMOnly; }
+    const vector<uInt8>& ramAddresses() const { return myRAMAddresses; }
+
+    /**
+      Answer whether the given address refers to RIOT RAM.
+    */
+    static bool isRAM(uInt16 address) { return (address & 0x1280) == 0x0080; }
+
+    /**
+      These are used by Expression::compile() to generate the code.
+    */
+    void emitConst(Int32 value);
+    void emitCpu(CpuMethod method);
+    void emitCart(CartMethod method);
+    void emitTia(TiaMethod method);
+    void emitEval(const Expression& expression);
+    void emitUnary(Op op, const Expression& operand);
+    void emitBinary(Op op, const Expression& lhs, const Expression& rhs);
+    void emitLogical(Op op, const Expression& lhs, const Expression& rhs);
+
+  private:
+    struct Instruction {
+      Op op;
+      Int32 value;  // constant, address or jump target
+      union {
+        CpuMethod cpu;
+        CartMethod cart;
+        TiaMethod tia;
+        const Expression* expression;
+      };
+    };
+
+    // Add an instruction, keeping track of the stack depth
+    Instruction& emit(Op op, Int32 value = 0);
+
+    // Determine whether the code only reads RIOT RAM
+    void findRAMAddresses();
+
+  private:
+    // The deepest the stack may get; expressions needing more are
+    // evaluated by the tree
+    static constexpr uInt32 kMaxStack = 32;
+
+    vector<Instruction> myCode;
+    Int32 myDepth, myMaxDepth;
+
+    bool myRAMOnly;
+    vector<uInt8> myRAMAddresses;
+
+    Debugger& myDebugger;
+    CpuDebug& myCpuDebug;
+    CartDebug& myCartDebug;
+    TIADebug& myTiaDebug;
+
+  private:
+    // Following constructors and assignment operators not supported
+    ExpressionCode() = delete;
+    ExpressionCode(const ExpressionCode&) = delete;
+    ExpressionCode(ExpressionCode&&) = delete;
+    ExpressionCode& operator=(const ExpressionCode&) = delete;
+    ExpressionCode& operator=(ExpressionCode&&) = delete;
+};
+
+#endif
@@ -0,0 +1,183 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2017 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+
+#include <fstream>
+#include <iomanip>
+
+#include "Base.hxx"
+#include "Cart.hxx"
+#include "CartDebug.hxx"
+#include "Console.hxx"
+#include "TIA.hxx"
+#include "TIAWriteLog.hxx"
+
+using Common::Base;
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TIAWriteLog::TIAWriteLog(const Console& console)
+  : myTIA(console.tia()),
+    myCart(console.cartridge()),
+    myIsRecording(false),
+    myCurrent(0),
+    myNumFrames(0)
+{
+  memset(myFrames, 0, sizeof(myFrames));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIAWriteLog::start()
+{
+  // The buffer is only allocated when it's first needed, but then kept
+  // so that nothing is allocated while logging
+  if(!myWrites)
+    myWrites = make_unique<Write[]>(kFrames * kMaxWrites);
+
+  myCurrent = myNumFrames = 0;
+  myIsRecording = true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIAWriteLog::stop()
+{
+  myIsRecording = false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIAWriteLog::add(uInt8 reg, uInt8 value, uInt16 pc)
+{
+  const uInt32 number = myTIA.frameCount();
+  if(myNumFrames == 0 || number != myFrames[myCurrent].number)
+    newFrame(number);
+
+  FrameInfo& info = myFrames[myCurrent];
+  if(info.count == kMaxWrites)
+  {
+    ++info.dropped;
+    return;
+  }
+
+  uInt32 scanline, clock, x, y;
+  myTIA.beamPosition(scanline, clock);
+  if(!myTIA.electronBeamPos(x, y))
+    y = kNotVisible;
+
+  Write& w = myWrites[myCurrent * kMaxWrites + info.count++];
+  w.pc = pc;
+  w.bank = myCart.getBank();
+  w.scanline = uInt16(scanline);
+  w.y = uInt16(y);
+  w.clock = uInt8(clock);
+  w.reg = reg;
+  w.value = value;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TIAWriteLog::Frame TIAWriteLog::frame(uInt32 ago) const
+{
+  Frame f = { 0, 0, 0, nullptr };
+  if(ago < myNumFrames)
+  {
+    const uInt32 i = (myCurrent + kFrames - ago) % kFrames;
+    f.number = myFrames[i].number;
+    f.count = myFrames[i].count;
+    f.dropped = myFrames[i].dropped;
+    f.writes = &myWrites[i * kMaxWrites];
+  }
+  return f;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIAWriteLog::dump(ostream& out, uInt32 count, const CartDebug& dbg) const
+{
+  // Find the frame the oldest write to show is in
+  uInt32 ago = 0, skip = 0;
+  for(uInt32 n = 0; ago < myNumFrames; ++ago)
+  {
+    const Frame f = frame(ago);
+    if(n + f.count >= count || ago + 1 == myNumFrames)
+    {
+      skip = n + f.count > count ? n + f.count - count : 0;
+      break;
+    }
+    n += f.count;
+  }
+
+  const std::ios_base::fmtflags flags = out.flags();
+  out << " frame line  clk register value  bank addr  label" << endl;
+  for(uInt32 i = ago + 1; i-- > 0; skip = 0)
+  {
+    const Frame f = frame(i);
+    for(uInt32 w = skip; w < f.count; ++w)
+      dumpWrite(out, f.number, f.writes[w], dbg);
+    if(f.dropped > 0)
+      out << std::dec << f.dropped << " more writes in frame " << f.number
+          << " not logged" << endl;
+  }
+  out.flags(flags);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIAWriteLog::save(const string& filename, const CartDebug& dbg) const
+{
+  ofstream out(filename);
+  if(!out.is_open())
+    throw runtime_error("Unable to save TIA log to " + filename);
+
+  out << "frame,scanline,clock,register,value,bank,address,label" << endl;
+  for(uInt32 i = myNumFrames; i-- > 0; )
+  {
+    const Frame f = frame(i);
+    for(uInt32 w = 0; w < f.count; ++w)
+    {
+      const Write& write = f.writes[w];
+      out << std::dec << f.number << "," << write.scanline << ","
+          << uInt32(write.clock) << "," << dbg.getLabel(write.reg, false)
+          << ",$" << Base::HEX2 << uInt32(write.value) << "," << std::dec
+          << write.bank << ",$" << Base::HEX4 << write.pc << ","
+          << dbg.getLabel(write.pc, true) << endl;
+    }
+  }
+
+  if(!out)
+    throw runtime_error("Unable to save TIA log to " + filename);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIAWriteLog::newFrame(uInt32 number)
+{
+  if(myNumFrames > 0)
+    myCurrent = (myCurrent + 1) % kFrames;
+  if(myNumFrames < kFrames)
+    ++myNumFrames;
+
+  FrameInfo& info = myFrames[myCurrent];
+  info.number = number;
+  info.count = info.dropped = 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIAWriteLog::dumpWrite(ostream& out, uInt32 frame, const Write& w,
+                            const CartDebug& dbg) const
+{
+  out << std::dec << std::setfill(' ') << std::setw(6) << frame << " "
+      << std::setw(4) << w.scanline << " " << std::setw(4) << uInt32(w.clock)
+      << " " << std::setw(8) << std::left << dbg.getLabel(w.reg, false)
+      << std::right << "  $" << Base::HEX2 << uInt32(w.value) << "  "
+      << std::setw(4) << std::setfill(' ') << std::dec << w.bank << " "
+      << Base::HEX4 << w.pc << "  " << dbg.getLabel(w.pc, true) << endl;
+}
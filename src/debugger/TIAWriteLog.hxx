@@ -0,0 +1,141 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2017 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+
+#ifndef TIA_WRITE_LOG_HXX
+#define TIA_WRITE_LOG_HXX
+
+class Console;
+class CartDebug;
+class Cartridge;
+class TIA;
+
+#include "bspf.hxx"
+
+/**
+  This class logs every write to the TIA, along with the beam position
+  at the time and the instruction which did it, which shows the timing
+  of a kernel at a glance.  The writes of the last kFrames frames are
+  kept, each frame in its own preallocated part of the buffer, so logging
+  a write is only a few memory writes and it can be left running while
+  playing normally.
+
+  The debugger shows the writes of the displayed frame as marks on the
+  TIA output, and the log can be dumped and saved as a CSV file.
+*/
+class TIAWriteLog
+{
+  public:
+    // One write to a TIA register
+    struct Write {
+      uInt16 pc, bank;  // the instruction writing, and its bank
+      uInt16 scanline;  // the scanline, counted from the start of the frame
+      uInt16 y;         // the line in the frame buffer, or kNotVisible
+      uInt8 clock;      // the color clock within the scanline
+      uInt8 reg;        // the register written (0 - $3f)
+      uInt8 value;
+    };
+
+    // The writes of one frame, oldest first
+    struct Frame {
+      uInt32 number;   // the TIA frame number
+      uInt32 count;    // the number of writes logged
+      uInt32 dropped;  // the number of writes which didn't fit
+      const Write* writes;
+    };
+
+    enum {
+      kFrames = 64,            // about a second of frames
+      kMaxWrites = 4096,       // per frame, more than most kernels do
+      kNotVisible = 0xffff
+    };
+
+    TIAWriteLog(const Console& console);
+
+    /**
+      Start or stop logging; starting discards the previous log.
+    */
+    void start();
+    void stop();
+    bool isRecording() const { return myIsRecording; }
+
+    /**
+      Called by the TIA for every write while logging, after its
+      emulation has caught up with the CPU.
+
+      @param reg    The register written
+      @param value  The value written
+      @param pc     The address of the instruction writing
+    */
+    void add(uInt8 reg, uInt8 value, uInt16 pc);
+
+    /**
+      Answer the number of frames logged, and the writes of the given
+      frame, where 0 is the most recent one (which may be incomplete).
+    */
+    uInt32 frames() const { return myNumFrames; }
+    Frame frame(uInt32 ago) const;
+
+    /**
+      Show the given number of the most recent writes.
+    */
+    void dump(ostream& out, uInt32 count, const CartDebug& dbg) const;
+
+    /**
+      Save the whole log as a CSV file, oldest write first.
+
+      @return  On failure, a runtime_error is thrown
+    */
+    void save(const string& filename, const CartDebug& dbg) const;
+
+  private:
+    // Start logging a new frame, overwriting the oldest one if necessary
+    void newFrame(uInt32 number);
+
+    // Write a single line of the dump
+    void dumpWrite(ostream& out, uInt32 frame, const Write& w,
+                   const CartDebug& dbg) const;
+
+  private:
+    struct FrameInfo {
+      uInt32 number;
+      uInt32 count;
+      uInt32 dropped;
+    };
+
+    const TIA& myTIA;
+    const Cartridge& myCart;
+
+    bool myIsRecording;
+
+    // The writes, kMaxWrites for each frame
+    unique_ptr<Write[]> myWrites;
+
+    FrameInfo myFrames[kFrames];
+    uInt32 myCurrent;     // the frame being logged
+    uInt32 myNumFrames;   // the number of frames logged
+
+  private:
+    // Following constructors and assignment operators not supported
+    TIAWriteLog() = delete;
+    TIAWriteLog(const TIAWriteLog&) = delete;
+    TIAWriteLog(TIAWriteLog&&) = delete;
+    TIAWriteLog& operator=(const TIAWriteLog&) = delete;
+    TIAWriteLog& operator=(TIAWriteLog&&) = delete;
+};
+
+#endif
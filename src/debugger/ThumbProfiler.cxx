@@ -0,0 +1,256 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2017 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
+#include "Base.hxx"
+#include "ThumbProfiler.hxx"
+
+using Common::Base;
+
+namespace {
+  const char* const ourRegionNames[ThumbProfiler::kNumRegions] = {
+    "flash", "RAM", "peripherals"
+  };
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ThumbProfiler::ThumbProfiler()
+  : myRuns(0),
+    myTotalInstructions(0),
+    myTotalCycles(0),
+    myIsProfiling(false)
+{
+  memset(myTraffic, 0, sizeof(myTraffic));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ThumbProfiler::start()
+{
+  myCounters.assign((kFlashSize + kRAMSize) / 2, Counter());
+  memset(myTraffic, 0, sizeof(myTraffic));
+  myRuns = 0;
+  myTotalInstructions = myTotalCycles = 0;
+  myIsProfiling = true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ThumbProfiler::stop()
+{
+  myIsProfiling = false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ThumbProfiler::addRun(uInt32 address)
+{
+  ++myRuns;
+  addCall(address);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ThumbProfiler::addInstruction(uInt32 address, uInt32 cycles)
+{
+  ++myTotalInstructions;
+  myTotalCycles += cycles;
+
+  uInt32 i = index(address);
+  if(i != kNoIndex)
+  {
+    ++myCounters[i].instructions;
+    myCounters[i].cycles += cycles;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ThumbProfiler::addCall(uInt32 address)
+{
+  uInt32 i = index(address);
+  if(i != kNoIndex)
+    ++myCounters[i].calls;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ThumbProfiler::addTraffic(const uInt64* fetches, const uInt64* reads,
+                               const uInt64* writes)
+{
+  static constexpr uInt32 top[kNumRegions] = { 0x0, 0x4, 0xE };
+  for(int r = 0; r < kNumRegions; ++r)
+  {
+    myTraffic[r].fetches += fetches[top[r]];
+    myTraffic[r].reads   += reads[top[r]];
+    myTraffic[r].writes  += writes[top[r]];
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ThumbProfiler::dump(ostream& out, uInt32 count) const
+{
+  out << std::dec << myRuns << " runs, " << myTotalInstructions
+      << " instructions, " << myTotalCycles << " cycles (estimated)" << endl;
+  if(myTotalInstructions == 0)
+    return;
+
+  const std::ios_base::fmtflags flags = out.flags();
+  const std::streamsize precision = out.precision();
+
+  out << "  region          fetches        reads       writes" << endl;
+  for(int r = 0; r < kNumRegions; ++r)
+    out << "  " << std::setw(11) << std::left << ourRegionNames[r]
+        << std::right << std::setw(12) << myTraffic[r].fetches << " "
+        << std::setw(12) << myTraffic[r].reads << " "
+        << std::setw(12) << myTraffic[r].writes << endl;
+
+  // The instructions taking the most time
+  vector<uInt32> executed;
+  for(uInt32 i = 0; i < myCounters.size(); ++i)
+    if(myCounters[i].instructions > 0)
+      executed.push_back(i);
+  uInt32 n = std::min(count, uInt32(executed.size()));
+  std::partial_sort(executed.begin(), executed.begin() + n, executed.end(),
+      [this](uInt32 a, uInt32 b) {
+        return myCounters[a].cycles > myCounters[b].cycles;
+      });
+
+  out << "  address        cycles      %  executed" << endl;
+  for(uInt32 i = 0; i < n; ++i)
+  {
+    const Counter& c = myCounters[executed[i]];
+    out << "  " << Base::HEX8 << address(executed[i]) << std::dec
+        << std::setw(14) << std::setfill(' ') << c.cycles << " "
+        << std::fixed << std::setprecision(2) << std::setw(6)
+        << (100.0 * c.cycles / myTotalCycles) << " "
+        << std::setw(9) << c.instructions << endl;
+  }
+
+  // The functions called most often
+  vector<Function> called = functions();
+  n = std::min(count, uInt32(called.size()));
+  std::partial_sort(called.begin(), called.begin() + n, called.end(),
+      [](const Function& a, const Function& b) { return a.calls > b.calls; });
+
+  out << "  function        calls        cycles      %" << endl;
+  for(uInt32 i = 0; i < n; ++i)
+  {
+    const Function& f = called[i];
+    out << "  " << Base::HEX8 << f.address << std::dec
+        << std::setw(13) << std::setfill(' ') << f.calls << " "
+        << std::setw(13) << f.cycles << " " << std::fixed
+        << std::setprecision(2) << std::setw(6)
+        << (100.0 * f.cycles / myTotalCycles) << endl;
+  }
+  out.flags(flags);
+  out.precision(precision);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ThumbProfiler::saveCSV(const string& filename) const
+{
+  ofstream out(filename);
+  if(!out.is_open())
+    throw runtime_error("Unable to save ARM profile to " + filename);
+
+  // Each instruction is listed with the function it belongs to
+  const vector<Function> called = functions();
+  auto function = called.cbegin();
+
+  out << "address,function,executed,cycles,calls,percent" << endl;
+  for(uInt32 i = 0; i < myCounters.size(); ++i)
+  {
+    const uInt32 addr = address(i);
+    while(function + 1 != called.cend() && (function + 1)->address <= addr)
+      ++function;
+
+    const Counter& c = myCounters[i];
+    if(c.instructions == 0 && c.calls == 0)
+      continue;
+
+    out << "$" << Base::HEX8 << addr << ",";
+    if(function != called.cend() && function->address <= addr &&
+       ((function->address ^ addr) & 0xF0000000) == 0)
+      out << "$" << Base::HEX8 << function->address;
+    out << "," << std::dec << c.instructions << "," << c.cycles << ","
+        << c.calls << ","
+        << (myTotalCycles ? 100.0 * c.cycles / myTotalCycles : 0.0) << endl;
+  }
+
+  // The memory accesses go into a separate file
+  string::size_type dot = filename.find_last_of('.');
+  string::size_type sep = filename.find_last_of("/\\");
+  string memname = (dot != string::npos && (sep == string::npos || dot > sep))
+      ? filename.substr(0, dot) + "_memory" + filename.substr(dot)
+      : filename + "_memory";
+  ofstream memory(memname);
+  if(!memory.is_open())
+    throw runtime_error("Unable to save ARM profile to " + memname);
+
+  memory << "region,fetches,reads,writes" << endl;
+  for(int r = 0; r < kNumRegions; ++r)
+    memory << ourRegionNames[r] << "," << myTraffic[r].fetches << ","
+           << myTraffic[r].reads << "," << myTraffic[r].writes << endl;
+
+  if(!out || !memory)
+    throw runtime_error("Unable to save ARM profile to " + filename);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 ThumbProfiler::index(uInt32 address)
+{
+  switch(address & 0xF0000000)
+  {
+    case 0x00000000:  // flash
+      return address < kFlashSize ? address >> 1 : kNoIndex;
+
+    case 0x40000000:  // RAM
+      address &= 0x0FFFFFFF;
+      return address < kRAMSize ? (kFlashSize + address) >> 1 : kNoIndex;
+
+    default:
+      return kNoIndex;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 ThumbProfiler::address(uInt32 index)
+{
+  index <<= 1;
+  return index < kFlashSize ? index : 0x40000000 + index - kFlashSize;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+vector<ThumbProfiler::Function> ThumbProfiler::functions() const
+{
+  // A function is assumed to extend up to the next one called (or to the
+  // end of the region); this is exact for code which is only entered
+  // through calls, as compiled code normally is
+  vector<Function> called;
+  for(uInt32 i = 0; i < myCounters.size(); ++i)
+  {
+    if(i == kFlashSize / 2 && !called.empty())
+      called.push_back(Function{ address(i), 0, 0 });  // marks end of flash
+    if(myCounters[i].calls > 0)
+      called.push_back(Function{ address(i), myCounters[i].calls, 0 });
+    if(!called.empty())
+      called.back().cycles += myCounters[i].cycles;
+  }
+  called.erase(std::remove_if(called.begin(), called.end(),
+      [](const Function& f) { return f.calls == 0; }), called.end());
+
+  return called;
+}
@@ -0,0 +1,145 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2017 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+
+#ifndef THUMB_PROFILER_HXX
+#define THUMB_PROFILER_HXX
+
+#include "bspf.hxx"
+
+/**
+  This class profiles the ARM code run by the Thumbulator, for the
+  cartridges with a Harmony/Melody coprocessor (DPC+, CDF and BUS).
+  Instructions and cycles are counted for each ARM address, along with
+  the number of times each function was called (through BL/BLX, or as
+  the entry point of a run), and the memory accesses made to each region.
+
+  The Thumbulator doesn't emulate the timing of the ARM, so the cycles
+  are estimated as the number of memory accesses made by an instruction
+  (including its fetch).  This ignores wait states, but is good enough
+  to compare the cost of different parts of the code.
+
+  The Thumbulator only uses a profiler while it is profiling, and checks
+  for that once per run, so it costs nothing otherwise.
+*/
+class ThumbProfiler
+{
+  public:
+    // The time spent on one instruction
+    struct Counter {
+      uInt64 instructions;  // number of times executed
+      uInt64 cycles;        // estimated, as explained above
+      uInt32 calls;         // number of times called as a function
+    };
+
+    // The memory regions seen by the ARM
+    enum Region { kFlash, kRAM, kPeripherals, kNumRegions };
+
+    // The accesses made to one region
+    struct Traffic {
+      uInt64 fetches, reads, writes;
+    };
+
+    ThumbProfiler();
+
+    /**
+      Start or stop profiling; starting discards the previous results.
+    */
+    void start();
+    void stop();
+    bool isProfiling() const { return myIsProfiling; }
+
+    /**
+      Called by the Thumbulator at the start of each run (each call from
+      the 6507), for each instruction executed and for each function
+      called.  The address is that of the (first) instruction.
+    */
+    void addRun(uInt32 address);
+    void addInstruction(uInt32 address, uInt32 cycles);
+    void addCall(uInt32 address);
+
+    /**
+      Called by the Thumbulator at the end of each run, with the memory
+      accesses made, indexed by the top 4 bits of the address.
+    */
+    void addTraffic(const uInt64* fetches, const uInt64* reads,
+                    const uInt64* writes);
+
+    /**
+      Answer the number of instructions profiled.
+    */
+    uInt64 totalInstructions() const { return myTotalInstructions; }
+
+    /**
+      Write a summary, listing the memory accesses, the instructions with
+      the most cycles and the functions called most often.
+
+      @param out    The stream to write to
+      @param count  The number of instructions and functions to list
+    */
+    void dump(ostream& out, uInt32 count) const;
+
+    /**
+      Save the results as CSV files; the memory accesses go to a second
+      file, named like the first one with '_memory' appended to its base
+      name.
+
+      @return  On failure, a runtime_error is thrown containing a more
+               detailed error message.
+    */
+    void saveCSV(const string& filename) const;
+
+  private:
+    // A function, and the cycles spent in it (up to the next function)
+    struct Function {
+      uInt32 address;
+      uInt32 calls;
+      uInt64 cycles;
+    };
+
+    // Convert between ARM addresses and counter indices (kNoIndex when
+    // code can't be executed at the address)
+    static uInt32 index(uInt32 address);
+    static uInt32 address(uInt32 index);
+
+    // Answer all functions called, in address order
+    vector<Function> functions() const;
+
+  private:
+    // Code is executed from flash or from RAM
+    static constexpr uInt32 kFlashSize = 0x8000;
+    static constexpr uInt32 kRAMSize = 0x2000;
+    static constexpr uInt32 kNoIndex = ~0u;
+
+    // One counter for each halfword of flash and RAM
+    vector<Counter> myCounters;
+
+    Traffic myTraffic[kNumRegions];
+
+    uInt32 myRuns;
+    uInt64 myTotalInstructions, myTotalCycles;
+    bool myIsProfiling;
+
+  private:
+    // Following constructors and assignment operators not supported
+    ThumbProfiler(const ThumbProfiler&) = delete;
+    ThumbProfiler(ThumbProfiler&&) = delete;
+    ThumbProfiler& operator=(const ThumbProfiler&) = delete;
+    ThumbProfiler& operator=(ThumbProfiler&&) = delete;
+};
+
+#endif
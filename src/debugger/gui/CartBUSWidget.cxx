@@ -18,6 +18,7 @@
 #include "CartBUS.hxx"
 #include "DataGridWidget.hxx"
 #include "PopUpWidget.hxx"
+#include "Thumbulator.hxx"
 #include "CartBUSWidget.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -459,3 +460,11 @@ uInt8 CartridgeBUSWidget::internalRamGetValue(int addr)
 {
   return myCart.myBUSRAM[addr];
 }
+
+#ifdef THUMB_SUPPORT
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ThumbProfiler* CartridgeBUSWidget::armProfiler()
+{
+  return &myCart.myThumbEmulator->profiler();
+}
+#endif
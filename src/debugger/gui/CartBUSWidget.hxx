@@ -88,6 +88,10 @@ class CartridgeBUSWidget : public CartDebugWidget
     uInt8 internalRamGetValue(int addr) override;
     // end of functions for Cartridge RAM tab
 
+#ifdef THUMB_SUPPORT
+    ThumbProfiler* armProfiler() override;
+#endif
+
     // Following constructors and assignment operators not supported
     CartridgeBUSWidget() = delete;
     CartridgeBUSWidget(const CartridgeBUSWidget&) = delete;
@@ -18,6 +18,7 @@
 #include "CartCDF.hxx"
 #include "DataGridWidget.hxx"
 #include "PopUpWidget.hxx"
+#include "Thumbulator.hxx"
 #include "CartCDFWidget.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -422,3 +423,11 @@ uInt8 CartridgeCDFWidget::internalRamGetValue(int addr)
 {
   return myCart.myCDFRAM[addr];
 }
+
+#ifdef THUMB_SUPPORT
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ThumbProfiler* CartridgeCDFWidget::armProfiler()
+{
+  return &myCart.myThumbEmulator->profiler();
+}
+#endif
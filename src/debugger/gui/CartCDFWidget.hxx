@@ -89,6 +89,10 @@ class CartridgeCDFWidget : public CartDebugWidget
     uInt8 internalRamGetValue(int addr) override;
     // end of functions for Cartridge RAM tab
 
+#ifdef THUMB_SUPPORT
+    ThumbProfiler* armProfiler() override;
+#endif
+
     // Following constructors and assignment operators not supported
     CartridgeCDFWidget() = delete;
     CartridgeCDFWidget(const CartridgeCDFWidget&) = delete;
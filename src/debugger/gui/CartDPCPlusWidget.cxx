@@ -18,6 +18,7 @@
 #include "CartDPCPlus.hxx"
 #include "DataGridWidget.hxx"
 #include "PopUpWidget.hxx"
+#include "Thumbulator.hxx"
 #include "CartDPCPlusWidget.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -388,3 +389,11 @@ uInt8 CartridgeDPCPlusWidget::internalRamGetValue(int addr)
 {
   return myCart.myDisplayImage[addr];
 }
+
+#ifdef THUMB_SUPPORT
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ThumbProfiler* CartridgeDPCPlusWidget::armProfiler()
+{
+  return &myCart.myThumbEmulator->profiler();
+}
+#endif
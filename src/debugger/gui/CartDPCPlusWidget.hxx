@@ -87,6 +87,10 @@ class CartridgeDPCPlusWidget : public CartDebugWidget
     uInt8 internalRamGetValue(int addr) override;
     // end of functions for Cartridge RAM tab
 
+#ifdef THUMB_SUPPORT
+    ThumbProfiler* armProfiler() override;
+#endif
+
     // Following constructors and assignment operators not supported
     CartridgeDPCPlusWidget() = delete;
     CartridgeDPCPlusWidget(const CartridgeDPCPlusWidget&) = delete;
@@ -20,6 +20,7 @@
 
 class GuiObject;
 class ButtonWidget;
+class ThumbProfiler;
 
 #include "Base.hxx"
 #include "Font.hxx"
@@ -123,6 +124,10 @@ class CartDebugWidget : public Widget, public CommandSender
     virtual uInt8 internalRamGetValue(int addr) { return 0; }
     virtual string internalRamLabel(int addr) { return "Not available/applicable"; }
 
+    // To make the ARM profile show up in the debugger, return the profiler
+    // of the ARM emulation for cartridges with an ARM coprocessor
+    virtual ThumbProfiler* armProfiler() { return nullptr; }
+
   protected:
     // Arrays used to hold current and previous internal RAM values
     ByteArray myRamOld, myRamCurrent;
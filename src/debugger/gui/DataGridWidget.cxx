@@ -123,19 +123,20 @@ cerr << "alist.size() = "     << alist.size()
   int size = int(vlist.size());  // assume the alist is the same size
   assert(size == _rows * _cols);
 
-  _addrList.clear();
-  _valueList.clear();
-  _valueStringList.clear();
-  _changedList.clear();
+  // An efficiency thing
+  StringList strings;
+  for(int i = 0; i < size; ++i)
+    strings.push_back(Common::Base::toString(vlist[i], _base));
+
+  // Nothing needs to be redrawn when nothing changed
+  if(alist == _addrList && vlist == _valueList && changed == _changedList &&
+     strings == _valueStringList)
+    return;
 
   _addrList    = alist;
   _valueList   = vlist;
   _changedList = changed;
-
-  // An efficiency thing
-  string temp;
-  for(int i = 0; i < size; ++i)
-    _valueStringList.push_back(Common::Base::toString(_valueList[i], _base));
+  _valueStringList = std::move(strings);
 
 /*
 cerr << "_addrList.size() = "     << _addrList.size()
@@ -30,6 +30,7 @@
 #include "TiaWidget.hxx"
 #include "CartDebugWidget.hxx"
 #include "CartRamWidget.hxx"
+#include "ThumbProfilerWidget.hxx"
 #include "DataGridOpsWidget.hxx"
 #include "EditTextWidget.hxx"
 #include "MessageBox.hxx"
@@ -48,7 +49,8 @@ DebuggerDialog::DebuggerDialog(OSystem& osystem, DialogContainer& parent,
   : Dialog(osystem, parent, x, y, w, h),
     myTab(nullptr),
     myRomTab(nullptr),
-    myFatalError(nullptr)
+    myFatalError(nullptr),
+    myRefreshPending(false)
 {
   createFont();  // Font is sized according to available space
 
@@ -75,6 +77,30 @@ void DebuggerDialog::loadConfig()
   myMessageBox->setText("");
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void DebuggerDialog::drawDialog()
+{
+  loadPendingConfig();
+  Dialog::drawDialog();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool DebuggerDialog::drawChanges()
+{
+  loadPendingConfig();
+  return Dialog::drawChanges();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void DebuggerDialog::loadPendingConfig()
+{
+  if(myRefreshPending)
+  {
+    myRefreshPending = false;
+    loadConfig();
+  }
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void DebuggerDialog::handleKeyDown(StellaKey key, StellaMod mod)
 {
@@ -446,6 +472,18 @@ void DebuggerDialog::addRomArea()
         myCartRam->setOpsWidget(ops);
       }
     }
+
+    // The ARM profile tab, for cartridges with an ARM coprocessor
+    if(myCartDebug->armProfiler())
+    {
+      tabID = myRomTab->addTab(" ARM Profile ");
+      ThumbProfilerWidget* profile =
+        new ThumbProfilerWidget(myRomTab, *myLFont, *myNFont, 2, 2, tabWidth - 1,
+                tabHeight - myRomTab->getTabHeight() - 2,
+                *myCartDebug->armProfiler());
+      myRomTab->setParentWidget(tabID, profile);
+      addToFocusList(profile->getFocusList(), myRomTab, tabID);
+    }
   }
 
   myRomTab->setActiveTab(0);
@@ -65,8 +65,20 @@ class DebuggerDialog : public Dialog
 
     void showFatalMessage(const string& msg);
 
+    /**
+      Reload the widgets from the current state before the dialog is next
+      drawn.  However many commands request this in between, the widgets
+      are reloaded (and redrawn) only once per frame.
+    */
+    void requestRefresh() { myRefreshPending = true; }
+
   private:
     void loadConfig() override;
+    void drawDialog() override;
+    bool drawChanges() override;
+
+    // Reload the widgets if a refresh was requested
+    void loadPendingConfig();
     void handleKeyDown(StellaKey key, StellaMod mod) override;
     void handleCommand(CommandSender* sender, int cmd, int data, int id) override;
 
@@ -115,6 +127,9 @@ class DebuggerDialog : public Dialog
     ButtonWidget*    myRewindButton;
     unique_ptr<GUI::MessageBox> myFatalError;
 
+    // Whether the widgets must be reloaded before the next draw
+    bool myRefreshPending;
+
     unique_ptr<GUI::Font> myLFont;  // used for labels
     unique_ptr<GUI::Font> myNFont;  // used for normal text
 
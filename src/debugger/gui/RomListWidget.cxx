@@ -15,7 +15,10 @@
 // this file, and for a DISCLAIMER OF ALL WARRANTIES.
 //============================================================================
 
+#include <cmath>
+
 #include "bspf.hxx"
+#include "CycleProfiler.hxx"
 #include "Debugger.hxx"
 #include "DiStella.hxx"
 #include "PackedBitArray.hxx"
@@ -469,6 +472,11 @@ void RomListWidget::drawWidget(bool hilite)
   if(actualwidth < small_disasmw)
     small_disasmw = actualwidth;
 
+  // Instructions which were profiled get a bar below their label, with
+  // a length on a logarithmic scale (relative to the slowest instruction)
+  const CycleProfiler& profiler = Debugger::debugger().cycleProfiler();
+  const double maxHeat = std::log(1.0 + profiler.maxCycles());
+
   xpos = _x + CheckboxWidget::boxSize() + 10;  ypos = _y + 2;
   for (i = 0, pos = _currentPos; i < _rows && pos < len; i++, pos++, ypos += _fontHeight)
   {
@@ -490,6 +498,17 @@ void RomListWidget::drawWidget(bool hilite)
         s.frameRect(_x + r.x() - 3, ypos - 1, r.width(), _fontHeight, kTextColorHi);
     }
 
+    // Draw the profiling bar
+    if(maxHeat > 0 && dlist[pos].type == CartDebug::CODE)
+    {
+      const CycleProfiler::Counter* c = profiler.counter(dlist[pos].address);
+      if(c)
+      {
+        int w = std::max(1, int(_labelWidth * std::log(1.0 + c->cycles) / maxHeat));
+        s.fillRect(xpos, ypos + _fontHeight - 3, w, 2, kDbgChangedColor);
+      }
+    }
+
     // Draw labels
     s.drawString(_font, dlist[pos].label, xpos, ypos, _labelWidth,
                  dlist[pos].hllabel ? kTextColor : kColor);
@@ -0,0 +1,133 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2017 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+
+#include "FSNode.hxx"
+#include "OSystem.hxx"
+#include "Console.hxx"
+#include "Props.hxx"
+#include "StringListWidget.hxx"
+#include "ThumbProfiler.hxx"
+#include "ThumbProfilerWidget.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ThumbProfilerWidget::ThumbProfilerWidget(
+      GuiObject* boss, const GUI::Font& lfont, const GUI::Font& nfont,
+      int x, int y, int w, int h, ThumbProfiler& profiler)
+  : Widget(boss, lfont, x, y, w, h),
+    CommandSender(boss),
+    myProfiler(profiler)
+{
+  const int lineHeight = lfont.getLineHeight(),
+            buttonHeight = lineHeight + 4;
+  int xpos = 2, ypos = 5;
+
+  myProfile = new CheckboxWidget(boss, lfont, xpos, ypos + 2,
+                                 "Profile ARM code", kProfileCmd);
+  myProfile->setTarget(this);
+  addFocusWidget(myProfile);
+
+  const int bwidth = lfont.getStringWidth("Save CSV") + 20;
+  mySave = new ButtonWidget(boss, lfont, w - bwidth - 10, ypos, bwidth,
+                            buttonHeight, "Save CSV", kSaveCmd);
+  mySave->setTarget(this);
+  addFocusWidget(mySave);
+  ypos += buttonHeight + 4;
+
+  myStatus = new StaticTextWidget(boss, lfont, xpos, ypos, w - 12,
+                                  lfont.getFontHeight(), "", kTextAlignLeft);
+  ypos += lineHeight + 4;
+
+  myResults = new StringListWidget(boss, nfont, xpos, ypos, w - 12,
+                                   h - ypos - 4, false);
+  myResults->setEditable(false);
+  addFocusWidget(myResults);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ThumbProfilerWidget::loadConfig()
+{
+  myProfile->setState(myProfiler.isProfiling());
+
+  // The report is only built while this tab is visible
+  ostringstream buf;
+  myProfiler.dump(buf, 50);
+
+  StringList lines;
+  istringstream in(buf.str());
+  string line;
+  while(getline(in, line))
+    lines.push_back(line);
+  myResults->updateList(lines);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ThumbProfilerWidget::handleCommand(CommandSender* sender, int cmd,
+                                        int data, int id)
+{
+  switch(cmd)
+  {
+    case kProfileCmd:
+      if(myProfile->getState())
+      {
+        myProfiler.start();
+        myStatus->setLabel("Profiling started, run the emulation to collect results");
+      }
+      else
+      {
+        myProfiler.stop();
+        myStatus->setLabel("Profiling stopped");
+      }
+      loadConfig();
+      break;
+
+    case kSaveCmd:
+      saveResults();
+      break;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ThumbProfilerWidget::saveResults()
+{
+  if(myProfiler.totalInstructions() == 0)
+  {
+    myStatus->setLabel("No ARM code profiled");
+    return;
+  }
+
+  const string& path = instance().defaultSaveDir() +
+      instance().console().properties().get(Cartridge_Name) + "_armprofile";
+  string name = path + ".csv";
+  for(uInt32 i = 1; FilesystemNode(name).exists(); ++i)
+  {
+    ostringstream buf;
+    buf << path << "_" << i << ".csv";
+    name = buf.str();
+  }
+
+  FilesystemNode node(name);
+  try
+  {
+    myProfiler.saveCSV(node.getPath());
+    myStatus->setLabel("Saved ARM profile to " + node.getShortPath());
+  }
+  catch(const runtime_error& e)
+  {
+    myStatus->setLabel(e.what());
+  }
+}
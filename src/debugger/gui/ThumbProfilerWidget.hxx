@@ -0,0 +1,75 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2017 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+
+#ifndef THUMB_PROFILER_WIDGET_HXX
+#define THUMB_PROFILER_WIDGET_HXX
+
+class GuiObject;
+class ButtonWidget;
+class CheckboxWidget;
+class StaticTextWidget;
+class StringListWidget;
+class ThumbProfiler;
+
+#include "Widget.hxx"
+#include "Command.hxx"
+
+/**
+  Shows the results of profiling the ARM code of the cartridges with an
+  ARM coprocessor (see ThumbProfiler), and allows profiling to be turned
+  on and off, and the results to be saved.
+*/
+class ThumbProfilerWidget : public Widget, public CommandSender
+{
+  public:
+    ThumbProfilerWidget(GuiObject* boss, const GUI::Font& lfont,
+                        const GUI::Font& nfont,
+                        int x, int y, int w, int h, ThumbProfiler& profiler);
+    virtual ~ThumbProfilerWidget() = default;
+
+    void loadConfig() override;
+
+  private:
+    void handleCommand(CommandSender* sender, int cmd, int data, int id) override;
+
+    // Save the results in the default save location
+    void saveResults();
+
+  private:
+    enum {
+      kProfileCmd = 'TPpr',
+      kSaveCmd    = 'TPsv'
+    };
+
+    ThumbProfiler& myProfiler;
+
+    CheckboxWidget* myProfile;
+    ButtonWidget* mySave;
+    StaticTextWidget* myStatus;
+    StringListWidget* myResults;
+
+  private:
+    // Following constructors and assignment operators not supported
+    ThumbProfilerWidget() = delete;
+    ThumbProfilerWidget(const ThumbProfilerWidget&) = delete;
+    ThumbProfilerWidget(ThumbProfilerWidget&&) = delete;
+    ThumbProfilerWidget& operator=(const ThumbProfilerWidget&) = delete;
+    ThumbProfilerWidget& operator=(ThumbProfilerWidget&&) = delete;
+};
+
+#endif
@@ -28,6 +28,7 @@
 #include "TIADebug.hxx"
 #include "TIASurface.hxx"
 #include "TIA.hxx"
+#include "TIAWriteLog.hxx"
 
 #include "TiaOutputWidget.hxx"
 
@@ -38,7 +39,11 @@ TiaOutputWidget::TiaOutputWidget(GuiObject* boss, const GUI::Font& font,
     CommandSender(boss),
     myZoom(nullptr),
     myClickX(0),
-    myClickY(0)
+    myClickY(0),
+    myImageHash(0),
+    myImageScanOffset(~0u),
+    myDrawnFrame(0),
+    myDrawnWrites(0)
 {
   // Create context menu for commands
   VariantList l;
@@ -52,7 +57,34 @@ TiaOutputWidget::TiaOutputWidget(GuiObject* boss, const GUI::Font& font,
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TiaOutputWidget::loadConfig()
 {
-  setDirty();
+  // This is the most expensive widget to draw, so it's only drawn again
+  // when the image, the beam position or the logged writes changed
+  uInt32 scanx, scany, scanoffset;
+  beamPosition(scanx, scany, scanoffset);
+
+  if(scanoffset != myImageScanOffset ||
+     instance().console().tia().frameCount() != myDrawnFrame ||
+     loggedWrites() != myDrawnWrites ||
+     instance().frameBuffer().tiaSurface().fingerprint() != myImageHash)
+    setDirty();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool TiaOutputWidget::beamPosition(uInt32& scanx, uInt32& scany,
+                                   uInt32& offset) const
+{
+  const TIA& tia = instance().console().tia();
+  bool visible = tia.electronBeamPos(scanx, scany);
+  offset = tia.width() * scany + scanx;
+
+  return visible;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 TiaOutputWidget::loggedWrites() const
+{
+  const TIAWriteLog& log = instance().debugger().tiaWriteLog();
+  return log.isRecording() ? log.frame(0).count + 1 : 0;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -151,20 +183,48 @@ void TiaOutputWidget::drawWidget(bool hilite)
   // This determines where the frame greying should start, and where a
   // scanline 'pointer' should be drawn
   uInt32 scanx, scany, scanoffset;
-  bool visible = instance().console().tia().electronBeamPos(scanx, scany);
-  scanoffset = width * scany + scanx;
+  bool visible = beamPosition(scanx, scany, scanoffset);
 
-  for(uInt32 y = 0, i = 0; y < height; ++y)
+  TIASurface& tiaSurface = instance().frameBuffer().tiaSurface();
+  uInt64 hash = tiaSurface.fingerprint();
+  if(hash != myImageHash || scanoffset != myImageScanOffset)
   {
-    uInt32* line_ptr = myLineBuffer;
-    for(uInt32 x = 0; x < width; ++x, ++i)
+    uInt32* line_ptr = myImage;
+    for(uInt32 i = 0; i < width * height; ++i)
     {
       uInt8 shift = i >= scanoffset ? 1 : 0;
-      uInt32 pixel = instance().frameBuffer().tiaSurface().pixel(i, shift);
+      uInt32 pixel = tiaSurface.pixel(i, shift);
       *line_ptr++ = pixel;
       *line_ptr++ = pixel;
     }
-    s.drawPixels(myLineBuffer, _x, _y+y, width << 1);
+    myImageHash = hash;
+    myImageScanOffset = scanoffset;
+  }
+  myDrawnFrame = instance().console().tia().frameCount();
+  myDrawnWrites = loggedWrites();
+
+  for(uInt32 y = 0; y < height; ++y)
+    s.drawPixels(myImage + y * (width << 1), _x, _y+y, width << 1);
+
+  // Mark the logged TIA writes; below the beam, the previous frame is shown
+  const TIAWriteLog& log = instance().debugger().tiaWriteLog();
+  if(log.isRecording())
+  {
+    // The log may not contain the current frame yet
+    const uInt32 frame = instance().console().tia().frameCount();
+    const uInt32 first = log.frame(0).number == frame ? 0 : 1;
+    for(uInt32 ago = first; ago < 2; ++ago)
+    {
+      const TIAWriteLog::Frame f = log.frame(ago - first);
+      const bool current = ago == 0;
+      for(uInt32 i = 0; i < f.count; ++i)
+      {
+        const TIAWriteLog::Write& w = f.writes[i];
+        const uInt32 x = w.clock < 68 ? 0 : w.clock - 68;
+        if(w.y < height && current == (w.y * width + x < scanoffset))
+          s.fillRect(_x + (x << 1), _y + w.y, 2, 1, kDbgChangedColor);
+      }
+    }
   }
 
   // Show electron beam position
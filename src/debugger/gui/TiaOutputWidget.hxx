@@ -25,6 +25,7 @@ class TiaZoomWidget;
 #include "Widget.hxx"
 #include "Command.hxx"
 #include "ContextMenu.hxx"
+#include "FrameManager.hxx"
 
 class TiaOutputWidget : public Widget, public CommandSender
 {
@@ -53,9 +54,16 @@ class TiaOutputWidget : public Widget, public CommandSender
 
     int myClickX, myClickY;
 
-    // Create this buffer once, instead of allocating it each time the
-    // TIA image is redrawn
-    uInt32 myLineBuffer[320];
+    // The TIA image as last drawn; since the debugger is redrawn
+    // continuously, it's only converted again when something changed
+    uInt32 myImage[320 * FrameManager::frameBufferHeight];
+    uInt64 myImageHash;
+    uInt32 myImageScanOffset;
+
+    // The frame and number of logged writes the image was last drawn
+    // with; together with the above, these decide whether it must be
+    // drawn again
+    uInt32 myDrawnFrame, myDrawnWrites;
 
   private:
     void handleMouseDown(int x, int y, int button, int clickCount) override;
@@ -64,6 +72,14 @@ class TiaOutputWidget : public Widget, public CommandSender
     void drawWidget(bool hilite) override;
     bool wantsFocus() const override { return false; }
 
+    // Get the electron beam position, and its offset in the image;
+    // answer whether the beam is visible
+    bool beamPosition(uInt32& scanx, uInt32& scany, uInt32& offset) const;
+
+    // Answer the number of writes logged in the current frame, plus one
+    // (or 0 if the writes aren't logged)
+    uInt32 loggedWrites() const;
+
     // Following constructors and assignment operators not supported
     TiaOutputWidget() = delete;
     TiaOutputWidget(const TiaOutputWidget&) = delete;
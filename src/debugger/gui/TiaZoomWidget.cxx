@@ -19,6 +19,7 @@
 #include "Console.hxx"
 #include "TIA.hxx"
 #include "FrameBuffer.hxx"
+#include "TIASurface.hxx"
 #include "Widget.hxx"
 #include "GuiObject.hxx"
 #include "ContextMenu.hxx"
@@ -50,6 +51,11 @@ TiaZoomWidget::TiaZoomWidget(GuiObject* boss, const GUI::Font& font,
   myMouseMoving = false;
   myXClick = myYClick = 0;
 
+  myDrawnHash = 0;
+  myDrawnFrame = 0;
+  myDrawnScanOffset = ~0u;
+  myDrawnXOff = myDrawnYOff = myDrawnZoomLevel = -1;
+
   // Create context menu for zoom levels
   VariantList l;
   VarList::push_back(l, "2x zoom", "2");
@@ -61,7 +67,23 @@ TiaZoomWidget::TiaZoomWidget(GuiObject* boss, const GUI::Font& font,
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TiaZoomWidget::loadConfig()
 {
-  setDirty();
+  // Drawing every pixel zoomed is expensive, so it's only done when the
+  // image, the beam position or the part of the image shown changed
+  if(myXOff != myDrawnXOff || myYOff != myDrawnYOff ||
+     myZoomLevel != myDrawnZoomLevel ||
+     beamOffset() != myDrawnScanOffset ||
+     instance().console().tia().frameCount() != myDrawnFrame ||
+     instance().frameBuffer().tiaSurface().fingerprint() != myDrawnHash)
+    setDirty();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 TiaZoomWidget::beamOffset() const
+{
+  uInt32 scanx, scany;
+  instance().console().tia().electronBeamPos(scanx, scany);
+
+  return instance().console().tia().width() * scany + scanx;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -253,9 +275,7 @@ void TiaZoomWidget::drawWidget(bool hilite)
 
   // Get current scanline position
   // This determines where the frame greying should start
-  uInt32 scanx, scany, scanoffset;
-  instance().console().tia().electronBeamPos(scanx, scany);
-  scanoffset = width * scany + scanx;
+  uInt32 scanoffset = beamOffset();
 
   int x, y, col, row;
   for(y = myYOff, row = 0; y < myNumRows+myYOff; ++y, row += hzoom)
@@ -267,4 +287,10 @@ void TiaZoomWidget::drawWidget(bool hilite)
       s.fillRect(_x + col + 2, _y + row + 2, wzoom, hzoom, color);
     }
   }
+
+  myDrawnHash = instance().frameBuffer().tiaSurface().fingerprint();
+  myDrawnFrame = instance().console().tia().frameCount();
+  myDrawnScanOffset = scanoffset;
+  myDrawnXOff = myXOff;  myDrawnYOff = myYOff;
+  myDrawnZoomLevel = myZoomLevel;
 }
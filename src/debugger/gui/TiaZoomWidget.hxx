@@ -50,6 +50,9 @@ class TiaZoomWidget : public Widget, public CommandSender
     void drawWidget(bool hilite) override;
     bool wantsFocus() const override { return true; }
 
+    // Answer the offset of the electron beam in the image
+    uInt32 beamOffset() const;
+
   private:
     unique_ptr<ContextMenu> myMenu;
 
@@ -60,6 +63,12 @@ class TiaZoomWidget : public Widget, public CommandSender
     bool myMouseMoving;
     int myXClick, myYClick;
 
+    // What the image was last drawn from; it's only drawn again when any
+    // of these changed
+    uInt64 myDrawnHash;
+    uInt32 myDrawnFrame, myDrawnScanOffset;
+    int myDrawnXOff, myDrawnYOff, myDrawnZoomLevel;
+
   private:
     // Following constructors and assignment operators not supported
     TiaZoomWidget() = delete;
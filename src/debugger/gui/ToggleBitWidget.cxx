@@ -59,9 +59,10 @@ void ToggleBitWidget::setList(const StringList& off, const StringList& on)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void ToggleBitWidget::setState(const BoolArray& state, const BoolArray& changed)
 {
-  _stateList.clear();
+  if(state == _stateList && changed == _changedList)
+    return;
+
   _stateList = state;
-  _changedList.clear();
   _changedList = changed;
 
   setDirty();
@@ -45,7 +45,9 @@ TogglePixelWidget::TogglePixelWidget(GuiObject* boss, const GUI::Font& font,
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TogglePixelWidget::setState(const BoolArray& state)
 {
-  _stateList.clear();
+  if(state == _stateList)
+    return;
+
   _stateList = state;
 
   setDirty();
@@ -14,6 +14,7 @@ MODULE_OBJS := \
 	src/debugger/gui/TiaInfoWidget.o \
 	src/debugger/gui/TiaOutputWidget.o \
 	src/debugger/gui/TiaZoomWidget.o \
+	src/debugger/gui/ThumbProfilerWidget.o \
 	src/debugger/gui/DataGridOpsWidget.o \
 	src/debugger/gui/DataGridWidget.o \
 	src/debugger/gui/DebuggerDialog.o \
@@ -5,9 +5,15 @@ MODULE_OBJS := \
 	src/debugger/DebuggerParser.o \
 	src/debugger/CartDebug.o \
 	src/debugger/CpuDebug.o \
+	src/debugger/CycleProfiler.o \
 	src/debugger/DiStella.o \
+	src/debugger/ExecutionHistory.o \
+	src/debugger/ExecutionTrace.o \
+	src/debugger/ExpressionCode.o \
 	src/debugger/RiotDebug.o \
-	src/debugger/TIADebug.o
+	src/debugger/TIADebug.o \
+	src/debugger/TIAWriteLog.o \
+	src/debugger/ThumbProfiler.o
 
 MODULE_DIRS += \
 	src/debugger
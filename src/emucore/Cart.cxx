@@ -29,6 +29,7 @@ Cartridge::Cartridge(const Settings& settings)
     myStartBank(0),
     myBankChanged(true),
     myCodeAccessBase(nullptr),
+    myCodeAccessSize(0),
     myBankLocked(false)
 {
 }
@@ -81,9 +82,11 @@ void Cartridge::createCodeAccessBase(uInt32 size)
 {
 #ifdef DEBUGGER_SUPPORT
   myCodeAccessBase = make_unique<uInt8[]>(size);
+  myCodeAccessSize = size;
   memset(myCodeAccessBase.get(), CartDebug::ROW, size);
 #else
   myCodeAccessBase = nullptr;
+  myCodeAccessSize = 0;
 #endif
 }
 
@@ -131,6 +131,16 @@ class Cartridge : public Device
     */
     virtual uInt16 bankCount() const { return 1; }
 
+    /**
+      Get the array holding code-access information for every byte of
+      the ROM, and its size (see createCodeAccessBase).  Since the pages
+      of the system point into this array, it maps an address to its
+      offset in the ROM, whatever the bankswitching scheme.  The array
+      is only available when the debugger is included.
+    */
+    const uInt8* codeAccessBase() const { return myCodeAccessBase.get(); }
+    uInt32 codeAccessSize() const { return myCodeAccessSize; }
+
     /**
       Patch the cartridge ROM.
 
@@ -211,6 +221,7 @@ class Cartridge : public Device
     // The array containing information about every byte of ROM indicating
     // whether it is used as code.
     BytePtr myCodeAccessBase;
+    uInt32 myCodeAccessSize;
 
   private:
     // If myBankLocked is true, ignore attempts at bankswitching. This is used
@@ -63,6 +63,7 @@
 #include "Settings.hxx"
 
 #include "CartDetector.hxx"
+#include "SignatureScanner.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 unique_ptr<Cartridge> CartDetector::create(const BytePtr& image, uInt32 size,
@@ -80,7 +81,7 @@ unique_ptr<Cartridge> CartDetector::create(const BytePtr& image, uInt32 size,
   // If we ask for extended info, always do an autodetect
   if(type == BSType::_AUTO || osystem.settings().getBool("rominfo"))
   {
-    detectedType = autodetectType(image, size);
+    detectedType = autodetectType(image.get(), size);
     if(type != BSType::_AUTO && type != detectedType)
       cerr << "Auto-detection not consistent: "
            << Bankswitch::typeToName(type) << ", "
@@ -325,11 +326,15 @@ CartDetector::createFromImage(const BytePtr& image, uInt32 size, BSType type,
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-BSType CartDetector::autodetectType(const BytePtr& image, uInt32 size)
+BSType CartDetector::autodetectType(const uInt8* image, uInt32 size)
 {
   // Guess type based on size
   BSType type = BSType::_AUTO;
 
+  // Find all signatures in a single pass over the image
+  SignatureHits hits;
+  scanner().scan(image, size, hits.data());
+
   if(isProbablyCVPlus(image,size))
   {
     type = BSType::_CVP;
@@ -343,13 +348,13 @@ BSType CartDetector::autodetectType(const BytePtr& image, uInt32 size)
     type = BSType::_2K;
   }
   else if((size == 2048) ||
-          (size == 4096 && memcmp(image.get(), image.get() + 2048, 2048) == 0))
+          (size == 4096 && memcmp(image, image + 2048, 2048) == 0))
   {
-    type = isProbablyCV(image, size) ? BSType::_CV : BSType::_2K;
+    type = isProbablyCV(hits) ? BSType::_CV : BSType::_2K;
   }
   else if(size == 4096)
   {
-    if(isProbablyCV(image, size))
+    if(isProbablyCV(hits))
       type = BSType::_CV;
     else if(isProbably4KSC(image, size))
       type = BSType::_4KSC;
@@ -359,24 +364,23 @@ BSType CartDetector::autodetectType(const BytePtr& image, uInt32 size)
   else if(size == 8*1024)  // 8K
   {
     // First check for *potential* F8
-    uInt8 signature[] = { 0x8D, 0xF9, 0x1F };  // STA $1FF9
-    bool f8 = searchForBytes(image.get(), size, signature, 3, 2);
+    bool f8 = hits[SIG_F8] >= 2;  // STA $1FF9
 
     if(isProbablySC(image, size))
       type = BSType::_F8SC;
-    else if(memcmp(image.get(), image.get() + 4096, 4096) == 0)
+    else if(memcmp(image, image + 4096, 4096) == 0)
       type = BSType::_4K;
-    else if(isProbablyE0(image, size))
+    else if(isProbablyE0(hits))
       type = BSType::_E0;
-    else if(isProbably3E(image, size))
+    else if(isProbably3E(hits))
       type = BSType::_3E;
-    else if(isProbably3F(image, size))
+    else if(isProbably3F(hits))
       type = BSType::_3F;
-    else if(isProbablyUA(image, size))
+    else if(isProbablyUA(hits))
       type = BSType::_UA;
-    else if(isProbablyFE(image, size) && !f8)
+    else if(isProbablyFE(hits) && !f8)
       type = BSType::_FE;
-    else if(isProbably0840(image, size))
+    else if(isProbably0840(hits))
       type = BSType::_0840;
     else
       type = BSType::_F8;
@@ -397,12 +401,12 @@ BSType CartDetector::autodetectType(const BytePtr& image, uInt32 size)
   {
     if(isProbablySC(image, size))
       type = BSType::_F6SC;
-    else if(isProbablyE7(image, size))
+    else if(isProbablyE7(hits))
       type = BSType::_E7;
-    else if(isProbably3E(image, size))
+    else if(isProbably3E(hits))
       type = BSType::_3E;
   /* no known 16K 3F ROMS
-    else if(isProbably3F(image, size))
+    else if(isProbably3F(hits))
       type = BSType::_3F;
   */
     else
@@ -416,22 +420,22 @@ BSType CartDetector::autodetectType(const BytePtr& image, uInt32 size)
   {
     if(isProbablyARM(image, size))
       type = BSType::_FA2;
-    else /*if(isProbablyDPCplus(image, size))*/
+    else /*if(isProbablyDPCplus(hits))*/
       type = BSType::_DPCP;
   }
   else if(size == 32*1024)  // 32K
   {
     if(isProbablySC(image, size))
       type = BSType::_F4SC;
-    else if(isProbably3E(image, size))
+    else if(isProbably3E(hits))
       type = BSType::_3E;
-    else if(isProbably3F(image, size))
+    else if(isProbably3F(hits))
       type = BSType::_3F;
-    else if (isProbablyBUS(image, size))
+    else if (isProbablyBUS(hits))
       type = BSType::_BUS;
-    else if (isProbablyCDF(image, size))
+    else if (isProbablyCDF(hits))
       type = BSType::_CDF;
-    else if(isProbablyDPCplus(image, size))
+    else if(isProbablyDPCplus(hits))
       type = BSType::_DPCP;
     else if(isProbablyCTY(image, size))
       type = BSType::_CTY;
@@ -442,57 +446,57 @@ BSType CartDetector::autodetectType(const BytePtr& image, uInt32 size)
   }
   else if(size == 64*1024)  // 64K
   {
-    if(isProbably3E(image, size))
+    if(isProbably3E(hits))
       type = BSType::_3E;
-    else if(isProbably3F(image, size))
+    else if(isProbably3F(hits))
       type = BSType::_3F;
     else if(isProbably4A50(image, size))
       type = BSType::_4A50;
-    else if(isProbablyEF(image, size, type))
+    else if(isProbablyEF(image, size, hits, type))
       ; // type has been set directly in the function
-    else if(isProbablyX07(image, size))
+    else if(isProbablyX07(hits))
       type = BSType::_X07;
     else
       type = BSType::_F0;
   }
   else if(size == 128*1024)  // 128K
   {
-    if(isProbably3E(image, size))
+    if(isProbably3E(hits))
       type = BSType::_3E;
     else if(isProbablyDF(image, size, type))
       ; // type has been set directly in the function
-    else if(isProbably3F(image, size))
+    else if(isProbably3F(hits))
       type = BSType::_3F;
     else if(isProbably4A50(image, size))
       type = BSType::_4A50;
-    else if(isProbablySB(image, size))
+    else if(isProbablySB(hits))
       type = BSType::_SB;
   }
   else if(size == 256*1024)  // 256K
   {
-    if(isProbably3E(image, size))
+    if(isProbably3E(hits))
       type = BSType::_3E;
     else if(isProbablyBF(image, size, type))
       ; // type has been set directly in the function
-    else if(isProbably3F(image, size))
+    else if(isProbably3F(hits))
       type = BSType::_3F;
-    else /*if(isProbablySB(image, size))*/
+    else /*if(isProbablySB(hits))*/
       type = BSType::_SB;
   }
   else  // what else can we do?
   {
-    if(isProbably3E(image, size))
+    if(isProbably3E(hits))
       type = BSType::_3E;
-    else if(isProbably3F(image, size))
+    else if(isProbably3F(hits))
       type = BSType::_3F;
     else
       type = BSType::_4K;  // Most common bankswitching type
   }
 
   // Variable sized ROM formats are independent of image size and come last
-  if(isProbablyDASH(image, size))
+  if(isProbablyDASH(hits))
     type = BSType::_DASH;
-  else if(isProbably3EPlus(image, size))
+  else if(isProbably3EPlus(hits))
     type = BSType::_3EP;
   else if(isProbablyMDM(image, size))
     type = BSType::_MDM;
@@ -529,11 +533,19 @@ bool CartDetector::searchForBytes(const uInt8* image, uInt32 imagesize,
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablySC(const BytePtr& image, uInt32 size)
+const SignatureScanner& CartDetector::scanner()
+{
+  // All signatures are compiled only once, the first time they're needed
+  static const SignatureScanner ourScanner(ourSignatures, SIG_NUM);
+  return ourScanner;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool CartDetector::isProbablySC(const uInt8* image, uInt32 size)
 {
   // We assume a Superchip cart repeats the first 128 bytes for the second
   // 128 bytes in the RAM area, which is the first 256 bytes of each 4K bank
-  const uInt8* ptr = image.get();
+  const uInt8* ptr = image;
   while(size)
   {
     if(memcmp(ptr, ptr + 128, 128) != 0)
@@ -546,7 +558,7 @@ bool CartDetector::isProbablySC(const BytePtr& image, uInt32 size)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbably4KSC(const BytePtr& image, uInt32 size)
+bool CartDetector::isProbably4KSC(const uInt8* image, uInt32 size)
 {
   // We check if the first 256 bytes are identical *and* if there's
   // an "SC" signature for one of our larger SC types at 1FFA.
@@ -563,7 +575,7 @@ bool CartDetector::isProbably4KSC(const BytePtr& image, uInt32 size)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyARM(const BytePtr& image, uInt32 size)
+bool CartDetector::isProbablyARM(const uInt8* image, uInt32 size)
 {
   // ARM code contains the following 'loader' patterns in the first 1K
   // Thanks to Thomas Jentzsch of AtariAge for this advice
@@ -571,68 +583,52 @@ bool CartDetector::isProbablyARM(const BytePtr& image, uInt32 size)
     { 0xA0, 0xC1, 0x1F, 0xE0 },
     { 0x00, 0x80, 0x02, 0xE0 }
   };
-  if(searchForBytes(image.get(), std::min(size, 1024u), signature[0], 4, 1))
+  if(searchForBytes(image, std::min(size, 1024u), signature[0], 4, 1))
     return true;
   else
-    return searchForBytes(image.get(), std::min(size, 1024u), signature[1], 4, 1);
+    return searchForBytes(image, std::min(size, 1024u), signature[1], 4, 1);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbably0840(const BytePtr& image, uInt32 size)
+bool CartDetector::isProbably0840(const SignatureHits& hits)
 {
   // 0840 cart bankswitching is triggered by accessing addresses 0x0800
   // or 0x0840 at least twice
-  uInt8 signature1[3][3] = {
-    { 0xAD, 0x00, 0x08 },  // LDA $0800
-    { 0xAD, 0x40, 0x08 },  // LDA $0840
-    { 0x2C, 0x00, 0x08 }   // BIT $0800
-  };
-  for(uInt32 i = 0; i < 3; ++i)
-    if(searchForBytes(image.get(), size, signature1[i], 3, 2))
-      return true;
-
-  uInt8 signature2[2][4] = {
-    { 0x0C, 0x00, 0x08, 0x4C },  // NOP $0800; JMP ...
-    { 0x0C, 0xFF, 0x0F, 0x4C }   // NOP $0FFF; JMP ...
-  };
-  for(uInt32 i = 0; i < 2; ++i)
-    if(searchForBytes(image.get(), size, signature2[i], 4, 2))
+  for(uInt32 sig = SIG_0840_LDA_0800; sig <= SIG_0840_NOP_0FFF; ++sig)
+    if(hits[sig] >= 2)
       return true;
 
   return false;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbably3E(const BytePtr& image, uInt32 size)
+bool CartDetector::isProbably3E(const SignatureHits& hits)
 {
   // 3E cart bankswitching is triggered by storing the bank number
   // in address 3E using 'STA $3E', commonly followed by an
   // immediate mode LDA
-  uInt8 signature[] = { 0x85, 0x3E, 0xA9, 0x00 };  // STA $3E; LDA #$00
-  return searchForBytes(image.get(), size, signature, 4, 1);
+  return hits[SIG_3E] >= 1;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbably3EPlus(const BytePtr& image, uInt32 size)
+bool CartDetector::isProbably3EPlus(const SignatureHits& hits)
 {
   // 3E+ cart is identified key 'TJ3E' in the ROM
-  uInt8 signature[] = { 'T', 'J', '3', 'E' };
-  return searchForBytes(image.get(), size, signature, 4, 1);
+  return hits[SIG_3EPLUS] >= 1;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbably3F(const BytePtr& image, uInt32 size)
+bool CartDetector::isProbably3F(const SignatureHits& hits)
 {
   // 3F cart bankswitching is triggered by storing the bank number
   // in address 3F using 'STA $3F'
   // We expect it will be present at least 2 times, since there are
   // at least two banks
-  uInt8 signature[] = { 0x85, 0x3F };  // STA $3F
-  return searchForBytes(image.get(), size, signature, 2, 2);
+  return hits[SIG_3F] >= 2;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbably4A50(const BytePtr& image, uInt32 size)
+bool CartDetector::isProbably4A50(const uInt8* image, uInt32 size)
 {
   // 4A50 carts store address $4A50 at the NMI vector, which
   // in this scheme is always in the last page of ROM at
@@ -650,118 +646,86 @@ bool CartDetector::isProbably4A50(const BytePtr& image, uInt32 size)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyCTY(const BytePtr&, uInt32)
+bool CartDetector::isProbablyCTY(const uInt8*, uInt32)
 {
   return false;  // TODO - add autodetection
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyCV(const BytePtr& image, uInt32 size)
+bool CartDetector::isProbablyCV(const SignatureHits& hits)
 {
   // CV RAM access occurs at addresses $f3ff and $f400
-  // These signatures are attributed to the MESS project
-  uInt8 signature[2][3] = {
-    { 0x9D, 0xFF, 0xF3 },  // STA $F3FF.X
-    { 0x99, 0x00, 0xF4 }   // STA $F400.Y
-  };
-  if(searchForBytes(image.get(), size, signature[0], 3, 1))
-    return true;
-  else
-    return searchForBytes(image.get(), size, signature[1], 3, 1);
+  return hits[SIG_CV_STA_F3FF] >= 1 || hits[SIG_CV_STA_F400] >= 1;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyCVPlus(const BytePtr& image, uInt32)
+bool CartDetector::isProbablyCVPlus(const uInt8* image, uInt32)
 {
   // CV+ cart is identified key 'commavidplus' @ $04 in the ROM
   // We inspect only this area to speed up the search
   uInt8 signature[12] = { 'c', 'o', 'm', 'm', 'a', 'v', 'i', 'd',
                           'p', 'l', 'u', 's' };
-  return searchForBytes(image.get()+4, 24, signature, 12, 1);
+  return searchForBytes(image+4, 24, signature, 12, 1);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyDASH(const BytePtr& image, uInt32 size)
+bool CartDetector::isProbablyDASH(const SignatureHits& hits)
 {
   // DASH cart is identified key 'TJAD' in the ROM
-  uInt8 signature[] = { 'T', 'J', 'A', 'D' };
-  return searchForBytes(image.get(), size, signature, 4, 1);
+  return hits[SIG_DASH] >= 1;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyDPCplus(const BytePtr& image, uInt32 size)
+bool CartDetector::isProbablyDPCplus(const SignatureHits& hits)
 {
   // DPC+ ARM code has 2 occurrences of the string DPC+
   // Note: all Harmony/Melody custom drivers also contain the value
   // 0x10adab1e (LOADABLE) if needed for future improvement
-  uInt8 signature[] = { 'D', 'P', 'C', '+' };
-  return searchForBytes(image.get(), size, signature, 4, 2);
+  return hits[SIG_DPCPLUS] >= 2;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyE0(const BytePtr& image, uInt32 size)
+bool CartDetector::isProbablyE0(const SignatureHits& hits)
 {
   // E0 cart bankswitching is triggered by accessing addresses
   // $FE0 to $FF9 using absolute non-indexed addressing
   // To eliminate false positives (and speed up processing), we
   // search for only certain known signatures
-  // Thanks to "stella@casperkitty.com" for this advice
-  // These signatures are attributed to the MESS project
-  uInt8 signature[8][3] = {
-    { 0x8D, 0xE0, 0x1F },  // STA $1FE0
-    { 0x8D, 0xE0, 0x5F },  // STA $5FE0
-    { 0x8D, 0xE9, 0xFF },  // STA $FFE9
-    { 0x0C, 0xE0, 0x1F },  // NOP $1FE0
-    { 0xAD, 0xE0, 0x1F },  // LDA $1FE0
-    { 0xAD, 0xE9, 0xFF },  // LDA $FFE9
-    { 0xAD, 0xED, 0xFF },  // LDA $FFED
-    { 0xAD, 0xF3, 0xBF }   // LDA $BFF3
-  };
-  for(uInt32 i = 0; i < 8; ++i)
-    if(searchForBytes(image.get(), size, signature[i], 3, 1))
+  for(uInt32 sig = SIG_E0_STA_1FE0; sig <= SIG_E0_LDA_BFF3; ++sig)
+    if(hits[sig] >= 1)
       return true;
 
   return false;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyE7(const BytePtr& image, uInt32 size)
+bool CartDetector::isProbablyE7(const SignatureHits& hits)
 {
   // E7 cart bankswitching is triggered by accessing addresses
   // $FE0 to $FE6 using absolute non-indexed addressing
   // To eliminate false positives (and speed up processing), we
   // search for only certain known signatures
-  // Thanks to "stella@casperkitty.com" for this advice
-  // These signatures are attributed to the MESS project
-  uInt8 signature[7][3] = {
-    { 0xAD, 0xE2, 0xFF },  // LDA $FFE2
-    { 0xAD, 0xE5, 0xFF },  // LDA $FFE5
-    { 0xAD, 0xE5, 0x1F },  // LDA $1FE5
-    { 0xAD, 0xE7, 0x1F },  // LDA $1FE7
-    { 0x0C, 0xE7, 0x1F },  // NOP $1FE7
-    { 0x8D, 0xE7, 0xFF },  // STA $FFE7
-    { 0x8D, 0xE7, 0x1F }   // STA $1FE7
-  };
-  for(uInt32 i = 0; i < 7; ++i)
-    if(searchForBytes(image.get(), size, signature[i], 3, 1))
+  for(uInt32 sig = SIG_E7_LDA_FFE2; sig <= SIG_E7_STA_1FE7; ++sig)
+    if(hits[sig] >= 1)
       return true;
 
   return false;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyEF(const BytePtr& image, uInt32 size, BSType& type)
+bool CartDetector::isProbablyEF(const uInt8* image, uInt32 size,
+                                const SignatureHits& hits, BSType& type)
 {
   // Newer EF carts store strings 'EFEF' and 'EFSC' starting at address $FFF8
   // This signature is attributed to "RevEng" of AtariAge
   uInt8 efef[] = { 'E', 'F', 'E', 'F' };
   uInt8 efsc[] = { 'E', 'F', 'S', 'C' };
-  if(searchForBytes(image.get()+size-8, 8, efef, 4, 1))
+  if(searchForBytes(image+size-8, 8, efef, 4, 1))
   {
     type = BSType::_EF;
     return true;
   }
-  else if(searchForBytes(image.get()+size-8, 8, efsc, 4, 1))
+  else if(searchForBytes(image+size-8, 8, efsc, 4, 1))
   {
     type = BSType::_EFSC;
     return true;
@@ -771,15 +735,9 @@ bool CartDetector::isProbablyEF(const BytePtr& image, uInt32 size, BSType& type)
   // 0xFE0 to 0xFEF, usually with either a NOP or LDA
   // It's likely that the code will switch to bank 0, so that's what is tested
   bool isEF = false;
-  uInt8 signature[4][3] = {
-    { 0x0C, 0xE0, 0xFF },  // NOP $FFE0
-    { 0xAD, 0xE0, 0xFF },  // LDA $FFE0
-    { 0x0C, 0xE0, 0x1F },  // NOP $1FE0
-    { 0xAD, 0xE0, 0x1F }   // LDA $1FE0
-  };
-  for(uInt32 i = 0; i < 4; ++i)
+  for(uInt32 sig = SIG_EF_NOP_FFE0; sig <= SIG_EF_LDA_1FE0; ++sig)
   {
-    if(searchForBytes(image.get(), size, signature[i], 3, 1))
+    if(hits[sig] >= 1)
     {
       isEF = true;
       break;
@@ -798,18 +756,18 @@ bool CartDetector::isProbablyEF(const BytePtr& image, uInt32 size, BSType& type)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyBF(const BytePtr& image, uInt32 size, BSType& type)
+bool CartDetector::isProbablyBF(const uInt8* image, uInt32 size, BSType& type)
 {
   // BF carts store strings 'BFBF' and 'BFSC' starting at address $FFF8
   // This signature is attributed to "RevEng" of AtariAge
   uInt8 bf[]   = { 'B', 'F', 'B', 'F' };
   uInt8 bfsc[] = { 'B', 'F', 'S', 'C' };
-  if(searchForBytes(image.get()+size-8, 8, bf, 4, 1))
+  if(searchForBytes(image+size-8, 8, bf, 4, 1))
   {
     type = BSType::_BF;
     return true;
   }
-  else if(searchForBytes(image.get()+size-8, 8, bfsc, 4, 1))
+  else if(searchForBytes(image+size-8, 8, bfsc, 4, 1))
   {
     type = BSType::_BFSC;
     return true;
@@ -819,39 +777,37 @@ bool CartDetector::isProbablyBF(const BytePtr& image, uInt32 size, BSType& type)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyBUS(const BytePtr& image, uInt32 size)
+bool CartDetector::isProbablyBUS(const SignatureHits& hits)
 {
   // BUS ARM code has 2 occurrences of the string BUS
   // Note: all Harmony/Melody custom drivers also contain the value
   // 0x10adab1e (LOADABLE) if needed for future improvement
-  uInt8 bus[] = { 'B', 'U', 'S'};
-  return searchForBytes(image.get(), size, bus, 3, 2);
+  return hits[SIG_BUS] >= 2;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyCDF(const BytePtr& image, uInt32 size)
+bool CartDetector::isProbablyCDF(const SignatureHits& hits)
 {
-  // CDF ARM code has 3 occurrences of the string DPC+
+  // CDF ARM code has 3 occurrences of the string CDF
   // Note: all Harmony/Melody custom drivers also contain the value
   // 0x10adab1e (LOADABLE) if needed for future improvement
-  uInt8 signature[] = { 'C', 'D', 'F' };
-  return searchForBytes(image.get(), size, signature, 3, 3);
+  return hits[SIG_CDF] >= 3;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyDF(const BytePtr& image, uInt32 size, BSType& type)
+bool CartDetector::isProbablyDF(const uInt8* image, uInt32 size, BSType& type)
 {
 
   // BF carts store strings 'DFDF' and 'DFSC' starting at address $FFF8
   // This signature is attributed to "RevEng" of AtariAge
   uInt8 df[]   = { 'D', 'F', 'D', 'F' };
   uInt8 dfsc[] = { 'D', 'F', 'S', 'C' };
-  if(searchForBytes(image.get()+size-8, 8, df, 4, 1))
+  if(searchForBytes(image+size-8, 8, df, 4, 1))
   {
     type = BSType::_DF;
     return true;
   }
-  else if(searchForBytes(image.get()+size-8, 8, dfsc, 4, 1))
+  else if(searchForBytes(image+size-8, 8, dfsc, 4, 1))
   {
     type = BSType::_DFSC;
     return true;
@@ -861,7 +817,7 @@ bool CartDetector::isProbablyDF(const BytePtr& image, uInt32 size, BSType& type)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyFA2(const BytePtr& image, uInt32)
+bool CartDetector::isProbablyFA2(const uInt8* image, uInt32)
 {
   // This currently tests only the 32K version of FA2; the 24 and 28K
   // versions are easy, in that they're the only possibility with those
@@ -876,78 +832,121 @@ bool CartDetector::isProbablyFA2(const BytePtr& image, uInt32)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyFE(const BytePtr& image, uInt32 size)
+bool CartDetector::isProbablyFE(const SignatureHits& hits)
 {
   // FE bankswitching is very weird, but always seems to include a
   // 'JSR $xxxx'
-  // These signatures are attributed to the MESS project
-  uInt8 signature[4][5] = {
-    { 0x20, 0x00, 0xD0, 0xC6, 0xC5 },  // JSR $D000; DEC $C5
-    { 0x20, 0xC3, 0xF8, 0xA5, 0x82 },  // JSR $F8C3; LDA $82
-    { 0xD0, 0xFB, 0x20, 0x73, 0xFE },  // BNE $FB; JSR $FE73
-    { 0x20, 0x00, 0xF0, 0x84, 0xD6 }   // JSR $F000; STY $D6
-  };
-  for(uInt32 i = 0; i < 4; ++i)
-    if(searchForBytes(image.get(), size, signature[i], 5, 1))
+  for(uInt32 sig = SIG_FE_JSR_D000; sig <= SIG_FE_JSR_F000; ++sig)
+    if(hits[sig] >= 1)
       return true;
 
   return false;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyMDM(const BytePtr& image, uInt32 size)
+bool CartDetector::isProbablyMDM(const uInt8* image, uInt32 size)
 {
   // MDM cart is identified key 'MDMC' in the first 8K of ROM
   uInt8 signature[] = { 'M', 'D', 'M', 'C' };
-  return searchForBytes(image.get(), std::min(size, 8192u), signature, 4, 1);
+  return searchForBytes(image, std::min(size, 8192u), signature, 4, 1);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablySB(const BytePtr& image, uInt32 size)
+bool CartDetector::isProbablySB(const SignatureHits& hits)
 {
   // SB cart bankswitching switches banks by accessing address 0x0800
-  uInt8 signature[2][3] = {
-    { 0xBD, 0x00, 0x08 },  // LDA $0800,x
-    { 0xAD, 0x00, 0x08 }   // LDA $0800
-  };
-  if(searchForBytes(image.get(), size, signature[0], 3, 1))
-    return true;
-  else
-    return searchForBytes(image.get(), size, signature[1], 3, 1);
+  return hits[SIG_SB_LDA_0800_X] >= 1 || hits[SIG_SB_LDA_0800] >= 1;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyUA(const BytePtr& image, uInt32 size)
+bool CartDetector::isProbablyUA(const SignatureHits& hits)
 {
   // UA cart bankswitching switches to bank 1 by accessing address 0x240
   // using 'STA $240' or 'LDA $240'
-  uInt8 signature[3][3] = {
-    { 0x8D, 0x40, 0x02 },  // STA $240
-    { 0xAD, 0x40, 0x02 },  // LDA $240
-    { 0xBD, 0x1F, 0x02 }   // LDA $21F,X
-  };
-  for(uInt32 i = 0; i < 3; ++i)
-    if(searchForBytes(image.get(), size, signature[i], 3, 1))
+  for(uInt32 sig = SIG_UA_STA_240; sig <= SIG_UA_LDA_21F_X; ++sig)
+    if(hits[sig] >= 1)
       return true;
 
   return false;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyX07(const BytePtr& image, uInt32 size)
+bool CartDetector::isProbablyX07(const SignatureHits& hits)
 {
   // X07 bankswitching switches to bank 0, 1, 2, etc by accessing address 0x08xd
-  uInt8 signature[6][3] = {
-    { 0xAD, 0x0D, 0x08 },  // LDA $080D
-    { 0xAD, 0x1D, 0x08 },  // LDA $081D
-    { 0xAD, 0x2D, 0x08 },  // LDA $082D
-    { 0x0C, 0x0D, 0x08 },  // NOP $080D
-    { 0x0C, 0x1D, 0x08 },  // NOP $081D
-    { 0x0C, 0x2D, 0x08 }   // NOP $082D
-  };
-  for(uInt32 i = 0; i < 6; ++i)
-    if(searchForBytes(image.get(), size, signature[i], 3, 1))
+  for(uInt32 sig = SIG_X07_LDA_080D; sig <= SIG_X07_NOP_082D; ++sig)
+    if(hits[sig] >= 1)
       return true;
 
   return false;
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const SignatureScanner::Signature CartDetector::ourSignatures[SIG_NUM] = {
+  { 3, { 0x8D, 0xF9, 0x1F } },        // F8: STA $1FF9
+
+  { 3, { 0xAD, 0x00, 0x08 } },        // 0840: LDA $0800
+  { 3, { 0xAD, 0x40, 0x08 } },        // 0840: LDA $0840
+  { 3, { 0x2C, 0x00, 0x08 } },        // 0840: BIT $0800
+  { 4, { 0x0C, 0x00, 0x08, 0x4C } },  // 0840: NOP $0800; JMP ...
+  { 4, { 0x0C, 0xFF, 0x0F, 0x4C } },  // 0840: NOP $0FFF; JMP ...
+
+  { 4, { 0x85, 0x3E, 0xA9, 0x00 } },  // 3E: STA $3E; LDA #$00
+  { 4, { 'T', 'J', '3', 'E' } },      // 3E+
+  { 2, { 0x85, 0x3F } },              // 3F: STA $3F
+
+  // These signatures are attributed to the MESS project
+  { 3, { 0x9D, 0xFF, 0xF3 } },        // CV: STA $F3FF.X
+  { 3, { 0x99, 0x00, 0xF4 } },        // CV: STA $F400.Y
+
+  { 4, { 'T', 'J', 'A', 'D' } },      // DASH
+  { 4, { 'D', 'P', 'C', '+' } },      // DPC+
+  { 3, { 'B', 'U', 'S' } },           // BUS
+  { 3, { 'C', 'D', 'F' } },           // CDF
+
+  // Thanks to "stella@casperkitty.com" for this advice
+  // These signatures are attributed to the MESS project
+  { 3, { 0x8D, 0xE0, 0x1F } },        // E0: STA $1FE0
+  { 3, { 0x8D, 0xE0, 0x5F } },        // E0: STA $5FE0
+  { 3, { 0x8D, 0xE9, 0xFF } },        // E0: STA $FFE9
+  { 3, { 0x0C, 0xE0, 0x1F } },        // E0: NOP $1FE0
+  { 3, { 0xAD, 0xE0, 0x1F } },        // E0: LDA $1FE0
+  { 3, { 0xAD, 0xE9, 0xFF } },        // E0: LDA $FFE9
+  { 3, { 0xAD, 0xED, 0xFF } },        // E0: LDA $FFED
+  { 3, { 0xAD, 0xF3, 0xBF } },        // E0: LDA $BFF3
+
+  // Thanks to "stella@casperkitty.com" for this advice
+  // These signatures are attributed to the MESS project
+  { 3, { 0xAD, 0xE2, 0xFF } },        // E7: LDA $FFE2
+  { 3, { 0xAD, 0xE5, 0xFF } },        // E7: LDA $FFE5
+  { 3, { 0xAD, 0xE5, 0x1F } },        // E7: LDA $1FE5
+  { 3, { 0xAD, 0xE7, 0x1F } },        // E7: LDA $1FE7
+  { 3, { 0x0C, 0xE7, 0x1F } },        // E7: NOP $1FE7
+  { 3, { 0x8D, 0xE7, 0xFF } },        // E7: STA $FFE7
+  { 3, { 0x8D, 0xE7, 0x1F } },        // E7: STA $1FE7
+
+  { 3, { 0x0C, 0xE0, 0xFF } },        // EF: NOP $FFE0
+  { 3, { 0xAD, 0xE0, 0xFF } },        // EF: LDA $FFE0
+  { 3, { 0x0C, 0xE0, 0x1F } },        // EF: NOP $1FE0
+  { 3, { 0xAD, 0xE0, 0x1F } },        // EF: LDA $1FE0
+
+  // These signatures are attributed to the MESS project
+  { 5, { 0x20, 0x00, 0xD0, 0xC6, 0xC5 } },  // FE: JSR $D000; DEC $C5
+  { 5, { 0x20, 0xC3, 0xF8, 0xA5, 0x82 } },  // FE: JSR $F8C3; LDA $82
+  { 5, { 0xD0, 0xFB, 0x20, 0x73, 0xFE } },  // FE: BNE $FB; JSR $FE73
+  { 5, { 0x20, 0x00, 0xF0, 0x84, 0xD6 } },  // FE: JSR $F000; STY $D6
+
+  { 3, { 0xBD, 0x00, 0x08 } },        // SB: LDA $0800,x
+  { 3, { 0xAD, 0x00, 0x08 } },        // SB: LDA $0800
+
+  { 3, { 0x8D, 0x40, 0x02 } },        // UA: STA $240
+  { 3, { 0xAD, 0x40, 0x02 } },        // UA: LDA $240
+  { 3, { 0xBD, 0x1F, 0x02 } },        // UA: LDA $21F,X
+
+  { 3, { 0xAD, 0x0D, 0x08 } },        // X07: LDA $080D
+  { 3, { 0xAD, 0x1D, 0x08 } },        // X07: LDA $081D
+  { 3, { 0xAD, 0x2D, 0x08 } },        // X07: LDA $082D
+  { 3, { 0x0C, 0x0D, 0x08 } },        // X07: NOP $080D
+  { 3, { 0x0C, 0x1D, 0x08 } },        // X07: NOP $081D
+  { 3, { 0x0C, 0x2D, 0x08 } }         // X07: NOP $082D
+};
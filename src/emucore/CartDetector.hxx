@@ -22,9 +22,12 @@ class Cartridge;
 class Properties;
 class OSystem;
 
+#include <array>
+
 #include "bspf.hxx"
 #include "BSType.hxx"
 #include "Settings.hxx"
+#include "SignatureScanner.hxx"
 
 /**
   Auto-detect cart type based on various attributes (file size, signatures,
@@ -50,6 +53,38 @@ class CartDetector
                  string& md5, const string& dtype, const OSystem& system);
 
   private:
+    // Signatures which are searched for in the whole image; they're all
+    // found in a single pass over the image, and the various 'isProbably'
+    // methods test the number of matches
+    enum Signature {
+      SIG_F8,
+      SIG_0840_LDA_0800, SIG_0840_LDA_0840, SIG_0840_BIT_0800,
+      SIG_0840_NOP_0800, SIG_0840_NOP_0FFF,
+      SIG_3E, SIG_3EPLUS, SIG_3F,
+      SIG_CV_STA_F3FF, SIG_CV_STA_F400,
+      SIG_DASH, SIG_DPCPLUS, SIG_BUS, SIG_CDF,
+      SIG_E0_STA_1FE0, SIG_E0_STA_5FE0, SIG_E0_STA_FFE9, SIG_E0_NOP_1FE0,
+      SIG_E0_LDA_1FE0, SIG_E0_LDA_FFE9, SIG_E0_LDA_FFED, SIG_E0_LDA_BFF3,
+      SIG_E7_LDA_FFE2, SIG_E7_LDA_FFE5, SIG_E7_LDA_1FE5, SIG_E7_LDA_1FE7,
+      SIG_E7_NOP_1FE7, SIG_E7_STA_FFE7, SIG_E7_STA_1FE7,
+      SIG_EF_NOP_FFE0, SIG_EF_LDA_FFE0, SIG_EF_NOP_1FE0, SIG_EF_LDA_1FE0,
+      SIG_FE_JSR_D000, SIG_FE_JSR_F8C3, SIG_FE_JSR_FE73, SIG_FE_JSR_F000,
+      SIG_SB_LDA_0800_X, SIG_SB_LDA_0800,
+      SIG_UA_STA_240, SIG_UA_LDA_240, SIG_UA_LDA_21F_X,
+      SIG_X07_LDA_080D, SIG_X07_LDA_081D, SIG_X07_LDA_082D,
+      SIG_X07_NOP_080D, SIG_X07_NOP_081D, SIG_X07_NOP_082D,
+      SIG_NUM
+    };
+    using SignatureHits = std::array<uInt32, SIG_NUM>;
+
+    // The bytes of each signature, in the order given above
+    static const SignatureScanner::Signature ourSignatures[SIG_NUM];
+
+    /**
+      Get the scanner for all signatures (created when first needed).
+    */
+    static const SignatureScanner& scanner();
+
     /**
       Create a cartridge from a multi-cart image pointer; internally this
       takes a slice of the ROM image ues that for the cartridge.
@@ -92,7 +127,7 @@ class CartDetector
 
       @return The "best guess" for the cartridge type
     */
-    static BSType autodetectType(const BytePtr& image, uInt32 size);
+    static BSType autodetectType(const uInt8* image, uInt32 size);
 
     /**
       Search the image for the specified byte signature
@@ -113,137 +148,138 @@ class CartDetector
       Returns true if the image is probably a SuperChip (128 bytes RAM)
       Note: should be called only on ROMs with size multiple of 4K
     */
-    static bool isProbablySC(const BytePtr& image, uInt32 size);
+    static bool isProbablySC(const uInt8* image, uInt32 size);
 
     /**
       Returns true if the image is probably a 4K SuperChip (128 bytes RAM)
     */
-    static bool isProbably4KSC(const BytePtr& image, uInt32 size);
+    static bool isProbably4KSC(const uInt8* image, uInt32 size);
 
     /**
       Returns true if the image probably contains ARM code in the first 1K
     */
-    static bool isProbablyARM(const BytePtr& image, uInt32 size);
+    static bool isProbablyARM(const uInt8* image, uInt32 size);
 
     /**
       Returns true if the image is probably a 0840 bankswitching cartridge
     */
-    static bool isProbably0840(const BytePtr& image, uInt32 size);
+    static bool isProbably0840(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a 3E bankswitching cartridge
     */
-    static bool isProbably3E(const BytePtr& image, uInt32 size);
+    static bool isProbably3E(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a 3E+ bankswitching cartridge
     */
-    static bool isProbably3EPlus(const BytePtr& image, uInt32 size);
+    static bool isProbably3EPlus(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a 3F bankswitching cartridge
     */
-    static bool isProbably3F(const BytePtr& image, uInt32 size);
+    static bool isProbably3F(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a 4A50 bankswitching cartridge
     */
-    static bool isProbably4A50(const BytePtr& image, uInt32 size);
+    static bool isProbably4A50(const uInt8* image, uInt32 size);
 
     /**
       Returns true if the image is probably a BF/BFSC bankswitching cartridge
     */
-    static bool isProbablyBF(const BytePtr& image, uInt32 size, BSType& type);
+    static bool isProbablyBF(const uInt8* image, uInt32 size, BSType& type);
 
     /**
       Returns true if the image is probably a BUS bankswitching cartridge
     */
-    static bool isProbablyBUS(const BytePtr& image, uInt32 size);
+    static bool isProbablyBUS(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a CDF bankswitching cartridge
     */
-    static bool isProbablyCDF(const BytePtr& image, uInt32 size);
+    static bool isProbablyCDF(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a CTY bankswitching cartridge
     */
-    static bool isProbablyCTY(const BytePtr& image, uInt32 size);
+    static bool isProbablyCTY(const uInt8* image, uInt32 size);
 
     /**
       Returns true if the image is probably a CV bankswitching cartridge
     */
-    static bool isProbablyCV(const BytePtr& image, uInt32 size);
+    static bool isProbablyCV(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a CV+ bankswitching cartridge
     */
-    static bool isProbablyCVPlus(const BytePtr& image, uInt32 size);
+    static bool isProbablyCVPlus(const uInt8* image, uInt32 size);
 
     /**
       Returns true if the image is probably a DASH bankswitching cartridge
     */
-    static bool isProbablyDASH(const BytePtr& image, uInt32 size);
+    static bool isProbablyDASH(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a DF/DFSC bankswitching cartridge
     */
-    static bool isProbablyDF(const BytePtr& image, uInt32 size, BSType& type);
+    static bool isProbablyDF(const uInt8* image, uInt32 size, BSType& type);
 
     /**
       Returns true if the image is probably a DPC+ bankswitching cartridge
     */
-    static bool isProbablyDPCplus(const BytePtr& image, uInt32 size);
+    static bool isProbablyDPCplus(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a E0 bankswitching cartridge
     */
-    static bool isProbablyE0(const BytePtr& image, uInt32 size);
+    static bool isProbablyE0(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a E7 bankswitching cartridge
     */
-    static bool isProbablyE7(const BytePtr& image, uInt32 size);
+    static bool isProbablyE7(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably an EF/EFSC bankswitching cartridge
     */
-    static bool isProbablyEF(const BytePtr& image, uInt32 size, BSType& type);
+    static bool isProbablyEF(const uInt8* image, uInt32 size,
+                             const SignatureHits& hits, BSType& type);
 
     /**
       Returns true if the image is probably an F6 bankswitching cartridge
     */
-    static bool isProbablyF6(const BytePtr& image, uInt32 size);
+    static bool isProbablyF6(const uInt8* image, uInt32 size);
 
     /**
       Returns true if the image is probably an FA2 bankswitching cartridge
     */
-    static bool isProbablyFA2(const BytePtr& image, uInt32 size);
+    static bool isProbablyFA2(const uInt8* image, uInt32 size);
 
     /**
       Returns true if the image is probably an FE bankswitching cartridge
     */
-    static bool isProbablyFE(const BytePtr& image, uInt32 size);
+    static bool isProbablyFE(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a MDM bankswitching cartridge
     */
-    static bool isProbablyMDM(const BytePtr& image, uInt32 size);
+    static bool isProbablyMDM(const uInt8* image, uInt32 size);
 
     /**
       Returns true if the image is probably a SB bankswitching cartridge
     */
-    static bool isProbablySB(const BytePtr& image, uInt32 size);
+    static bool isProbablySB(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a UA bankswitching cartridge
     */
-    static bool isProbablyUA(const BytePtr& image, uInt32 size);
+    static bool isProbablyUA(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably an X07 bankswitching cartridge
     */
-    static bool isProbablyX07(const BytePtr& image, uInt32 size);
+    static bool isProbablyX07(const SignatureHits& hits);
 
   private:
     // Following constructors and assignment operators not supported
@@ -41,6 +41,7 @@
 #include "Paddles.hxx"
 #include "Props.hxx"
 #include "PropsSet.hxx"
+#include "DetectionCache.hxx"
 #include "SaveKey.hxx"
 #include "Settings.hxx"
 #include "Sound.hxx"
@@ -79,7 +80,8 @@ Console::Console(OSystem& osystem, unique_ptr<Cartridge>& cart,
     myFramerate(0.0),     // Unknown framerate @ start
     myCurrentFormat(0),   // Unknown format @ start
     myUserPaletteDefined(false),
-    myConsoleTiming(ConsoleTiming::ntsc)
+    myConsoleTiming(ConsoleTiming::ntsc),
+    myLoadCount(0)
 {
   // Load user-defined palette for this ROM
   loadUserPalette();
@@ -114,35 +116,17 @@ Console::Console(OSystem& osystem, unique_ptr<Cartridge>& cart,
 
   if(myDisplayFormat == "AUTO" || myOSystem.settings().getBool("rominfo"))
   {
-    // Run the TIA, looking for PAL scanline patterns
-    // We turn off the SuperCharger progress bars, otherwise the SC BIOS
-    // will take over 250 frames!
-    // The 'fastscbios' option must be changed before the system is reset
-    bool fastscbios = myOSystem.settings().getBool("fastscbios");
-    myOSystem.settings().setValue("fastscbios", true);
-
-    uInt8 initialGarbageFrames = FrameManager::initialGarbageFrames();
-    uInt8 linesPAL = 0;
-    uInt8 linesNTSC = 0;
-
-    mySystem->reset(true);  // autodetect in reset enabled
-    myTIA->autodetectLayout(true);
-    for(int i = 0; i < 60; ++i) {
-      if (i > initialGarbageFrames)
-        myTIA->frameLayout() == FrameLayout::pal ? linesPAL++ : linesNTSC++;
-
-      myTIA->update();
+    // Use the result from a previous run of this ROM, if there was one
+    if(!myOSystem.detectionCache().getFormat(md5, myDisplayFormat))
+    {
+      myDisplayFormat = autodetectFrameLayout();
+      myOSystem.detectionCache().setFormat(md5, myDisplayFormat);
     }
-
-    myDisplayFormat = linesPAL > linesNTSC  ? "PAL" : "NTSC";
     if(myProperties.get(Display_Format) == "AUTO")
     {
       autodetected = "*";
       myCurrentFormat = 0;
     }
-
-    // Don't forget to reset the SC progress bars again
-    myOSystem.settings().setValue("fastscbios", fastscbios);
   }
   myConsoleInfo.DisplayFormat = myDisplayFormat + autodetected;
 
@@ -243,6 +227,9 @@ bool Console::save(Serializer& out) const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool Console::load(Serializer& in)
 {
+  // Even a failed load may have changed part of the state
+  ++myLoadCount;
+
   try
   {
     // First load state for the system
@@ -643,6 +630,46 @@ void Console::changeHeight(int direction)
   myProperties.set(Display_Height, val.str());
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string Console::autodetectFrameLayout()
+{
+  // Run the TIA, looking for PAL scanline patterns
+  // We turn off the SuperCharger progress bars, otherwise the SC BIOS
+  // will take over 250 frames!
+  // The 'fastscbios' option must be changed before the system is reset
+  bool fastscbios = myOSystem.settings().getBool("fastscbios");
+  myOSystem.settings().setValue("fastscbios", true);
+
+  const int numFrames = 60;
+  uInt8 initialGarbageFrames = FrameManager::initialGarbageFrames();
+  int linesPAL = 0;
+  int linesNTSC = 0;
+  int votesLeft = numFrames - 1 - initialGarbageFrames;
+
+  mySystem->reset(true);  // autodetect in reset enabled
+  myTIA->autodetectLayout(true);
+  myTIA->enableRendering(false);  // nothing is shown, so don't draw
+  for(int i = 0; i < numFrames; ++i) {
+    if (i > initialGarbageFrames)
+    {
+      myTIA->frameLayout() == FrameLayout::pal ? linesPAL++ : linesNTSC++;
+      --votesLeft;
+    }
+
+    // Stop as soon as the remaining frames can't change the result
+    if (linesPAL > linesNTSC + votesLeft || linesNTSC >= linesPAL + votesLeft)
+      break;
+
+    myTIA->update();
+  }
+  myTIA->enableRendering(true);
+
+  // Don't forget to reset the SC progress bars again
+  myOSystem.settings().setValue("fastscbios", fastscbios);
+
+  return linesPAL > linesNTSC ? "PAL" : "NTSC";
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Console::setTIAProperties()
 {
@@ -151,6 +151,12 @@ class Console : public Serializable
     */
     bool load(Serializer& in) override;
 
+    /**
+      Answer the number of times a state was loaded, so that anything
+      depending on the previous state can tell it was replaced.
+    */
+    uInt32 loadCount() const { return myLoadCount; }
+
     /**
       Get a descriptor for this console class (used in error checking).
 
@@ -304,6 +310,14 @@ class Console : public Serializable
     void toggleJitter() const;
 
   private:
+    /**
+      Runs the emulation for a while to find whether the ROM generates
+      NTSC- or PAL-like frames.  This stops as soon as the result is known.
+
+      @return  The display format detected ("NTSC" or "PAL")
+    */
+    string autodetectFrameLayout();
+
     /**
       Sets various properties of the TIA (YStart, Height, etc) based on
       the current display format.
@@ -396,6 +410,9 @@ class Console : public Serializable
     // Contains timing information for this console
     ConsoleTiming myConsoleTiming;
 
+    // The number of times a state was loaded
+    uInt32 myLoadCount;
+
     // Table of RGB values for NTSC, PAL and SECAM
     static uInt32 ourNTSCPalette[256];
     static uInt32 ourPALPalette[256];
@@ -0,0 +1,85 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2017 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+
+#include <fstream>
+
+#include "Version.hxx"
+#include "DetectionCache.hxx"
+
+const string DetectionCache::ourHeader =
+    string(";  Stella ") + STELLA_VERSION + " autodetection cache";
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+DetectionCache::DetectionCache(const string& filename)
+  : myFilename(filename),
+    myIsDirty(false)
+{
+  ifstream in(myFilename);
+  string line;
+  if(!in || !getline(in, line) || line != ourHeader)
+    return;
+
+  // Each line contains the MD5 and the format, separated by a space
+  while(getline(in, line))
+  {
+    string::size_type pos = line.find(' ');
+    if(pos == string::npos)
+      continue;
+
+    myFormats[line.substr(0, pos)] = line.substr(pos + 1);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool DetectionCache::getFormat(const string& md5, string& format) const
+{
+  const auto& iter = myFormats.find(md5);
+  if(iter == myFormats.end())
+    return false;
+
+  format = iter->second;
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void DetectionCache::setFormat(const string& md5, const string& format)
+{
+  string& value = myFormats[md5];
+  if(value != format)
+  {
+    value = format;
+    myIsDirty = true;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void DetectionCache::save()
+{
+  if(!myIsDirty)
+    return;
+
+  ofstream out(myFilename);
+  if(!out)
+    return;
+
+  out << ourHeader << endl;
+  for(const auto& iter: myFormats)
+    out << iter.first << " " << iter.second << endl;
+
+  myIsDirty = false;
+}
@@ -0,0 +1,91 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2017 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+
+#ifndef DETECTION_CACHE_HXX
+#define DETECTION_CACHE_HXX
+
+#include <map>
+
+#include "bspf.hxx"
+
+/**
+  This class remembers the results of autodetection for each ROM (keyed
+  by MD5), so that the emulation doesn't have to be run again to find
+  them each time the ROM is loaded.  Currently this is only the display
+  format found when 'Display.Format' is 'AUTO'.
+
+  The results are stored in a simple text file, which starts with the
+  version of Stella that created it; since a different version may
+  detect differently, a file from another version is ignored.
+*/
+class DetectionCache
+{
+  public:
+    /**
+      Create a cache, loading any previous results from the given file.
+
+      @param filename  The file the results are stored in
+    */
+    DetectionCache(const string& filename);
+
+    /**
+      Get the display format previously detected for the given ROM.
+
+      @param md5     The MD5 of the ROM
+      @param format  The format, if it was found
+
+      @return  True if the ROM was found in the cache
+    */
+    bool getFormat(const string& md5, string& format) const;
+
+    /**
+      Remember the display format detected for the given ROM.
+
+      @param md5     The MD5 of the ROM
+      @param format  The format detected
+    */
+    void setFormat(const string& md5, const string& format);
+
+    /**
+      Save the results to the cache file, if anything has changed.
+    */
+    void save();
+
+  private:
+    // Name of the file the results are stored in
+    string myFilename;
+
+    // Detected format for each MD5
+    std::map<string, string> myFormats;
+
+    // Whether results have been added since the file was loaded
+    bool myIsDirty;
+
+    // Identifies the version of Stella which created a cache file
+    static const string ourHeader;
+
+  private:
+    // Following constructors and assignment operators not supported
+    DetectionCache() = delete;
+    DetectionCache(const DetectionCache&) = delete;
+    DetectionCache(DetectionCache&&) = delete;
+    DetectionCache& operator=(const DetectionCache&) = delete;
+    DetectionCache& operator=(DetectionCache&&) = delete;
+};
+
+#endif
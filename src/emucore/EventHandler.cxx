@@ -40,6 +40,7 @@
 #include "Sound.hxx"
 #include "StateManager.hxx"
 #include "Switches.hxx"
+#include "TIACapture.hxx"
 #include "M6532.hxx"
 #include "MouseControl.hxx"
 #include "Version.hxx"
@@ -65,7 +66,8 @@ EventHandler::EventHandler(OSystem& osystem)
     mySkipMouseMotion(true),
     myAltKeyCounter(0),
     myContSnapshotInterval(0),
-    myContSnapshotCounter(0)
+    myContSnapshotCounter(0),
+    myContSnapshotDropped(0)
 {
   // Erase the key mapping array
   for(int i = 0; i < KBDK_LAST; ++i)
@@ -207,6 +209,11 @@ void EventHandler::poll(uInt64 time)
       cheat->evaluate();
   #endif
 
+  #ifdef DEBUGGER_SUPPORT
+    // Record the inputs, so the debugger can replay this frame
+    myOSystem.debugger().executionHistory().addFrame();
+  #endif
+
     // Handle continuous snapshots
     if(myContSnapshotInterval > 0 &&
       (++myContSnapshotCounter % myContSnapshotInterval == 0))
@@ -223,6 +230,15 @@ void EventHandler::poll(uInt64 time)
   // in the previous ::update() methods, they're now invalid
   myEvent.set(Event::MouseAxisXValue, 0);
   myEvent.set(Event::MouseAxisYValue, 0);
+
+  // Report snapshots saved (or failed) in the background
+  string message;
+  if(myOSystem.png().saveResult(message))
+    myOSystem.frameBuffer().showMessage(message);
+
+  // The same for a capture which couldn't be written
+  if(myOSystem.capture().checkError(message))
+    myOSystem.frameBuffer().showMessage(message);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -438,6 +454,16 @@ void EventHandler::handleKeyEvent(StellaKey key, StellaMod mod, bool state)
           myOSystem.state().toggleRewindMode();
           break;
 
+        case KBDK_A:  // Alt-a toggles A/V capture
+          toggleCapture();
+          break;
+
+#ifdef DEBUGGER_SUPPORT
+        case KBDK_T:  // Alt-t saves the instructions traced by 'tracelog'
+          myOSystem.frameBuffer().showMessage(myOSystem.debugger().saveTrace());
+          break;
+#endif
+
         case KBDK_S:
           if(myContSnapshotInterval == 0)
           {
@@ -458,10 +484,14 @@ void EventHandler::handleKeyEvent(StellaKey key, StellaMod mod, bool state)
           }
           else
           {
+            // Snapshots are dropped when they can't be saved quickly enough
+            uInt32 dropped = myOSystem.png().droppedImages() - myContSnapshotDropped;
             ostringstream buf;
             buf << "Disabling snapshots, generated "
-                << (myContSnapshotCounter / myContSnapshotInterval)
+                << (myContSnapshotCounter / myContSnapshotInterval - dropped)
                 << " files";
+            if(dropped > 0)
+              buf << " (" << dropped << " dropped)";
             myOSystem.frameBuffer().showMessage(buf.str());
             setContinuousSnapshots(0);
           }
@@ -833,6 +863,7 @@ void EventHandler::handleSystemEvent(SystemEvent e, int, int)
   switch(e)
   {
     case EVENT_WINDOW_EXPOSED:
+      myOSystem.frameBuffer().requestRedraw();
       myOSystem.frameBuffer().update();
       break;
 
@@ -1877,20 +1908,15 @@ void EventHandler::takeSnapshot(uInt32 number)
   else if(!myOSystem.settings().getBool("sssingle"))
   {
     // Determine if the file already exists, checking each successive filename
-    // until one doesn't exist
+    // until one doesn't exist; names of snapshots still waiting to be saved
+    // are taken too
+    PNGLibrary& png = myOSystem.png();
     filename = sspath + ".png";
-    FilesystemNode node(filename);
-    if(node.exists())
+    for(uInt32 i = 1; FilesystemNode(filename).exists() ||
+                      png.isSavePending(filename); ++i)
     {
       ostringstream buf;
-      for(uInt32 i = 1; ;++i)
-      {
-        buf.str("");
-        buf << sspath << "_" << i << ".png";
-        FilesystemNode next(buf.str());
-        if(!next.exists())
-          break;
-      }
+      buf << sspath << "_" << i << ".png";
       filename = buf.str();
     }
   }
@@ -1910,19 +1936,14 @@ void EventHandler::takeSnapshot(uInt32 number)
   // Now create a PNG snapshot
   if(myOSystem.settings().getBool("ss1x"))
   {
-    string message = "Snapshot saved";
-    try
-    {
-      GUI::Rect rect;
-      const FBSurface& surface = myOSystem.frameBuffer().tiaSurface().baseSurface(rect);
-      myOSystem.png().saveImage(filename, surface, rect, comments);
-    }
-    catch(const runtime_error& e)
-    {
-      message = e.what();
-    }
-    if(showmessage)
-      myOSystem.frameBuffer().showMessage(message);
+    // The image is compressed and saved in the background
+    GUI::Rect rect;
+    const FBSurface& surface = myOSystem.frameBuffer().tiaSurface().baseSurface(rect);
+    // Success is reported once the image has actually been written
+    if(!myOSystem.png().saveImageAsync(filename, surface, rect, comments,
+                                       showmessage) && showmessage)
+      myOSystem.frameBuffer().showMessage(
+          "Snapshot dropped, too many waiting to be saved");
   }
   else
   {
@@ -1930,20 +1951,13 @@ void EventHandler::takeSnapshot(uInt32 number)
     myOSystem.frameBuffer().enableMessages(false);
     myOSystem.frameBuffer().tiaSurface().reRender();
 
-    string message = "Snapshot saved";
-    try
-    {
-      myOSystem.png().saveImage(filename, comments);
-    }
-    catch(const runtime_error& e)
-    {
-      message = e.what();
-    }
+    bool queued = myOSystem.png().saveImageAsync(filename, comments, showmessage);
 
     // Re-enable old messages
     myOSystem.frameBuffer().enableMessages(true);
-    if(showmessage)
-      myOSystem.frameBuffer().showMessage(message);
+    if(!queued && showmessage)
+      myOSystem.frameBuffer().showMessage(
+          "Snapshot dropped, too many waiting to be saved");
   }
 }
 
@@ -1997,6 +2011,49 @@ void EventHandler::setContinuousSnapshots(uInt32 interval)
 {
   myContSnapshotInterval = interval;
   myContSnapshotCounter = 0;
+  if(interval > 0)
+    myContSnapshotDropped = myOSystem.png().droppedImages();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void EventHandler::toggleCapture()
+{
+  TIACapture& capture = myOSystem.capture();
+  ostringstream buf;
+
+  if(capture.isCapturing())
+  {
+    capture.stop();
+    buf << "Capture stopped, " << capture.capturedFrames() << " frames";
+    if(capture.droppedFrames() > 0)
+      buf << " (" << capture.droppedFrames() << " dropped)";
+  }
+  else
+  {
+    // Captures are named like snapshots, but are never overwritten
+    string path = myOSystem.snapshotSaveDir() +
+        (myOSystem.settings().getString("snapname") != "int" ?
+            myOSystem.romFile().getNameWithExt("")
+          : myOSystem.console().properties().get(Cartridge_Name));
+    string filename = path + ".a26cap";
+    for(uInt32 i = 1; FilesystemNode(filename).exists(); ++i)
+    {
+      ostringstream name;
+      name << path << "_" << i << ".a26cap";
+      filename = name.str();
+    }
+
+    try
+    {
+      capture.start(filename, myOSystem.console().getFramerate());
+      buf << "Capture started";
+    }
+    catch(const runtime_error& e)
+    {
+      buf << e.what();
+    }
+  }
+  myOSystem.frameBuffer().showMessage(buf.str());
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
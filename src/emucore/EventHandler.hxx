@@ -165,6 +165,12 @@ class EventHandler
     */
     void setContinuousSnapshots(uInt32 interval);
 
+    /**
+      Start or stop capturing TIA output and sound to a file (saved in
+      the snapshot directory).
+    */
+    void toggleCapture();
+
     inline bool kbdAlt(int mod) const
     {
   #if defined(BSPF_MAC_OSX) || defined(OSX_KEYS)
@@ -602,6 +608,7 @@ class EventHandler
     // Used for continuous snapshot mode
     uInt32 myContSnapshotInterval;
     uInt32 myContSnapshotCounter;
+    uInt32 myContSnapshotDropped;
 
     // Holds static strings for the remap menu (emulation and menu events)
     static ActionList ourEmulActionList[kEmulActionListSize];
@@ -201,6 +201,13 @@ class FBSurface
     */
     virtual void setDirty() { }
 
+    /**
+      This method should be called to indicate that the surface should be
+      redrawn at the next interval, but that its pixel data is unchanged
+      since it was last rendered (so it needn't be uploaded again).
+    */
+    virtual void setRedrawOnly() { }
+
     //////////////////////////////////////////////////////////////////////////
     // Note:  The following methods are FBSurface-specific, and must be
     //        implemented in child classes.
@@ -73,6 +73,18 @@ bool FilesystemNode::getChildren(FSList& fslist, ListMode mode, bool hidden) con
   return true;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool FilesystemNode::listChildren(const ChildHandler& handler, ListMode mode,
+                                  bool hidden) const
+{
+  if (!_realNode || !_realNode->isDirectory())
+    return false;
+
+  return _realNode->listChildren([&handler](AbstractFSNode* node) {
+    return handler(FilesystemNode(node));
+  }, mode, hidden);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 const string& FilesystemNode::getName() const
 {
@@ -172,6 +184,12 @@ bool FilesystemNode::rename(const string& newfile)
   return (_realNode && _realNode->exists()) ? _realNode->rename(newfile) : false;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool FilesystemNode::getStamp(uInt64& size, uInt64& mtime) const
+{
+  return _realNode ? _realNode->getStamp(size, mtime) : false;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt32 FilesystemNode::read(BytePtr& image) const
 {
@@ -201,3 +219,23 @@ uInt32 FilesystemNode::read(BytePtr& image) const
   else
     throw runtime_error("ZLIB open/read error");
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool AbstractFSNode::listChildren(const ChildHandler& handler, ListMode mode,
+                                  bool hidden) const
+{
+  AbstractFSList tmp;
+  if (!getChildren(tmp, mode, hidden))
+    return false;
+
+  auto i = tmp.cbegin();
+  while (i != tmp.cend() && handler(*i))
+    ++i;
+
+  // Nodes which weren't passed on must be deleted here
+  if (i != tmp.cend())
+    for (++i; i != tmp.cend(); ++i)
+      delete *i;
+
+  return true;
+}
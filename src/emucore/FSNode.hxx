@@ -22,6 +22,7 @@
 #define FS_NODE_HXX
 
 #include <algorithm>
+#include <functional>
 
 /*
  * The API described in this header is meant to allow for file system browsing in a
@@ -147,6 +148,19 @@ class FilesystemNode
     virtual bool getChildren(FSList &fslist, ListMode mode = kListDirectoriesOnly,
                              bool hidden = false) const;
 
+    /**
+     * Pass each child node of this directory node to the given function
+     * as soon as it's found, instead of collecting all of them first.
+     * Listing stops early when the function returns false.
+     *
+     * @return true if successful, false otherwise (e.g. when the directory
+     *         does not exist).
+     */
+    using ChildHandler = std::function<bool(const FilesystemNode&)>;
+    bool listChildren(const ChildHandler& handler,
+                      ListMode mode = kListDirectoriesOnly,
+                      bool hidden = false) const;
+
     /**
      * Return a string representation of the name of the file. This is can be
      * used e.g. by detection code that relies on matching the name of a given
@@ -239,6 +253,18 @@ class FilesystemNode
      */
     virtual bool rename(const string& newfile);
 
+    /**
+     * Get the size and last modification time of the file, so that it can
+     * be detected whether the file changed since it was last read.  For
+     * files in a ZIP archive, these are taken from the archive itself.
+     *
+     * @param size   Receives the size of the file
+     * @param mtime  Receives the modification time of the file
+     *
+     * @return bool true if the values are available, false otherwise.
+     */
+    virtual bool getStamp(uInt64& size, uInt64& mtime) const;
+
     /**
      * Read data (binary format) into the given buffer.
      *
@@ -313,6 +339,17 @@ class AbstractFSNode
      */
     virtual bool getChildren(AbstractFSList& list, ListMode mode, bool hidden) const = 0;
 
+    /**
+     * As getChildren(), but each child node is passed to the given function
+     * as soon as it's found (which then owns it).  Listing stops early when
+     * the function returns false.  By default, all children are listed
+     * with getChildren() first; subclasses for which listing can be slow
+     * should override this.
+     */
+    using ChildHandler = std::function<bool(AbstractFSNode*)>;
+    virtual bool listChildren(const ChildHandler& handler, ListMode mode,
+                              bool hidden) const;
+
     /**
      * Returns the last component of the path pointed by this FilesystemNode.
      *
@@ -387,6 +424,12 @@ class AbstractFSNode
      */
     virtual bool rename(const string& newfile) = 0;
 
+    /**
+     * Get the size and last modification time of the file; nodes which
+     * can't provide them simply return false.
+     */
+    virtual bool getStamp(uInt64& size, uInt64& mtime) const { return false; }
+
     /**
      * Read data (binary format) into the given buffer.
      *
@@ -34,6 +34,7 @@
 #include "OSystem.hxx"
 #include "Settings.hxx"
 #include "TIA.hxx"
+#include "TIACapture.hxx"
 
 #include "FBSurface.hxx"
 #include "TIASurface.hxx"
@@ -48,6 +49,9 @@ FrameBuffer::FrameBuffer(OSystem& osystem)
   : myOSystem(osystem),
     myInitializedCount(0),
     myPausedCount(0),
+    myVsyncEnabled(true),
+    myRedrawPending(true),
+    myShowMessages(osystem.settings(), "uimessages"),
     myCurrentModeList(nullptr)
 {
   myMsg.surface = myStatsMsg.surface = nullptr;
@@ -184,6 +188,8 @@ FBInitStatus FrameBuffer::createDisplay(const string& title,
 
   // Set the available video modes for this framebuffer
   setAvailableVidModes(width, height);
+  myVsyncEnabled = myOSystem.settings().getBool("vsync");
+  myRedrawPending = true;
 
   // Initialize video subsystem (make sure we get a valid mode)
   string pre_about = about();
@@ -250,7 +256,6 @@ void FrameBuffer::update()
   // Take care of S_EMULATE mode here, otherwise let the GUI
   // figure out what to draw
 
-  invalidate();
   switch(myOSystem.eventHandler().state())
   {
     case EventHandler::S_EMULATE:
@@ -260,12 +265,28 @@ void FrameBuffer::update()
       // the EventHandler state 'behind our back' - we need to check for that
       myOSystem.console().tia().update();
   #ifdef DEBUGGER_SUPPORT
-      if(myOSystem.eventHandler().state() != EventHandler::S_EMULATE) break;
+      if(myOSystem.eventHandler().state() != EventHandler::S_EMULATE)
+      {
+        invalidate();
+        break;
+      }
   #endif
       if(myOSystem.eventHandler().frying())
         myOSystem.console().fry();
 
+      // Record every frame when capturing, even unchanged ones
+      if(myOSystem.capture().isCapturing())
+      {
+        const TIA& tia = myOSystem.console().tia();
+        myOSystem.capture().addFrame(tia.frameBuffer(), tia.width(), tia.height());
+      }
+
+      // Identical frames (ie, idling games) needn't be drawn again
+      if(tiaFrameUnchanged())
+        return;
+
       // And update the screen
+      invalidate();
       myTIASurface->render();
 
       // Show frame statistics
@@ -290,19 +311,25 @@ void FrameBuffer::update()
 
     case EventHandler::S_PAUSE:
     {
-      myTIASurface->render();
-
       // Show a pause message every 5 seconds
       if(myPausedCount++ >= 7*myOSystem.frameRate())
       {
         myPausedCount = 0;
         showMessage("Paused", kMiddleCenter);
       }
+
+      // The paused image only needs to be drawn again when it's covered
+      if(tiaFrameUnchanged())
+        return;
+
+      invalidate();
+      myTIASurface->render();
       break;  // S_PAUSE
     }
 
     case EventHandler::S_MENU:
     {
+      invalidate();
       myTIASurface->render();
       myOSystem.menu().draw(true);
       break;  // S_MENU
@@ -310,6 +337,7 @@ void FrameBuffer::update()
 
     case EventHandler::S_CMDMENU:
     {
+      invalidate();
       myTIASurface->render();
       myOSystem.commandMenu().draw(true);
       break;  // S_CMDMENU
@@ -317,6 +345,7 @@ void FrameBuffer::update()
 
     case EventHandler::S_LAUNCHER:
     {
+      invalidate();
       myOSystem.launcher().draw(true);
       break;  // S_LAUNCHER
     }
@@ -324,15 +353,37 @@ void FrameBuffer::update()
 #ifdef DEBUGGER_SUPPORT
     case EventHandler::S_DEBUGGER:
     {
-      myOSystem.debugger().draw(true);
+      // Only the widgets which changed are drawn again, and the screen
+      // isn't updated at all when nothing changed
+      Debugger& debugger = myOSystem.debugger();
+      if(myRedrawPending)
+      {
+        invalidate();
+        debugger.draw(true);
+      }
+      else if(debugger.drawChanges() || myVsyncEnabled)
+      {
+        invalidate();
+        debugger.render();
+      }
+      else
+        return;
       break;  // S_DEBUGGER
     }
 #endif
 
     default:
+      invalidate();
       return;
   }
 
+  // Anything drawn over the TIA image must eventually be erased again,
+  // and GUI modes don't show the (plain) TIA image at all
+  EventHandler::State state = myOSystem.eventHandler().state();
+  myRedrawPending = myMsg.enabled || myStatsMsg.enabled ||
+      (state != EventHandler::S_EMULATE && state != EventHandler::S_PAUSE &&
+       state != EventHandler::S_DEBUGGER);
+
   // Draw any pending messages
   if(myMsg.enabled)
     drawMessage();
@@ -341,12 +392,23 @@ void FrameBuffer::update()
   postFrameUpdate();
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool FrameBuffer::tiaFrameUnchanged()
+{
+  // Presenting the frame is needed to keep in step with vsync, and when
+  // something other than the TIA image is (or was) onscreen
+  if(myVsyncEnabled || myRedrawPending || myMsg.enabled || myStatsMsg.enabled)
+    return false;
+
+  return !myTIASurface->changed();
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void FrameBuffer::showMessage(const string& message, MessagePosition position,
                               bool force)
 {
   // Only show messages if they've been enabled
-  if(!(force || myOSystem.settings().getBool("uimessages")))
+  if(!(force || myShowMessages()))
     return;
 
   // Precompute the message coordinates
@@ -504,6 +566,9 @@ void FrameBuffer::setPalette(const uInt32* raw_palette)
 
   // Let the TIA surface know about the new palette
   myTIASurface->setPalette(myPalette, raw_palette);
+
+  // Captures store the palette in RGB format
+  myOSystem.capture().setPalette(raw_palette);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -512,6 +577,7 @@ void FrameBuffer::stateChanged(EventHandler::State state)
   // Make sure any onscreen messages are removed
   myMsg.enabled = false;
   myMsg.counter = 0;
+  myRedrawPending = true;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -532,6 +598,7 @@ void FrameBuffer::setFullscreen(bool enable)
     myOSystem.settings().setValue("fullscreen", fullScreen());
     resetSurfaces();
     setCursorState();
+    myRedrawPending = true;
   }
 }
 
@@ -570,6 +637,7 @@ bool FrameBuffer::changeWindowedVidMode(int direction)
     myTIASurface->initialize(myOSystem.console(), mode);
 
     resetSurfaces();
+    myRedrawPending = true;
     showMessage(mode.description);
     myOSystem.settings().setValue("tia.zoom", mode.zoom);
     return true;
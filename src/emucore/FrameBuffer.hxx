@@ -34,6 +34,7 @@ namespace GUI {
 #include "FBSurface.hxx"
 #include "TIASurface.hxx"
 #include "FrameManager.hxx"
+#include "Settings.hxx"
 #include "bspf.hxx"
 
 // Return values for initialization of framebuffer window
@@ -165,6 +166,12 @@ class FrameBuffer
     */
     void update();
 
+    /**
+      Forces the next call to update() to redraw and present the entire
+      display, even when the TIA image itself hasn't changed.
+    */
+    void requestRedraw() { myRedrawPending = true; }
+
     /**
       Shows a message onscreen.
 
@@ -402,6 +409,12 @@ class FrameBuffer
     uInt32 myPalette[256+kNumColors];
 
   private:
+    /**
+      Answers whether presenting the current TIA image can be skipped
+      altogether, since the screen already shows exactly that image.
+    */
+    bool tiaFrameUnchanged();
+
     /**
       Draw pending messages.
     */
@@ -477,6 +490,17 @@ class FrameBuffer
     // Used to set intervals between messages while in pause mode
     uInt32 myPausedCount;
 
+    // Whether frames are synchronized to the display refresh; if not,
+    // presenting an unchanged TIA image can be skipped
+    bool myVsyncEnabled;
+
+    // Indicates that the screen contents no longer match the last
+    // rendered TIA image (ie, messages or a different mode were shown)
+    bool myRedrawPending;
+
+    // Whether messages are shown (the 'uimessages' setting)
+    SettingHandle<bool> myShowMessages;
+
     // Dimensions of the actual image, after zooming, and taking into account
     // any image 'centering'
     GUI::Rect myImageRect;
@@ -18,6 +18,7 @@
 #ifdef DEBUGGER_SUPPORT
   #include "Debugger.hxx"
   #include "Expression.hxx"
+  #include "ExpressionCode.hxx"
   #include "CartDebug.hxx"
   #include "PackedBitArray.hxx"
 
@@ -66,9 +67,26 @@ M6502::M6502(const Settings& settings)
 #ifdef DEBUGGER_SUPPORT
   myDebugger = nullptr;
   myJustHitTrapFlag = false;
+  myStopAddresses = nullptr;
+  myStopCondition = nullptr;
+  myHitStopPoint = false;
+  myStopCycle = kNoStopCycle;
+  myInstructionCycle = 0;
+  myWriteWatch = nullptr;
+  myWriteWatchCycle = nullptr;
+  myInstructionPC = 0;
+  myCondBreakRAMChanged = true;
+  myTrace = nullptr;
+  myTraceEntry = nullptr;
+  myProfiler = nullptr;
 #endif
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+M6502::~M6502()
+{
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void M6502::install(System& system)
 {
@@ -132,6 +150,14 @@ inline uInt8 M6502::peek(uInt16 address, uInt8 flags)
 
   uInt8 result = mySystem->peek(address, flags);
   myLastPeekAddress = address;
+
+#ifdef DEBUGGER_SUPPORT
+  // The opcode and operands are added to the trace as they're fetched
+  if(myTraceEntry && flags == DISASM_CODE && myTraceEntry->size < 3 &&
+     address == uInt16(myTraceEntry->pc + myTraceEntry->size))
+    myTraceEntry->bytes[myTraceEntry->size++] = result;
+#endif  // DEBUGGER_SUPPORT
+
   return result;
 }
 
@@ -155,6 +181,10 @@ inline void M6502::poke(uInt16 address, uInt8 value, uInt8 flags)
     myHitTrapInfo.message = "WTrap: ";
     myHitTrapInfo.address = address;
   }
+  if(ExpressionCode::isRAM(address) && myCondBreakRAM[address & 0x7f])
+    myCondBreakRAMChanged = true;
+  if(myWriteWatch && myWriteWatch->isSet(address))
+    *myWriteWatchCycle = myInstructionCycle;
 #endif  // DEBUGGER_SUPPORT
 
   mySystem->poke(address, value, flags); 
@@ -172,23 +202,78 @@ void M6502::requestHalt()
 inline void M6502::handleHalt()
 {
   if (myHaltRequested) {
+#ifdef DEBUGGER_SUPPORT
+    const uInt64 cycles = mySystem->cycles();
+    myOnHaltCallback();
+    if(myProfiler)
+      myProfiler->addHalt(uInt32(mySystem->cycles() - cycles));
+#else
     myOnHaltCallback();
+#endif
     myHaltRequested = false;
   }
 }
 
+#ifdef DEBUGGER_SUPPORT
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+inline Int32 M6502::evalCondBreaks()
+{
+  bool ramChanged = myCondBreakRAMChanged;
+  myCondBreakRAMChanged = false;
+
+  for(uInt32 i = 0; i < myBreakCodes.size(); i++)
+  {
+    const ExpressionCode& code = *myBreakCodes[i];
+    if((ramChanged || !code.isRAMOnly()) && code.evaluate())
+    {
+      // Check again next time, in case the debugger isn't started
+      myCondBreakRAMChanged = ramChanged;
+      return i;
+    }
+  }
+
+  return -1; // no break hit
+}
+#endif  // DEBUGGER_SUPPORT
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool M6502::execute(uInt32 number)
 {
   // Clear all of the execution status bits except for the fatal error bit
   myExecutionStatus &= FatalErrorBit;
 
+#ifdef DEBUGGER_SUPPORT
+  myHitStopPoint = false;
+
+  // RAM may have been changed from outside the CPU (in the debugger,
+  // or by loading a state)
+  myCondBreakRAMChanged = true;
+#endif
+
   // Loop until execution is stopped or a fatal error occurs
   for(;;)
   {
     for(; !myExecutionStatus && (number != 0); --number)
     {
 #ifdef DEBUGGER_SUPPORT
+      if((myStopAddresses && myStopAddresses->isSet(PC)) ||
+         (myStopCondition && myStopCondition->evaluate()))
+      {
+        myHitStopPoint = true;
+        return true;
+      }
+
+      if(myStopCycle != kNoStopCycle)
+      {
+        handleHalt();
+        myInstructionCycle = mySystem->cycles();
+        if(myInstructionCycle >= myStopCycle)
+        {
+          myHitStopPoint = true;
+          return true;
+        }
+      }
+
       if(myJustHitTrapFlag)
       {
         if(myDebugger && myDebugger->start(myHitTrapInfo.message, myHitTrapInfo.address))
@@ -209,6 +294,18 @@ bool M6502::execute(uInt32 number)
         if(myDebugger && myDebugger->start(buf))
           return true;
       }
+
+      myInstructionPC = PC;
+      if(myProfiler)
+      {
+        // Credit a halt caused by the previous instruction (ie, STA WSYNC)
+        // to that instruction; otherwise the opcode fetch below would
+        // handle it after the next instruction was started
+        handleHalt();
+        myProfiler->addInstruction(PC);
+      }
+      if(myTrace)
+        myTraceEntry = &myTrace->add(PC, A, X, Y, SP, PS());
 #endif  // DEBUGGER_SUPPORT
 
       uInt16 operandAddress = 0, intermediateAddress = 0;
@@ -407,11 +504,41 @@ void M6502::attach(Debugger& debugger)
   myDebugger = &debugger;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void M6502::setStopPoints(const PackedBitArray* addresses,
+                          const ExpressionCode* condition)
+{
+  myStopAddresses = addresses;
+  myStopCondition = condition;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void M6502::setWriteWatch(const PackedBitArray* addresses, uInt64* cycle)
+{
+  myWriteWatch = addresses;
+  myWriteWatchCycle = cycle;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void M6502::setTrace(ExecutionTrace* trace)
+{
+  myTrace = trace;
+  myTraceEntry = nullptr;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void M6502::setProfiler(CycleProfiler* profiler)
+{
+  myProfiler = profiler;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt32 M6502::addCondBreak(Expression* e, const string& name)
 {
   myBreakConds.emplace_back(e);
+  myBreakCodes.emplace_back(make_unique<ExpressionCode>(*e));
   myBreakCondNames.push_back(name);
+  updateCondBreakRAM();
   return uInt32(myBreakConds.size() - 1);
 }
 
@@ -421,7 +548,9 @@ void M6502::delCondBreak(uInt32 brk)
   if(brk < myBreakConds.size())
   {
     Vec::removeAt(myBreakConds, brk);
+    Vec::removeAt(myBreakCodes, brk);
     Vec::removeAt(myBreakCondNames, brk);
+    updateCondBreakRAM();
   }
 }
 
@@ -429,7 +558,20 @@ void M6502::delCondBreak(uInt32 brk)
 void M6502::clearCondBreaks()
 {
   myBreakConds.clear();
+  myBreakCodes.clear();
   myBreakCondNames.clear();
+  updateCondBreakRAM();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void M6502::updateCondBreakRAM()
+{
+  myCondBreakRAM.reset();
+  for(const auto& code: myBreakCodes)
+    for(uInt8 address: code->ramAddresses())
+      myCondBreakRAM.set(address);
+
+  myCondBreakRAMChanged = true;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
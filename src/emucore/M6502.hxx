@@ -21,8 +21,12 @@
 #ifdef DEBUGGER_SUPPORT
   class Debugger;
   class CpuDebug;
+  class ExpressionCode;
 
+  #include <bitset>
+  #include "CycleProfiler.hxx"
   #include "Expression.hxx"
+  #include "ExecutionTrace.hxx"
   #include "PackedBitArray.hxx"
 #endif
 
@@ -61,7 +65,7 @@ class M6502 : public Serializable
       Create a new 6502 microprocessor.
     */
     M6502(const Settings& settings);
-    virtual ~M6502() = default;
+    virtual ~M6502();
 
   public:
     /**
@@ -214,6 +218,63 @@ class M6502 : public Serializable
     void delCondBreak(uInt32 brk);
     void clearCondBreaks();
     const StringList& getCondBreakNames() const;
+
+    /**
+      Set the addresses and/or condition at which execution is stopped
+      (without starting the debugger), before the next instruction is
+      executed.  This lets the debugger run to a certain point at full
+      speed.  Passing nullptr for both removes the stop points.
+
+      @param addresses  The addresses to stop at, or nullptr for none
+      @param condition  The condition to stop at, or nullptr for none
+    */
+    void setStopPoints(const PackedBitArray* addresses,
+                       const ExpressionCode* condition);
+
+    /**
+      Answer whether the last call to execute() returned because one of
+      the stop points was hit.
+    */
+    bool hitStopPoint() const { return myHitStopPoint; }
+
+    /**
+      Set the system cycle at which execution is stopped (as for the stop
+      points above), before the first instruction starting at or after it
+      is executed.  Any pending halt is handled first, so instructions
+      start at the same cycles as when single stepping.  Passing
+      kNoStopCycle removes the stop cycle.
+    */
+    void setStopCycle(uInt64 cycle) { myStopCycle = cycle; }
+    static constexpr uInt64 kNoStopCycle = ~uInt64(0);
+
+    /**
+      Set the addresses whose writes are watched, or nullptr for none.
+      This only works while a stop cycle is set, and is much cheaper than
+      write traps, since the debugger isn't started.
+
+      @param addresses  The addresses to watch (including any mirrors)
+      @param cycle      Receives the cycle at which the last instruction
+                        writing to one of the addresses started
+    */
+    void setWriteWatch(const PackedBitArray* addresses, uInt64* cycle);
+
+    /**
+      Answer the address of the instruction currently being executed
+      (or of the last one executed, between instructions).
+    */
+    uInt16 instructionPC() const { return myInstructionPC; }
+
+    /**
+      Set the trace which every executed instruction is added to, or
+      nullptr to stop adding them.
+    */
+    void setTrace(ExecutionTrace* trace);
+
+    /**
+      Set the profiler which the time taken by every executed instruction
+      is credited to, or nullptr to stop profiling.
+    */
+    void setProfiler(CycleProfiler* profiler);
 #endif  // DEBUGGER_SUPPORT
 
   private:
@@ -351,13 +412,10 @@ class M6502 : public Serializable
     bool myHaltRequested;
 
 #ifdef DEBUGGER_SUPPORT
-    Int32 evalCondBreaks() {
-      for(uInt32 i = 0; i < myBreakConds.size(); i++)
-        if(myBreakConds[i]->evaluate())
-          return i;
+    Int32 evalCondBreaks();
 
-      return -1; // no break hit
-    }
+    // Find the RIOT RAM bytes which some conditions depend on exclusively
+    void updateCondBreakRAM();
 
     /// Pointer to the debugger for this processor or the null pointer
     Debugger* myDebugger;
@@ -374,7 +432,38 @@ class M6502 : public Serializable
     HitTrapInfo myHitTrapInfo;
 
     vector<unique_ptr<Expression>> myBreakConds;
+    vector<unique_ptr<ExpressionCode>> myBreakCodes;
     StringList myBreakCondNames;
+
+    // Conditions which only read RIOT RAM are evaluated only after one
+    // of the bytes they read was written
+    std::bitset<128> myCondBreakRAM;
+    bool myCondBreakRAMChanged;
+
+    // Temporary stop points, used by the debugger to run to an address
+    // or condition (see setStopPoints)
+    const PackedBitArray* myStopAddresses;
+    const ExpressionCode* myStopCondition;
+    bool myHitStopPoint;
+
+    // The cycle to stop at, and the addresses whose writes are watched
+    // (see setStopCycle and setWriteWatch); the start cycle of the current
+    // instruction is only updated while a stop cycle is set
+    uInt64 myStopCycle;
+    uInt64 myInstructionCycle;
+    const PackedBitArray* myWriteWatch;
+    uInt64* myWriteWatchCycle;
+
+    // The address of the current instruction (see instructionPC)
+    uInt16 myInstructionPC;
+
+    // The trace to record instructions in, and the entry for the
+    // current instruction (see setTrace)
+    ExecutionTrace* myTrace;
+    ExecutionTrace::Entry* myTraceEntry;
+
+    // The profiler to credit instructions to (see setProfiler)
+    CycleProfiler* myProfiler;
 #endif  // DEBUGGER_SUPPORT
 
   private:
@@ -97,8 +97,36 @@ void M6532::update()
   port1.update();
   myConsole.switches().update();
 
+  updatePA7(prevPA7);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool M6532::saveInputs(Serializer& out) const
+{
+  return myConsole.leftController().save(out) &&
+         myConsole.rightController().save(out) &&
+         myConsole.switches().save(out);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool M6532::loadInputs(Serializer& in)
+{
+  Controller& port0 = myConsole.leftController();
+  bool prevPA7 = port0.myDigitalPinState[Controller::Four];
+
+  if(!(port0.load(in) && myConsole.rightController().load(in) &&
+       myConsole.switches().load(in)))
+    return false;
+
+  updatePA7(prevPA7);
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void M6532::updatePA7(bool prevPA7)
+{
   // Get new PA7 state
-  bool currPA7 = port0.myDigitalPinState[Controller::Four];
+  bool currPA7 = myConsole.leftController().myDigitalPinState[Controller::Four];
 
   // PA7 Flag is set on active transition in appropriate direction
   if((!myEdgeDetectPositive && prevPA7 && !currPA7) ||
@@ -65,6 +65,17 @@ class M6532 : public Device
     */
     void update();
 
+    /**
+      Save/load the state of the controllers and console switches, as
+      set by update().  This is used to record the input received each
+      frame (eg, for replaying the emulation in the debugger); loading
+      also sets the PA7 flag if the new state is an active transition.
+
+      @return  False on any errors, else true
+    */
+    bool saveInputs(Serializer& out) const;
+    bool loadInputs(Serializer& in);
+
     /**
       Install 6532 in the specified system.  Invoked by the system
       when the 6532 is attached to it.
@@ -130,6 +141,10 @@ class M6532 : public Device
     void setTimerRegister(uInt8 data, uInt8 interval);
     void setPinState(bool shcha);
 
+    // Set the PA7 flag if the change from the given PA7 state to the
+    // current one is an active transition
+    void updatePA7(bool prevPA7);
+
     void updateEmulation();
 
     // The following are used by the debugger to read INTIM/TIMINT
@@ -43,6 +43,7 @@
 #include "CartDetector.hxx"
 #include "Settings.hxx"
 #include "PropsSet.hxx"
+#include "DetectionCache.hxx"
 #include "EventHandler.hxx"
 #include "Menu.hxx"
 #include "CommandMenu.hxx"
@@ -52,6 +53,7 @@
 #include "Random.hxx"
 #include "SerialPort.hxx"
 #include "StateManager.hxx"
+#include "TIACapture.hxx"
 #include "Version.hxx"
 
 #include "OSystem.hxx"
@@ -59,10 +61,12 @@
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 OSystem::OSystem()
   : myLauncherUsed(false),
-    myQuitLoop(false)
+    myQuitLoop(false),
+    myStartupDone(false)
 {
   // Calculate startup time
   myMillisAtStart = uInt32(time(NULL) * 1000);
+  myStartupTime = getTicks();
 
   // Get built-in features
   #ifdef SOUND_SUPPORT
@@ -89,6 +93,8 @@ OSystem::OSystem()
   myBuildInfo = info.str();
 
   mySettings = MediaFactory::createSettings(*this);
+  myLogLevel.bind(*mySettings, "loglevel");
+  myLogToConsole.bind(*mySettings, "logtoconsole");
   myRandom = make_unique<Random>(*this);
 }
 
@@ -122,25 +128,34 @@ bool OSystem::create()
   catch(...) { return false; }
   if(!myFrameBuffer->initialize())
     return false;
+  startupPhase("Initialize video");
 
   // Create the event handler for the system
   myEventHandler = MediaFactory::createEventHandler(*this);
   myEventHandler->initialize();
+  startupPhase("Initialize event handler");
 
   // Create a properties set for us to use and set it up
   myPropSet = make_unique<PropertiesSet>(propertiesFile());
 
+  // Remember autodetection results between runs
+  myDetectionCache = make_unique<DetectionCache>(myBaseDir + "autodetect.cache");
+
 #ifdef CHEATCODE_SUPPORT
   myCheatManager = make_unique<CheatManager>(*this);
-  myCheatManager->loadCheatDatabase();
 #endif
+  startupPhase("Load properties");
 
   // Create menu and launcher GUI objects
+  // Their dialogs are only created when first shown
   myMenu = make_unique<Menu>(*this);
   myCommandMenu = make_unique<CommandMenu>(*this);
   myLauncher = make_unique<Launcher>(*this);
   myStateManager = make_unique<StateManager>(*this);
 
+  // Create the A/V capture object (used by the sound object)
+  myCapture = make_unique<TIACapture>();
+
   // Create the sound object; the sound subsystem isn't actually
   // opened until needed, so this is non-blocking (on those systems
   // that only have a single sound device (no hardware mixing)
@@ -156,6 +171,9 @@ bool OSystem::create()
 
   // Create PNG handler
   myPNGLib = make_unique<PNGLibrary>(*myFrameBuffer);
+  myPNGLib->setCompression(mySettings->getInt("sszlevel"),
+                           mySettings->getString("ssfilter"));
+  startupPhase("Create subsystems");
 
   return true;
 }
@@ -178,6 +196,9 @@ void OSystem::saveConfig()
 
   if(myPropSet)
     myPropSet->save(myPropertiesFile);
+
+  if(myDetectionCache)
+    myDetectionCache->save();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -362,6 +383,7 @@ string OSystem::createConsole(const FilesystemNode& rom, const string& md5sum,
     // Also check if certain virtual buttons should be held down
     // These must be checked each time a new console is being created
     myEventHandler->handleConsoleStartupEvents();
+    startupPhase("Create console");
   }
   return EmptyString;
 }
@@ -399,6 +421,7 @@ bool OSystem::createLauncher(const string& startdir)
     setFramerate(30);
     resetLoopTiming();
     status = true;
+    startupPhase("Open launcher");
   }
   else
     logMessage("ERROR: Couldn't create launcher", 0);
@@ -434,14 +457,44 @@ void OSystem::logMessage(const string& message, uInt8 level)
     cout << message << endl << std::flush;
     myLogMessages += message + "\n";
   }
-  else if(level <= uInt8(mySettings->getInt("loglevel")))
+  else if(level <= uInt8(myLogLevel()))
   {
-    if(mySettings->getBool("logtoconsole"))
+    if(myLogToConsole())
       cout << message << endl << std::flush;
     myLogMessages += message + "\n";
   }
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void OSystem::startupPhase(const string& name)
+{
+  if(!myStartupDone)
+    myStartupPhases.emplace_back(name, getTicks());
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void OSystem::finishStartup()
+{
+  startupPhase("Show first frame");
+  myStartupDone = true;
+
+  if(mySettings->getBool("startuptrace"))
+  {
+    ostringstream buf;
+    buf << "Startup trace (milliseconds):" << endl << std::fixed;
+    uInt64 last = myStartupTime;
+    for(const auto& phase: myStartupPhases)
+    {
+      buf << "  " << std::left << std::setw(28) << phase.first << std::right
+          << std::setprecision(2) << std::setw(9) << (phase.second - last) / 1000.0
+          << std::setw(11) << (phase.second - myStartupTime) / 1000.0 << endl;
+      last = phase.second;
+    }
+    logMessage(buf.str(), 0);
+  }
+  myStartupPhases.clear();
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 unique_ptr<Console>
 OSystem::openConsole(const FilesystemNode& romfile, string& md5)
@@ -516,6 +569,9 @@ void OSystem::closeConsole()
 {
   if(myConsole)
   {
+    // Captures only contain a single ROM
+    myCapture->stop();
+
   #ifdef CHEATCODE_SUPPORT
     // If a previous console existed, save cheats before creating a new one
     myCheatManager->saveCheats(myConsole->properties().get(Cartridge_MD5));
@@ -545,8 +601,12 @@ BytePtr OSystem::openROM(const FilesystemNode& rom, string& md5, uInt32& size)
   // Some games may not have a name, since there may not
   // be an entry in stella.pro.  In that case, we use the rom name
   // and reinsert the properties object
-  Properties props;
-  myPropSet->getMD5WithInsert(rom, md5, props);
+  PropertiesView view;
+  if(!myPropSet->getMD5(md5, view))
+  {
+    Properties props;
+    myPropSet->getMD5WithInsert(rom, md5, props);
+  }
 
   return image;
 }
@@ -620,6 +680,7 @@ void OSystem::mainLoop()
       myEventHandler->poll(myTimingInfo.start);
       if(myQuitLoop) break;  // Exit if the user wants to quit
       myFrameBuffer->update();
+      if(!myStartupDone) finishStartup();
       myTimingInfo.current = getTicks();
       myTimingInfo.virt += myTimePerFrame;
 
@@ -648,6 +709,7 @@ void OSystem::mainLoop()
       myEventHandler->poll(myTimingInfo.start);
       if(myQuitLoop) break;  // Exit if the user wants to quit
       myFrameBuffer->update();
+      if(!myStartupDone) finishStartup();
       myTimingInfo.virt += myTimePerFrame;
 
       while(getTicks() < myTimingInfo.virt)
@@ -24,6 +24,7 @@ class CheatManager;
 class CommandMenu;
 class Console;
 class Debugger;
+class DetectionCache;
 class Launcher;
 class Menu;
 class Properties;
@@ -33,12 +34,14 @@ class SerialPort;
 class Settings;
 class Sound;
 class StateManager;
+class TIACapture;
 class VideoDialog;
 
 #include "Cart.hxx"
 #include "FSNode.hxx"
 #include "FrameBuffer.hxx"
 #include "PNGLibrary.hxx"
+#include "Settings.hxx"
 #include "bspf.hxx"
 
 struct TimingInfo {
@@ -113,6 +116,13 @@ class OSystem
     */
     PropertiesSet& propSet() const { return *myPropSet; }
 
+    /**
+      Get the cache of autodetection results for the system.
+
+      @return The detection cache object
+    */
+    DetectionCache& detectionCache() const { return *myDetectionCache; }
+
     /**
       Get the console of the system.  The console won't always exist,
       so we should test if it's available.
@@ -164,6 +174,13 @@ class OSystem
     */
     PNGLibrary& png() const { return *myPNGLib; }
 
+    /**
+      Get the A/V capture handler of the system.
+
+      @return The TIACapture object
+    */
+    TIACapture& capture() const { return *myCapture; }
+
     /**
       This method should be called to load the current settings from an rc file.
       It first loads the settings from the config file, then informs subsystems
@@ -359,6 +376,15 @@ class OSystem
     */
     void logMessage(const string& message, uInt8 level);
 
+    /**
+      Record that a phase of startup has finished.  With the 'startuptrace'
+      option, the time taken by each phase is printed once the first frame
+      has been shown; after that, this does nothing.
+
+      @param name  A short description of the phase
+    */
+    void startupPhase(const string& name);
+
     /**
       Get the system messages logged up to this point.
 
@@ -431,18 +457,29 @@ class OSystem
     // Pointer to the FrameBuffer object
     unique_ptr<FrameBuffer> myFrameBuffer;
 
+    // Object responsible for capturing TIA output and sound; since the
+    // sound thread uses it, it must be destroyed after the Sound object
+    unique_ptr<TIACapture> myCapture;
+
     // Pointer to the Sound object
     unique_ptr<Sound> mySound;
 
     // Pointer to the Settings object
     unique_ptr<Settings> mySettings;
 
+    // Settings checked for every log message
+    SettingHandle<int> myLogLevel;
+    SettingHandle<bool> myLogToConsole;
+
     // Pointer to the Random object
     unique_ptr<Random> myRandom;
 
     // Pointer to the PropertiesSet object
     unique_ptr<PropertiesSet> myPropSet;
 
+    // Pointer to the cache of autodetection results
+    unique_ptr<DetectionCache> myDetectionCache;
+
     // Pointer to the (currently defined) Console object
     unique_ptr<Console> myConsole;
 
@@ -490,6 +527,18 @@ class OSystem
     // Indicates whether to stop the main loop
     bool myQuitLoop;
 
+    // Time at which the OSystem was created, and the end of each phase of
+    // startup since then (cleared once the first frame is shown)
+    uInt64 myStartupTime;
+    vector<std::pair<string, uInt64>> myStartupPhases;
+    bool myStartupDone;
+
+  private:
+    /**
+      Finish recording the startup phases, printing them if requested.
+    */
+    void finishStartup();
+
   private:
     string myBaseDir;
     string myStateDir;
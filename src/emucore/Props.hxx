@@ -58,6 +58,7 @@ enum PropertyType {
 class Properties
 {
   friend class PropertiesSet;
+  friend class PropertiesView;
 
   public:
     /**
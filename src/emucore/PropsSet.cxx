@@ -92,34 +92,90 @@ bool PropertiesSet::getMD5(const string& md5, Properties& properties,
     }
   }
 
-  // Otherwise, search the internal database using binary search
+  // Otherwise, search the internal database
   if(!found)
   {
-    int low = 0, high = DEF_PROPS_SIZE - 1;
-    while(low <= high)
+    const uInt16* builtin = findBuiltin(md5);
+    if(builtin)
     {
-      int i = (low + high) / 2;
-      int cmp = BSPF::compareIgnoreCase(md5, DefProps[i][Cartridge_MD5]);
+      for(int p = 0; p < LastPropType; ++p)
+        if(builtin[p] != 0)
+          properties.set(PropertyType(p), DefPropsStrings[builtin[p]]);
 
-      if(cmp == 0)  // found it
-      {
-        for(int p = 0; p < LastPropType; ++p)
-          if(DefProps[i][p][0] != 0)
-            properties.set(PropertyType(p), DefProps[i][p]);
-
-        found = true;
-        break;
-      }
-      else if(cmp < 0)
-        high = i - 1; // look at lower range
-      else
-        low = i + 1;  // look at upper range
+      found = true;
     }
   }
 
   return found;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool PropertiesSet::getMD5(const string& md5, PropertiesView& view,
+                           bool useDefaults) const
+{
+  view.myProperties = nullptr;
+  view.myBuiltin = nullptr;
+
+  // The lists are searched in the same order as above
+  if(!useDefaults)
+  {
+    auto ext = myExternalProps.find(md5);
+    if(ext != myExternalProps.end())
+    {
+      view.myProperties = &ext->second;
+      return true;
+    }
+    auto tmp = myTempProps.find(md5);
+    if(tmp != myTempProps.end())
+    {
+      view.myProperties = &tmp->second;
+      return true;
+    }
+  }
+
+  view.myBuiltin = findBuiltin(md5);
+  return view.myBuiltin != nullptr;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const uInt16* PropertiesSet::findBuiltin(const string& md5)
+{
+  // Convert the md5 to a digest, ignoring case as before
+  if(md5.length() != 32)
+    return nullptr;
+
+  uInt8 digest[16];
+  for(uInt32 i = 0; i < 32; ++i)
+  {
+    char c = md5[i];
+    int value = c >= '0' && c <= '9' ? c - '0' :
+                c >= 'a' && c <= 'f' ? c - 'a' + 10 :
+                c >= 'A' && c <= 'F' ? c - 'A' + 10 : -1;
+    if(value < 0)
+      return nullptr;
+
+    if(i & 1)  digest[i/2] |= value;
+    else       digest[i/2] = value << 4;
+  }
+
+  // See DefProps.hxx for how the slot is calculated
+  auto word = [&digest](int pos) {
+    return uInt32(digest[pos]) | (uInt32(digest[pos+1]) << 8) |
+           (uInt32(digest[pos+2]) << 16) | (uInt32(digest[pos+3]) << 24);
+  };
+  uInt32 displacement = DefPropsHash[word(0) % DEF_PROPS_BUCKETS];
+  uInt32 step = word(8) % (DEF_PROPS_TABLE_SIZE - 1) + 1;
+  uInt32 slot = (word(4) % DEF_PROPS_TABLE_SIZE + displacement * step) %
+                DEF_PROPS_TABLE_SIZE;
+
+  // Unused slots have no md5 string
+  const DefPropsEntry& entry = DefProps[slot];
+  if(entry.value[Cartridge_MD5] != 0 && memcmp(entry.md5, digest, 16) == 0)
+    return entry.value;
+  else
+    return nullptr;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void PropertiesSet::getMD5WithInsert(const FilesystemNode& rom,
                                      const string& md5, Properties& properties)
@@ -198,14 +254,18 @@ void PropertiesSet::print() const
   // This is fine, since a duplicate in the built-in list means it should
   // be overrided anyway (and insertion shouldn't be done)
   Properties properties;
-  for(int i = 0; i < DEF_PROPS_SIZE; ++i)
+  for(int i = 0; i < DEF_PROPS_TABLE_SIZE; ++i)
   {
+    const uInt16* builtin = DefProps[i].value;
+    if(builtin[Cartridge_MD5] == 0)  // unused slot
+      continue;
+
     properties.setDefaults();
     for(int p = 0; p < LastPropType; ++p)
-      if(DefProps[i][p][0] != 0)
-        properties.set(PropertyType(p), DefProps[i][p]);
+      if(builtin[p] != 0)
+        properties.set(PropertyType(p), DefPropsStrings[builtin[p]]);
 
-    list.emplace(DefProps[i][Cartridge_MD5], properties);
+    list.emplace(DefPropsStrings[builtin[Cartridge_MD5]], properties);
   }
 
   // Now, print the resulting list
@@ -213,3 +273,16 @@ void PropertiesSet::print() const
   for(const auto& i: list)
     i.second.print();
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const char* PropertiesView::get(PropertyType key) const
+{
+  if(key == LastPropType)
+    return "";
+  else if(myProperties)
+    return myProperties->get(key).c_str();
+  else if(myBuiltin && myBuiltin[key] != 0)
+    return DefPropsStrings[myBuiltin[key]];
+  else
+    return Properties::ourDefaultProperties[key].c_str();
+}
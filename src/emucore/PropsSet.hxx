@@ -26,9 +26,40 @@
 
 class OSystem;
 
+/**
+  A read-only view of the properties of one ROM in a PropertiesSet.  It
+  refers to the values stored in the set instead of copying them, so
+  creating one never allocates memory.  The view is only valid until the
+  set is changed.
+*/
+class PropertiesView
+{
+  friend class PropertiesSet;
+
+  public:
+    PropertiesView() : myProperties(nullptr), myBuiltin(nullptr) { }
+
+    /**
+      Get the value assigned to the specified key, or its default value
+      if the properties don't contain it.
+
+      @param key  The key of the property to lookup
+      @return     The value of the property
+    */
+    const char* get(PropertyType key) const;
+
+  private:
+    // Properties inserted into the set, or the string indices of the
+    // built-in properties (at most one of them is used)
+    const Properties* myProperties;
+    const uInt16* myBuiltin;
+};
+
 /**
   This class maintains an ordered collection of properties, maintained
-  in a C++ map and accessible by ROM md5.  The md5 is used since this is
+  in a C++ map and accessible by ROM md5.  The built-in properties are
+  stored in a perfect hash table (generated from stella.pro), which is
+  searched in constant time without any text comparisons.  The md5 is used since this is
   the attribute which must be present in each entry in stella.pro
   and least likely to change.  A change in MD5 would mean a change in
   the game rom image (essentially a different game) and this would
@@ -77,6 +108,21 @@ class PropertiesSet
     bool getMD5(const string& md5, Properties& properties,
                 bool useDefaults = false) const;
 
+    /**
+      Get a view of the property from the set with the given MD5; this is
+      the same as the method above, but doesn't copy the properties.
+
+      @param md5         The md5 of the property to get
+      @param view        The view of the properties with the given MD5, or
+                         of the default properties if not found
+      @param defaults    Use the built-in defaults, ignoring any properties
+                         from an external file
+
+      @return  True if the set with the specified md5 was found, else false
+    */
+    bool getMD5(const string& md5, PropertiesView& view,
+                bool useDefaults = false) const;
+
     /**
       Get the property from the set with the given MD5, at the same time
       checking if it exists.  If it doesn't, insert a temporary copy into
@@ -114,6 +160,14 @@ class PropertiesSet
     */
     void print() const;
 
+  private:
+    /**
+      Search the built-in properties for the given MD5.
+
+      @return  The string indices of the properties, or nullptr if not found
+    */
+    static const uInt16* findBuiltin(const string& md5);
+
   private:
     using PropsList = std::map<string, Properties>;
 
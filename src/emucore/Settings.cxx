@@ -33,7 +33,8 @@
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Settings::Settings(OSystem& osystem)
-  : myOSystem(osystem)
+  : myOSystem(osystem),
+    myGeneration(0)
 {
   // Video-related options
   setInternal("video", "");
@@ -101,6 +102,8 @@ Settings::Settings(OSystem& osystem)
   setInternal("sssingle", "false");
   setInternal("ss1x", "false");
   setInternal("ssinterval", "2");
+  setInternal("sszlevel", "6");
+  setInternal("ssfilter", "all");
 
   // Config files and paths
   setInternal("romdir", "");
@@ -224,7 +227,8 @@ string Settings::loadCommandLine(int argc, char** argv)
       // Take care of arguments without an option or ones that shouldn't
       // be saved to the config file
       if(key == "rominfo" || key == "debug" || key == "holdreset" ||
-         key == "holdselect" || key == "takesnapshot")
+         key == "holdselect" || key == "takesnapshot" ||
+         key == "startuptrace")
       {
         setExternal(key, "true");
         continue;
@@ -326,6 +330,14 @@ void Settings::validate()
   if(i < 1)        setInternal("ssinterval", "2");
   else if(i > 10)  setInternal("ssinterval", "10");
 
+  i = getInt("sszlevel");
+  if(i < 0 || i > 9)  setInternal("sszlevel", "6");
+
+  s = getString("ssfilter");
+  if(s != "none" && s != "sub" && s != "up" && s != "avg" && s != "paeth" &&
+     s != "all")
+    setInternal("ssfilter", "all");
+
   s = getString("palette");
   if(s != "standard" && s != "z26" && s != "user")
     setInternal("palette", "standard");
@@ -432,9 +444,13 @@ void Settings::usage() const
     << "  -sssingle     <1|0>          Generate single snapshot instead of many\n"
     << "  -ss1x         <1|0>          Generate TIA snapshot in 1x mode (ignore scaling/effects)\n"
     << "  -ssinterval   <number        Number of seconds between snapshots in continuous snapshot mode\n"
+    << "  -sszlevel     <0-9>          Compression level for snapshots (lower is faster)\n"
+    << "  -ssfilter     <none|sub|up|  PNG row filter for snapshots (all lets libpng choose)\n"
+    << "                 avg|paeth|all>\n"
     << endl
     << "  -rominfo      <rom>          Display detailed information for the given ROM\n"
     << "  -listrominfo                 Display contents of stella.pro, one line per ROM entry\n"
+    << "  -startuptrace                Show the time taken by each phase of startup\n"
     << "  -exitlauncher <1|0>          On exiting a ROM, go back to the ROM launcher\n"
     << "  -launcherres  <WxH>          The resolution to use in ROM launcher mode\n"
     << "  -launcherfont <small|medium| Use the specified font in the ROM launcher\n"
@@ -516,7 +532,8 @@ const Variant& Settings::value(const string& key) const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Settings::setValue(const string& key, const Variant& value)
 {
-  if(int idx = getInternalPos(key) != -1)
+  int idx = -1;
+  if((idx = getInternalPos(key)) != -1)
     setInternal(key, value, idx);
   else
     setExternal(key, value);
@@ -570,21 +587,15 @@ void Settings::saveConfig()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 int Settings::getInternalPos(const string& key) const
 {
-  for(uInt32 i = 0; i < myInternalSettings.size(); ++i)
-    if(myInternalSettings[i].key == key)
-      return i;
-
-  return -1;
+  const auto& iter = myInternalIndex.find(key);
+  return iter != myInternalIndex.end() ? int(iter->second) : -1;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 int Settings::getExternalPos(const string& key) const
 {
-  for(uInt32 i = 0; i < myExternalSettings.size(); ++i)
-    if(myExternalSettings[i].key == key)
-      return i;
-
-  return -1;
+  const auto& iter = myExternalIndex.find(key);
+  return iter != myExternalIndex.end() ? int(iter->second) : -1;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -599,20 +610,12 @@ int Settings::setInternal(const string& key, const Variant& value,
     idx = pos;
   }
   else
-  {
-    for(uInt32 i = 0; i < myInternalSettings.size(); ++i)
-    {
-      if(myInternalSettings[i].key == key)
-      {
-        idx = i;
-        break;
-      }
-    }
-  }
+    idx = getInternalPos(key);
 
   if(idx != -1)
   {
-    myInternalSettings[idx].key   = key;
+    if(myInternalSettings[idx].value != value)
+      ++myGeneration;
     myInternalSettings[idx].value = value;
     if(useAsInitial) myInternalSettings[idx].initialValue = value;
 
@@ -629,6 +632,8 @@ int Settings::setInternal(const string& key, const Variant& value,
 
     myInternalSettings.push_back(setting);
     idx = int(myInternalSettings.size()) - 1;
+    myInternalIndex.emplace(key, uInt32(idx));
+    ++myGeneration;
 
     /*cerr << "insert internal: key = " << key
          << ", value  = " << value
@@ -652,20 +657,12 @@ int Settings::setExternal(const string& key, const Variant& value,
     idx = pos;
   }
   else
-  {
-    for(uInt32 i = 0; i < myExternalSettings.size(); ++i)
-    {
-      if(myExternalSettings[i].key == key)
-      {
-        idx = i;
-        break;
-      }
-    }
-  }
+    idx = getExternalPos(key);
 
   if(idx != -1)
   {
-    myExternalSettings[idx].key   = key;
+    if(myExternalSettings[idx].value != value)
+      ++myGeneration;
     myExternalSettings[idx].value = value;
     if(useAsInitial) myExternalSettings[idx].initialValue = value;
 
@@ -681,6 +678,8 @@ int Settings::setExternal(const string& key, const Variant& value,
 
     myExternalSettings.push_back(setting);
     idx = int(myExternalSettings.size()) - 1;
+    myExternalIndex.emplace(key, uInt32(idx));
+    ++myGeneration;
 
     /*cerr << "insert external: key = " << key
          << ", value = " << value
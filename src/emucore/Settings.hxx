@@ -20,6 +20,8 @@
 
 class OSystem;
 
+#include <unordered_map>
+
 #include "Variant.hxx"
 #include "bspf.hxx"
 
@@ -86,6 +88,13 @@ class Settings
     const string& getString(const string& key) const { return value(key).toString(); }
     const GUI::Size getSize(const string& key) const { return value(key).toSize();   }
 
+    /**
+      Answer a counter which changes whenever the value of any setting
+      changes (or a new setting is added).  This allows cached copies of
+      settings (see SettingHandle) to know when they must be re-read.
+    */
+    uInt32 generation() const { return myGeneration; }
+
   protected:
     /**
       This method will be called to load the current settings from an rc file.
@@ -120,6 +129,7 @@ class Settings
         : key(k), value(v), initialValue(i) { }
     };
     using SettingsArray = vector<Setting>;
+    using SettingsIndex = std::unordered_map<string, uInt32>;
 
     const SettingsArray& getInternalSettings() const
       { return myInternalSettings; }
@@ -145,6 +155,12 @@ class Settings
     // program exit.
     SettingsArray myExternalSettings;
 
+    // Map each key to its position in the arrays above
+    SettingsIndex myInternalIndex, myExternalIndex;
+
+    // Incremented on each change of a value
+    uInt32 myGeneration;
+
   private:
     // Following constructors and assignment operators not supported
     Settings() = delete;
@@ -154,4 +170,58 @@ class Settings
     Settings& operator=(Settings&&) = delete;
 };
 
+/**
+  A typed, cached handle to a single setting.  The value is converted
+  from its Variant once, and only looked up again after some setting has
+  changed, so reading it in frequently called code is no more expensive
+  than reading a plain member variable.
+
+  Handles may be constructed before the Settings object exists, in which
+  case 'bind' must be called before the value is used.
+*/
+template<typename T>
+class SettingHandle
+{
+  public:
+    SettingHandle() : mySettings(nullptr), myValue(), myGeneration(0) { }
+    SettingHandle(const Settings& settings, const string& key)
+      : SettingHandle() { bind(settings, key); }
+
+    /**
+      Attach this handle to the given setting.
+    */
+    void bind(const Settings& settings, const string& key)
+    {
+      mySettings = &settings;
+      myKey = key;
+      myGeneration = settings.generation() - 1;  // force a lookup
+    }
+
+    /**
+      Answer the current value of the setting.
+    */
+    const T& operator()() const
+    {
+      if(myGeneration != mySettings->generation())
+      {
+        convert(mySettings->value(myKey), myValue);
+        myGeneration = mySettings->generation();
+      }
+      return myValue;
+    }
+
+  private:
+    static void convert(const Variant& v, bool& value)   { value = v.toBool();   }
+    static void convert(const Variant& v, int& value)    { value = v.toInt();    }
+    static void convert(const Variant& v, float& value)  { value = v.toFloat();  }
+    static void convert(const Variant& v, string& value) { value = v.toString(); }
+
+  private:
+    const Settings* mySettings;
+    string myKey;
+
+    mutable T myValue;
+    mutable uInt32 myGeneration;
+};
+
 #endif
@@ -0,0 +1,114 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2017 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+
+#include <queue>
+
+#include "SignatureScanner.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+SignatureScanner::SignatureScanner(const Signature* signatures, uInt32 count)
+{
+  // First build a trie of all signatures; a transition of zero means
+  // there's no child yet (the root can never be a child)
+  vector<vector<uInt16>> matches(1);
+  myTransitions.assign(256, 0);
+  for(uInt32 sig = 0; sig < count; ++sig)
+  {
+    mySizes.push_back(signatures[sig].size);
+
+    uInt32 state = 0;
+    for(uInt32 i = 0; i < signatures[sig].size; ++i)
+    {
+      uInt16& next = myTransitions[state * 256 + signatures[sig].bytes[i]];
+      if(next == 0)
+      {
+        next = uInt16(matches.size());
+        matches.emplace_back();
+        myTransitions.resize(myTransitions.size() + 256, 0);
+      }
+      state = next;
+    }
+    if(signatures[sig].size > 0)
+      matches[state].push_back(uInt16(sig));
+  }
+
+  // Then turn the trie into a complete state machine, in breadth-first
+  // order, so that the failure state of each state is already complete;
+  // a mismatch continues from the longest suffix which is also a prefix
+  // of some signature, and every signature ending in that suffix also
+  // matches here
+  vector<uInt16> failure(matches.size(), 0);
+  std::queue<uInt16> states;
+  for(uInt32 c = 0; c < 256; ++c)
+    if(myTransitions[c] != 0)
+      states.push(myTransitions[c]);
+
+  while(!states.empty())
+  {
+    uInt16 state = states.front();
+    states.pop();
+    const vector<uInt16>& inherited = matches[failure[state]];
+    matches[state].insert(matches[state].end(), inherited.begin(), inherited.end());
+
+    for(uInt32 c = 0; c < 256; ++c)
+    {
+      uInt16& next = myTransitions[state * 256 + c];
+      uInt16 fallback = myTransitions[failure[state] * 256 + c];
+      if(next != 0)
+      {
+        failure[next] = fallback;
+        states.push(next);
+      }
+      else
+        next = fallback;
+    }
+  }
+
+  // Finally, store the matches for quick access while scanning
+  for(const auto& m: matches)
+  {
+    myMatchStart.push_back(uInt32(myMatches.size()));
+    myMatches.insert(myMatches.end(), m.begin(), m.end());
+  }
+  myMatchStart.push_back(uInt32(myMatches.size()));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SignatureScanner::scan(const uInt8* image, uInt32 size, uInt32* hits) const
+{
+  // Position where the next match of each signature may start
+  vector<uInt32> nextStart(mySizes.size(), 0);
+  std::fill_n(hits, mySizes.size(), 0);
+
+  // The last byte is never part of a match
+  uInt32 state = 0;
+  for(uInt32 i = 0; i + 1 < size; ++i)
+  {
+    state = myTransitions[state * 256 + image[i]];
+    for(uInt32 m = myMatchStart[state]; m < myMatchStart[state + 1]; ++m)
+    {
+      const uInt16 sig = myMatches[m];
+      const uInt32 start = i + 1 - mySizes[sig];
+      if(start >= nextStart[sig])
+      {
+        ++hits[sig];
+        nextStart[sig] = start + mySizes[sig] + 1;
+      }
+    }
+  }
+}
@@ -0,0 +1,83 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2017 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+
+#ifndef SIGNATURE_SCANNER_HXX
+#define SIGNATURE_SCANNER_HXX
+
+#include "bspf.hxx"
+
+/**
+  This class searches for many byte signatures at once, in a single pass
+  over the data (using the Aho-Corasick algorithm).  All signatures are
+  compiled into one state machine when the scanner is created, and
+  scanning doesn't modify it, so a scanner can be shared by any number of
+  threads.
+
+  Matches are counted exactly as CartDetector::searchForBytes() counts
+  them: after a match, the search for the same signature continues one
+  byte past the end of the match, and a signature ending at the very
+  last byte of the data isn't counted.
+*/
+class SignatureScanner
+{
+  public:
+    struct Signature {
+      uInt8 size;          // number of bytes in the signature
+      uInt8 bytes[7];
+    };
+
+    /**
+      Create a scanner for the given signatures.
+
+      @param signatures  The signatures to search for
+      @param count       The number of signatures
+    */
+    SignatureScanner(const Signature* signatures, uInt32 count);
+
+    /**
+      Count the matches of every signature in the given data.
+
+      @param image  The data to search
+      @param size   The number of bytes of data
+      @param hits   Receives the number of matches of each signature (in
+                    the order the signatures were given)
+    */
+    void scan(const uInt8* image, uInt32 size, uInt32* hits) const;
+
+  private:
+    // State transitions of the automaton, 256 for each state
+    vector<uInt16> myTransitions;
+
+    // The signatures which end at each state; these are stored
+    // consecutively, starting at myMatchStart[state]
+    vector<uInt32> myMatchStart;
+    vector<uInt16> myMatches;
+
+    // The size of each signature
+    vector<uInt8> mySizes;
+
+  private:
+    // Following constructors and assignment operators not supported
+    SignatureScanner() = delete;
+    SignatureScanner(const SignatureScanner&) = delete;
+    SignatureScanner(SignatureScanner&&) = delete;
+    SignatureScanner& operator=(const SignatureScanner&) = delete;
+    SignatureScanner& operator=(SignatureScanner&&) = delete;
+};
+
+#endif
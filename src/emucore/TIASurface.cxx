@@ -36,7 +36,13 @@ TIASurface::TIASurface(OSystem& system)
     myUsePhosphor(false),
     myPhosphorPercent(0.60f),
     myScanlinesEnabled(false),
-    myPalette(nullptr)
+    myPalette(nullptr),
+    myRenderedHash(0),
+    myPendingHash(0),
+    myHashPending(false),
+    myStateGeneration(0),
+    myPhosphorSettleCount(0),
+    myPhosphorSettleFrames(0)
 {
   // Load NTSC filter settings
   myNTSCFilter.loadConfig(myOSystem.settings());
@@ -66,6 +72,7 @@ TIASurface::TIASurface(OSystem& system)
 void TIASurface::initialize(const Console& console, const VideoMode& mode)
 {
   myTIA = &(console.tia());
+  ++myStateGeneration;
 
   myTiaSurface->setDstPos(mode.image.x(), mode.image.y());
   myTiaSurface->setDstSize(mode.image.width(), mode.image.height());
@@ -103,6 +110,7 @@ cerr << "SLine:\n"
 void TIASurface::setPalette(const uInt32* tia_palette, const uInt32* rgb_palette)
 {
   myPalette = tia_palette;
+  ++myStateGeneration;
 
   // The NTSC filtering needs access to the raw RGB data, since it calculates
   // its own internal palette
@@ -208,6 +216,7 @@ uInt32 TIASurface::enableScanlines(int relative, int absolute)
 
   mySLineSurface->applyAttributes();
   mySLineSurface->setDirty();
+  ++myStateGeneration;
 
   return attr.blendalpha;
 }
@@ -219,6 +228,7 @@ void TIASurface::enableScanlineInterpolation(bool enable)
   attr.smoothing = enable;
   mySLineSurface->applyAttributes();
   mySLineSurface->setDirty();
+  ++myStateGeneration;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -232,33 +242,24 @@ void TIASurface::enablePhosphor(bool enable, int blend)
   myTiaSurface->setDirty();
   mySLineSurface->setDirty();
   memset(myRGBFramebuffer, 0, AtariNTSC::outWidth(kTIAW) * kTIAH * 4);
+  ++myStateGeneration;
 
   // Precalculate the average colors for the 'phosphor' effect
   if(myUsePhosphor)
   {
-    for(Int16 c = 255; c >= 0; c--)
-      for(Int16 p = 255; p >= 0; p--)
-        myPhosphorPalette[c][p] = getPhosphor(c, p);
-
-    myNTSCFilter.setPhosphorPalette(myPhosphorPalette);
+    myPhosphorBlend.setPercent(myPhosphorPercent);
+    myNTSCFilter.setPhosphorBlend(myPhosphorBlend);
+
+    // Each blend lowers a decaying channel by at least one, so the longest
+    // decay is that of a fully lit channel going dark
+    myPhosphorSettleCount = 1;
+    for(uInt8 c = 255, d = myPhosphorBlend.getPhosphor(0, c); d != c;
+        c = d, d = myPhosphorBlend.getPhosphor(0, c))
+      ++myPhosphorSettleCount;
   }
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-inline uInt32 TIASurface::getRGBPhosphor(const uInt32 c, const uInt32 p) const
-{
-  #define TO_RGB(color, red, green, blue) \
-    const uInt8 red = color >> 16; const uInt8 green = color >> 8; const uInt8 blue = color;
-
-  TO_RGB(c, rc, gc, bc);
-  TO_RGB(p, rp, gp, bp);
-
-  // Mix current calculated frame with previous displayed frame
-  const uInt8 rn = myPhosphorPalette[rc][rp];
-  const uInt8 gn = myPhosphorPalette[gc][gp];
-  const uInt8 bn = myPhosphorPalette[bc][bp];
-
-  return (rn << 16) | (gn << 8) | bn;
+  else
+    myPhosphorSettleCount = 0;
+  myPhosphorSettleFrames = 0;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -284,6 +285,7 @@ void TIASurface::enableNTSC(bool enable)
   myTiaSurface->setDirty();
   mySLineSurface->setDirty();
   memset(myRGBFramebuffer, 0, AtariNTSC::outWidth(kTIAW) * kTIAH * 4);
+  ++myStateGeneration;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -312,9 +314,68 @@ string TIASurface::effectsInfo() const
   return buf.str();
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt64 TIASurface::fingerprint() const
+{
+  const uInt32 width  = myTIA->width(),
+               height = myTIA->height(),
+               size   = width * height;
+  const uInt8* tiaIn  = myTIA->frameBuffer();
+
+  // Seed with the dimensions and state, then mix in the framebuffer
+  // eight bytes at a time; every step is a bijection of the running hash,
+  // so a single changed word can never produce the same result
+  uInt64 hash = 0xcbf29ce484222325ULL ^
+                (uInt64(myStateGeneration) << 32) ^ (width << 16) ^ height;
+  uInt32 i = 0;
+  for(; i + 8 <= size; i += 8)
+  {
+    uInt64 word;
+    memcpy(&word, tiaIn + i, 8);
+    hash = (hash ^ word) * 0x9e3779b97f4a7c15ULL;
+    hash ^= hash >> 32;
+  }
+  for(; i < size; ++i)
+    hash = (hash ^ tiaIn[i]) * 0x100000001b3ULL;
+
+  return hash;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool TIASurface::changed()
+{
+  myPendingHash = fingerprint();
+  myHashPending = myPendingHash != myRenderedHash || myPhosphorSettleFrames > 0;
+
+  return myHashPending;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIASurface::render()
 {
+  uInt64 hash = myHashPending ? myPendingHash : fingerprint();
+  myHashPending = false;
+
+  if(hash != myRenderedHash)
+    myPhosphorSettleFrames = myPhosphorSettleCount;
+  else if(myPhosphorSettleFrames > 0)
+    --myPhosphorSettleFrames;
+  else
+  {
+    // Nothing changed; draw the previous image again without converting
+    // or uploading it
+    myTiaSurface->setRedrawOnly();
+    myTiaSurface->render();
+
+    if(myScanlinesEnabled)
+    {
+      mySLineSurface->setRedrawOnly();
+      mySLineSurface->render();
+    }
+    return;
+  }
+  myRenderedHash = hash;
+
   uInt32 width  = myTIA->width();
   uInt32 height = myTIA->height();
 
@@ -352,12 +413,12 @@ void TIASurface::render()
         pos = screenofsY;
         for(uInt32 x = width / 2; x ; --x)
         {
-          // Store back into displayed frame buffer (for next frame)
-          rgbIn[bufofs] = out[pos++] = getRGBPhosphor(myPalette[tiaIn[bufofs]], rgbIn[bufofs]);
-          bufofs++;
-          rgbIn[bufofs] = out[pos++] = getRGBPhosphor(myPalette[tiaIn[bufofs]], rgbIn[bufofs]);
-          bufofs++;
+          out[pos++] = myPalette[tiaIn[bufofs++]];
+          out[pos++] = myPalette[tiaIn[bufofs++]];
         }
+        // Blend the whole row with the previous frame, and store back into
+        // displayed frame buffer (for next frame)
+        myPhosphorBlend.blend(out + screenofsY, rgbIn + bufofs - width, width);
         screenofsY += outPitch;
       }
       break;
@@ -30,6 +30,7 @@ class VideoMode;
 #include "FrameManager.hxx"
 #include "Rect.hxx"
 #include "NTSCFilter.hxx"
+#include "PhosphorBlend.hxx"
 #include "bspf.hxx"
 
 /**
@@ -79,9 +80,11 @@ class TIASurface
     uInt32 pixel(uInt32 idx, uInt8 shift = 0);
 
     /**
-      Get the NTSCFilter object associated with the framebuffer
+      Get the NTSCFilter object associated with the framebuffer.
+      Since the caller may modify the filter, the next frame is always
+      considered to have changed.
     */
-    NTSCFilter& ntsc() { return myNTSCFilter; }
+    NTSCFilter& ntsc() { ++myStateGeneration; return myNTSCFilter; }
 
     /**
       Use NTSC filtering effects specified by the given preset.
@@ -115,39 +118,31 @@ class TIASurface
     bool phosphorEnabled() const { return myUsePhosphor; }
 
     /**
-      Used to calculate an averaged color for the 'phosphor' effect.
-
-      @param c1  Color 1
-      @param c2  Color 2
-
-      @return  Averaged value of the two colors
+      Enable/disable/query NTSC filtering effects.
     */
-    inline uInt8 getPhosphor(const uInt8 c1, uInt8 c2) const {
-      // Use maximum of current and decayed previous values
-      c2 = uInt8(c2 * myPhosphorPercent);
-      if(c1 > c2)  return c1; // raise (assumed immediate)
-      else         return c2; // decay
-    }
+    void enableNTSC(bool enable);
+    bool ntscEnabled() const { return uInt8(myFilter) & 0x10; }
+    string effectsInfo() const;
 
     /**
-      Used to calculate an averaged color for the 'phosphor' effect.
-
-      @param c  RGB Color 1 (current frame)
-      @param p  RGB Color 2 (previous frame)
-
-      @return  Averaged value of the two RGB colors
+      Calculate a fingerprint of the current TIA image, including the
+      palette and filtering state.
     */
-    uInt32 getRGBPhosphor(const uInt32 c, const uInt32 cp) const;
+    uInt64 fingerprint() const;
 
     /**
-      Enable/disable/query NTSC filtering effects.
+      Answers whether the TIA image differs from the one most recently
+      rendered.  This takes into account the TIA framebuffer contents, the
+      palette and filtering state, and (in phosphor modes) whether the
+      blended image is still decaying.  When this returns true, the
+      fingerprint computed here is reused by the following call to render().
     */
-    void enableNTSC(bool enable);
-    bool ntscEnabled() const { return uInt8(myFilter) & 0x10; }
-    string effectsInfo() const;
+    bool changed();
 
     /**
       This method should be called to draw the TIA image(s) to the screen.
+      If the image hasn't changed since the last call, the conversion and
+      texture upload are skipped, and the previous image is drawn again.
     */
     void render();
 
@@ -193,8 +188,8 @@ class TIASurface
     // Amount to blend when using phosphor effect
     float myPhosphorPercent;
 
-    // Precalculated averaged phosphor colors
-    uInt8 myPhosphorPalette[256][256];
+    // Blends the current and previous frames
+    PhosphorBlend myPhosphorBlend;
     /////////////////////////////////////////////////////////////
 
     // Use scanlines in TIA rendering mode
@@ -203,6 +198,18 @@ class TIASurface
     // Palette for normal TIA rendering mode
     const uInt32* myPalette;
 
+    // Fingerprints of the most recently rendered TIA image, and of the
+    // image last checked by changed() (if still pending)
+    uInt64 myRenderedHash, myPendingHash;
+    bool myHashPending;
+
+    // Incremented whenever the palette or filtering state changes
+    uInt32 myStateGeneration;
+
+    // Number of renders an unchanged image needs for the phosphor blend
+    // to decay completely, and how many of them are still outstanding
+    uInt32 myPhosphorSettleCount, myPhosphorSettleFrames;
+
   private:
     // Following constructors and assignment operators not supported
     TIASurface() = delete;
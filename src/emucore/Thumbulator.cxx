@@ -72,6 +72,11 @@ Thumbulator::Thumbulator(const uInt16* rom_ptr, uInt16* ram_ptr, bool traponfata
 string Thumbulator::run()
 {
   reset();
+#ifdef DEBUGGER_SUPPORT
+  if(myProfiler.isProfiling())
+    runProfiled();
+  else
+#endif
   for(;;)
   {
     if(execute()) break;
@@ -85,6 +90,58 @@ string Thumbulator::run()
   return statusMsg.str();
 }
 
+#ifdef DEBUGGER_SUPPORT
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Thumbulator::runProfiled()
+{
+  // The PC is kept 2 bytes ahead of the instruction (plus the Thumb bit)
+  myProfiler.addRun((reg_norm[15] & ~1) - 2);
+  for(;;)
+  {
+    const uInt32 pc = reg_norm[15] & ~1;
+    const uInt64 cycles = memCycles();
+
+    // Calls are the second half of BL/BLX(1), and BLX(2); the latter
+    // exits the ARM code when switching to ARM mode
+    const uInt32 inst = peekInstruction(pc - 2);
+    const bool call = ((inst & 0xE000) == 0xE000 && (inst & 0x0800)) ||
+                      (inst & 0xFF87) == 0x4780;
+
+    int done = execute();
+    myProfiler.addInstruction(pc - 2, uInt32(memCycles() - cycles));
+
+    if(call && !done)
+      myProfiler.addCall((reg_norm[15] & ~1) - 2);
+
+    if(done) break;
+    if(instructions > 500000) // way more than would otherwise be possible
+      throw runtime_error("instructions > 500000");
+  }
+  myProfiler.addTraffic(fetches, reads, writes);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+inline uInt64 Thumbulator::memCycles() const
+{
+  return fetches[0x0] + fetches[0x4] + reads[0x0] + reads[0x4] + reads[0xE] +
+         writes[0x4] + writes[0xE];
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 Thumbulator::peekInstruction(uInt32 addr) const
+{
+  switch(addr & 0xF0000000)
+  {
+    case 0x00000000: //ROM
+      return CONV_RAMROM(rom[(addr & ROMADDMASK) >> 1]);
+
+    case 0x40000000: //RAM
+      return CONV_RAMROM(ram[(addr & RAMADDMASK) >> 1]);
+  }
+  return 0;
+}
+#endif
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Thumbulator::setConsoleTiming(ConsoleTiming timing)
 {
@@ -142,12 +199,18 @@ inline int Thumbulator::fatalError(const char* opcode, uInt32 v1, uInt32 v2,
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Thumbulator::dump_counters()
 {
+  uInt64 fetched = 0, read = 0, written = 0;
+  for(int i = 0; i < 16; ++i)
+  {
+    fetched += fetches[i];  read += reads[i];  written += writes[i];
+  }
+
   cout << endl << endl
        << "instructions " << instructions << endl
-       << "fetches      " << fetches << endl
-       << "reads        " << reads << endl
-       << "writes       " << writes << endl
-       << "memcycles    " << (fetches+reads+writes) << endl
+       << "fetches      " << fetched << endl
+       << "reads        " << read << endl
+       << "writes       " << written << endl
+       << "memcycles    " << (fetched+read+written) << endl
        << "systick_ints " << systick_ints << endl;
 }
 
@@ -169,7 +232,7 @@ void Thumbulator::dump_regs()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt32 Thumbulator::fetch16(uInt32 addr)
 {
-  fetches++;
+  fetches[addr >> 28]++;
 
   uInt32 data;
   switch(addr & 0xF0000000)
@@ -252,7 +315,7 @@ void Thumbulator::write16(uInt32 addr, uInt32 data)
   if(addr & 1)
     fatalError("write16", addr, "abort - misaligned");
 
-  writes++;
+  writes[addr >> 28]++;
 
   DO_DBUG(statusMsg << "write16(" << Base::HEX8 << addr << "," << Base::HEX8 << data << ")" << endl);
 
@@ -290,6 +353,7 @@ void Thumbulator::write32(uInt32 addr, uInt32 data)
       throw runtime_error("HALT");
 
     case 0xE0000000: //periph
+      writes[0xE]++;
       switch(addr)
       {
         case 0xE0000000:
@@ -368,7 +432,7 @@ uInt32 Thumbulator::read16(uInt32 addr)
   if(addr & 1)
     fatalError("read16", addr, "abort - misaligned");
 
-  reads++;
+  reads[addr >> 28]++;
 
   switch(addr & 0xF0000000)
   {
@@ -414,6 +478,7 @@ uInt32 Thumbulator::read32(uInt32 addr)
 
     case 0xE0000000:
     {
+      reads[0xE]++;
       switch(addr)
       {
         case 0xE0008004:  // T1TCR - Timer 1 Control Register
@@ -2349,7 +2414,10 @@ int Thumbulator::reset()
   systick_calibrate = 0x00ABCDEF;
 
   // fxq: don't care about below so much (maybe to guess timing???)
-  instructions = fetches = reads = writes = systick_ints = 0;
+  instructions = systick_ints = 0;
+  std::fill(fetches, fetches+16, 0);
+  std::fill(reads, reads+16, 0);
+  std::fill(writes, writes+16, 0);
 
   statusMsg.str("");
 
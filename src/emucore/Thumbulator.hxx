@@ -31,6 +31,10 @@
 #include "Cart.hxx"
 #include "Console.hxx"
 
+#ifdef DEBUGGER_SUPPORT
+  #include "ThumbProfiler.hxx"
+#endif
+
 #define ROMADDMASK 0x7FFF
 #define RAMADDMASK 0x1FFF
 
@@ -89,6 +93,14 @@ class Thumbulator
     */
     void setConsoleTiming(ConsoleTiming timing);
 
+#ifdef DEBUGGER_SUPPORT
+    /**
+      Answer the profiler for the ARM code, which is only used while it
+      is profiling.
+    */
+    ThumbProfiler& profiler() { return myProfiler; }
+#endif
+
   private:
     uInt32 read_register(uInt32 reg);
     void write_register(uInt32 reg, uInt32 data);
@@ -118,6 +130,18 @@ class Thumbulator
     int execute();
     int reset();
 
+#ifdef DEBUGGER_SUPPORT
+    // Execute like run(), but report each instruction to the profiler
+    void runProfiled();
+
+    // Answer the number of memory accesses made so far
+    uInt64 memCycles() const;
+
+    // Answer the instruction at the given address, without counting the
+    // access (as fetch16 does)
+    uInt32 peekInstruction(uInt32 addr) const;
+#endif
+
   private:
     const uInt16* rom;
     uInt16* ram;
@@ -126,7 +150,11 @@ class Thumbulator
     uInt32 cpsr, mamcr;
     bool handler_mode;
     uInt32 systick_ctrl, systick_reload, systick_count, systick_calibrate;
-    uInt64 instructions, fetches, reads, writes, systick_ints;
+    uInt64 instructions, systick_ints;
+
+    // Memory accesses are counted by the top 4 bits of the address
+    // (0 = flash, 4 = RAM, E = peripherals)
+    uInt64 fetches[16], reads[16], writes[16];
 
     // For emulation of LPC2103's timer 1, used for NTSC/PAL/SECAM detection.
     // Register names from documentation:
@@ -143,6 +171,10 @@ class Thumbulator
 
     Cartridge* myCartridge;
 
+#ifdef DEBUGGER_SUPPORT
+    ThumbProfiler myProfiler;
+#endif
+
   private:
     // Following constructors and assignment operators not supported
     Thumbulator() = delete;
@@ -49,6 +49,7 @@ MODULE_OBJS := \
 	src/emucore/CompuMate.o \
 	src/emucore/Console.o \
 	src/emucore/Control.o \
+	src/emucore/DetectionCache.o \
 	src/emucore/Driving.o \
 	src/emucore/EventHandler.o \
 	src/emucore/EventJoyHandler.o \
@@ -72,6 +73,7 @@ MODULE_OBJS := \
 	src/emucore/SaveKey.o \
 	src/emucore/Serializer.o \
 	src/emucore/Settings.o \
+	src/emucore/SignatureScanner.o \
 	src/emucore/Switches.o \
 	src/emucore/System.o \
 	src/emucore/TIASnd.o \
@@ -24,6 +24,7 @@
 
 #ifdef DEBUGGER_SUPPORT
   #include "CartDebug.hxx"
+  #include "TIAWriteLog.hxx"
 #endif
 
 enum CollisionMask: uInt32 {
@@ -74,7 +75,8 @@ TIA::TIA(Console& console, Sound& sound, Settings& settings)
     myPlayer1(~CollisionMask::player1 & 0x7FFF),
     myBall(~CollisionMask::ball & 0x7FFF),
     mySpriteEnabledBits(0xFF),
-    myCollisionsEnabledBits(0xFF)
+    myCollisionsEnabledBits(0xFF),
+    myRenderingEnabled(true)
 {
   myFrameManager.setHandlers(
     [this] () {
@@ -101,6 +103,10 @@ TIA::TIA(Console& console, Sound& sound, Settings& settings)
   myFrameManager.enableJitter(mySettings.getBool("tv.jitter"));
   myFrameManager.setJitterFactor(mySettings.getInt("tv.jitter_recovery"));
 
+#ifdef DEBUGGER_SUPPORT
+  myWriteLog = nullptr;
+#endif // DEBUGGER_SUPPORT
+
   reset();
 }
 
@@ -468,6 +474,11 @@ bool TIA::poke(uInt16 address, uInt8 value)
 
   address &= 0x3F;
 
+#ifdef DEBUGGER_SUPPORT
+  if(myWriteLog)
+    myWriteLog->add(address, value, mySystem->m6502().instructionPC());
+#endif // DEBUGGER_SUPPORT
+
   switch (address)
   {
     case WSYNC:
@@ -1048,6 +1059,15 @@ TIA& TIA::updateScanlineByTrace(int target)
   return *this;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TIA& TIA::updateByStopPoint()
+{
+  if (mySystem->m6502().execute(25000))
+    updateEmulation();
+
+  return *this;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt8 TIA::registerValue(uInt8 reg) const
 {
@@ -1070,6 +1090,16 @@ void TIA::updateEmulation()
   cycle(cyclesToRun);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIA::beamPosition(uInt32& scanline, uInt32& clock) const
+{
+  const uInt32 clocks = clocksThisLine() + mySubClock +
+      3 * uInt32(mySystem->cycles() - myLastCycle);
+
+  scanline = scanlines() + clocks / 228;
+  clock = clocks % 228;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIA::onFrameStart()
 {
@@ -1213,7 +1243,7 @@ void TIA::tickHframe()
   myPlayer1.tick();
   myBall.tick();
 
-  if (myFrameManager.isRendering())
+  if (myRenderingEnabled && myFrameManager.isRendering())
     renderPixel(x, y);
 }
 
@@ -1255,7 +1285,7 @@ void TIA::cloneLastLine()
 {
   const auto y = myFrameManager.getY();
 
-  if (!myFrameManager.isRendering() || y == 0) return;
+  if (!myRenderingEnabled || !myFrameManager.isRendering() || y == 0) return;
 
   uInt8* buffer = myFramebuffer;
 
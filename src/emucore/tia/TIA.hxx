@@ -40,6 +40,10 @@
 #include "Control.hxx"
 #include "System.hxx"
 
+#ifdef DEBUGGER_SUPPORT
+  class TIAWriteLog;
+#endif
+
 /**
   This class is a device that emulates the Television Interface Adaptor
   found in the Atari 2600 and 7800 consoles.  The Television Interface
@@ -208,6 +212,15 @@ class TIA : public Device
     void setLayout(FrameLayout layout) { myFrameManager.setLayout(layout); }
     FrameLayout frameLayout() const { return myFrameManager.layout(); }
 
+    /**
+      Enables/disables drawing into the framebuffer.  This is only turned
+      off while the emulation is run for autodetection, where the output
+      is never shown.
+
+      @param enabled  Whether pixels should be drawn
+    */
+    void enableRendering(bool enabled) { myRenderingEnabled = enabled; }
+
     /**
       Answers the timing of the console currently in use.
     */
@@ -242,6 +255,17 @@ class TIA : public Device
     */
     uInt32 clocksThisLine() const { return myHctr - myHctrDelta; }
 
+    /**
+      Answers the current scanline and color clock, including the clocks
+      the TIA hasn't been updated for yet.  Unlike the methods above, this
+      doesn't depend on the TIA having been accessed recently, and doesn't
+      run the emulation.
+
+      @param scanline  The current scanline is placed here
+      @param clock     The current color clock is placed here
+    */
+    void beamPosition(uInt32& scanline, uInt32& clock) const;
+
     /**
       Answers the total number of scanlines the TIA generated in producing
       the current frame buffer. For partial frames, this will be the
@@ -378,11 +402,26 @@ class TIA : public Device
     */
     TIA& updateScanlineByTrace(int target);
 
+    /**
+      This method should be called to update the TIA by running the CPU
+      at full speed, until it hits one of its stop points (see
+      M6502::setStopPoints()) or the frame is complete.
+    */
+    TIA& updateByStopPoint();
+
     /**
       Retrieve the last value written to a certain register.
     */
     uInt8 registerValue(uInt8 reg) const;
 
+#ifdef DEBUGGER_SUPPORT
+    /**
+      Set the log which every register write is added to, or nullptr to
+      stop logging them.
+    */
+    void setWriteLog(TIAWriteLog* log) { myWriteLog = log; }
+#endif // DEBUGGER_SUPPORT
+
     /**
       Get the current x value.
     */
@@ -723,6 +762,11 @@ class TIA : public Device
      */
     bool myAutoFrameEnabled;
 
+    /**
+     * Whether pixels are drawn into the framebuffer at all.
+     */
+    bool myRenderingEnabled;
+
     /**
      * Indicates if color loss should be enabled or disabled.  Color loss
      * occurs on PAL-like systems when the previous frame contains an odd
@@ -743,6 +787,9 @@ class TIA : public Device
     // The array used to skip the first two TIA access trackings
     BytePtr myAccessDelay;
 
+    // The log to add register writes to (see setWriteLog)
+    TIAWriteLog* myWriteLog;
+
     static constexpr uInt16
       TIA_SIZE = 0x40, TIA_MASK = TIA_SIZE - 1, TIA_READ_MASK = 0x0f, TIA_BIT = 0x080, TIA_DELAY = 2;
 #endif // DEBUGGER_SUPPORT
@@ -23,5 +23,10 @@
 CommandMenu::CommandMenu(OSystem& osystem)
   : DialogContainer(osystem)
 {
-  myBaseDialog = new CommandDialog(myOSystem, *this);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Dialog* CommandMenu::createBaseDialog()
+{
+  return new CommandDialog(myOSystem, *this);
 }
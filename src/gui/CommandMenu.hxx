@@ -37,6 +37,12 @@ class CommandMenu : public DialogContainer
     CommandMenu(OSystem& osystem);
     virtual ~CommandMenu() = default;
 
+  protected:
+    /**
+      Create the dialog shown by this container.
+    */
+    Dialog* createBaseDialog() override;
+
   private:
     // Following constructors and assignment operators not supported
     CommandMenu() = delete;
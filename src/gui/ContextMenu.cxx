@@ -515,7 +515,7 @@ void ContextMenu::scrollDown(int distance)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void ContextMenu::drawDialog()
+void ContextMenu::drawMenu()
 {
   static uInt32 up_arrow[8] = {
     0x00011000,
@@ -581,7 +581,23 @@ void ContextMenu::drawDialog()
     s.setDirty();
     _dirty = false;
   }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ContextMenu::drawDialog()
+{
+  drawMenu();
 
   // Commit surface changes to screen
-  s.render();
+  surface().render();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ContextMenu::drawChanges()
+{
+  if(!isVisible() || !_dirty)
+    return false;
+
+  drawMenu();
+  return true;
 }
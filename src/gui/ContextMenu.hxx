@@ -93,6 +93,10 @@ class ContextMenu : public Dialog, public CommandSender
     void handleEvent(Event::Type e);
 
     void drawDialog() override;
+    bool drawChanges() override;
+
+    // Draw the menu into its surface, if it changed
+    void drawMenu();
 
     void recalc(const GUI::Rect& image);
 
@@ -266,35 +266,7 @@ void Dialog::drawDialog()
   FBSurface& s = surface();
 
   if(_dirty)
-  {
-//    cerr << "Dialog::drawDialog(): w = " << _w << ", h = " << _h << " @ " << &s << endl << endl;
-    s.fillRect(_x, _y, _w, _h, kDlgColor);
-    s.box(_x, _y, _w, _h, kColor, kShadowColor);
-
-    // Make all child widget dirty
-    Widget* w = _firstWidget;
-    Widget::setDirtyInChain(w);
-
-    // Draw all children
-    w = _firstWidget;
-    while(w)
-    {
-      w->draw();
-      w = w->_next;
-    }
-
-    // Draw outlines for focused widgets
-    // Don't change focus, since this will trigger lost and received
-    // focus events
-    if(_focusedWidget)
-      _focusedWidget = Widget::setFocusForChain(this, getFocusList(),
-                          _focusedWidget, 0, false);
-
-    // Tell the surface(s) this area is dirty
-    s.setDirty();
-
-    _dirty = false;
-  }
+    drawAll();
 
   // Commit surface changes to screen; also render any extra surfaces
   // Extra surfaces must be rendered afterwards, so they are drawn on top
@@ -307,6 +279,69 @@ void Dialog::drawDialog()
   }
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool Dialog::drawChanges()
+{
+  if(!isVisible())
+    return false;
+
+  if(_dirty)
+  {
+    drawAll();
+    return true;
+  }
+
+  return Widget::drawDirtyInChain(_firstWidget);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Dialog::render()
+{
+  if(!isVisible())
+    return;
+
+  surface().setDirty();
+  surface().render();
+  mySurfaceStack.applyAll([](shared_ptr<FBSurface>& surface){
+    surface->setDirty();
+    surface->render();
+  });
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Dialog::drawAll()
+{
+  FBSurface& s = surface();
+
+//  cerr << "Dialog::drawAll(): w = " << _w << ", h = " << _h << " @ " << &s << endl << endl;
+  s.fillRect(_x, _y, _w, _h, kDlgColor);
+  s.box(_x, _y, _w, _h, kColor, kShadowColor);
+
+  // Make all child widget dirty
+  Widget* w = _firstWidget;
+  Widget::setDirtyInChain(w);
+
+  // Draw all children
+  w = _firstWidget;
+  while(w)
+  {
+    w->draw();
+    w = w->_next;
+  }
+
+  // Draw outlines for focused widgets
+  // Don't change focus, since this will trigger lost and received
+  // focus events
+  if(_focusedWidget)
+    _focusedWidget = Widget::setFocusForChain(this, getFocusList(),
+                        _focusedWidget, 0, false);
+
+  // Tell the surface(s) this area is dirty
+  s.setDirty();
+
+  _dirty = false;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Dialog::handleText(char text)
 {
@@ -56,6 +56,20 @@ class Dialog : public GuiObject
 
     virtual void center();
     virtual void drawDialog();
+
+    /**
+      Draw only the widgets which changed since the dialog was last drawn
+      (or everything, when the dialog itself is dirty), without rendering
+      the result.  Answers whether anything was drawn.
+    */
+    virtual bool drawChanges();
+
+    /**
+      Render the dialog and its extra surfaces, whether or not they were
+      changed.
+    */
+    void render();
+
     virtual void loadConfig()  { }
     virtual void saveConfig()  { }
     virtual void setDefaults() { }
@@ -97,6 +111,13 @@ class Dialog : public GuiObject
     virtual bool handleJoyHat(int stick, int hat, int value);
     virtual void handleCommand(CommandSender* sender, int cmd, int data, int id) override;
 
+    /**
+      Called once per frame while the dialog is open, for dialogs which
+      must do some work regularly (ie, collect results from a background
+      thread).
+    */
+    virtual void handleTick() { }
+
     Widget* findWidget(int x, int y) const; // Find the widget at pos x,y if any
 
     void addOKCancelBGroup(WidgetArray& wid, const GUI::Font& font,
@@ -111,6 +132,9 @@ class Dialog : public GuiObject
     bool getResizableBounds(uInt32& w, uInt32& h) const;
 
   private:
+    // Draw the dialog and all of its widgets
+    void drawAll();
+
     void buildCurrentFocusList(int tabID = -1);
     bool handleNavEvent(Event::Type e);
     void getTabIdForWidget(Widget* w);
@@ -33,7 +33,8 @@ DialogContainer::DialogContainer(OSystem& osystem)
     myClickRepeatTime(0),
     myButtonRepeatTime(0),
     myAxisRepeatTime(0),
-    myHatRepeatTime(0)
+    myHatRepeatTime(0),
+    myStackChanged(true)
 {
   reset();
 }
@@ -44,6 +45,15 @@ DialogContainer::~DialogContainer()
   delete myBaseDialog;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Dialog* DialogContainer::baseDialog() const
+{
+  if(myBaseDialog == nullptr)
+    myBaseDialog = const_cast<DialogContainer*>(this)->createBaseDialog();
+
+  return myBaseDialog;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void DialogContainer::updateTime(uInt64 time)
 {
@@ -53,6 +63,11 @@ void DialogContainer::updateTime(uInt64 time)
   if(myDialogStack.empty())
     return;
 
+  // Let the dialogs do any work they need to do regularly
+  myDialogStack.applyAll([](Dialog*& d){
+    d->handleTick();
+  });
+
   // Check for pending continuous events and send them to the active dialog box
   Dialog* activeDialog = myDialogStack.top();
 
@@ -112,6 +127,33 @@ void DialogContainer::draw(bool full)
     myDialogStack.top()->drawDialog();
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool DialogContainer::drawChanges()
+{
+  // Dialogs which were opened or closed may cover or expose any part of
+  // the others
+  bool changed = myStackChanged;
+  myStackChanged = false;
+  myDialogStack.applyAll([changed](Dialog*& d){
+    if(changed)
+      d->setDirty();
+  });
+
+  myDialogStack.applyAll([&changed](Dialog*& d){
+    if(d->drawChanges())
+      changed = true;
+  });
+  return changed;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void DialogContainer::render()
+{
+  myDialogStack.applyAll([](Dialog*& d){
+    d->render();
+  });
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void DialogContainer::addDialog(Dialog* d)
 {
@@ -120,14 +162,20 @@ void DialogContainer::addDialog(Dialog* d)
     myOSystem.frameBuffer().showMessage(
         "Unable to show dialog box; resize current window");
   else
+  {
     myDialogStack.push(d);
+    myStackChanged = true;
+  }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void DialogContainer::removeDialog()
 {
   if(!myDialogStack.empty())
+  {
     myDialogStack.pop();
+    myStackChanged = true;
+  }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -137,7 +185,7 @@ void DialogContainer::reStack()
   while(!myDialogStack.empty())
     myDialogStack.top()->close(false);  // don't force a refresh
 
-  myBaseDialog->open(false);  // don't force a refresh
+  baseDialog()->open(false);  // don't force a refresh
 
   // Reset all continuous events
   reset();
@@ -123,15 +123,28 @@ class DialogContainer
     */
     void draw(bool full = false);
 
+    /**
+      Draw only what changed in the stack of menus since it was last drawn,
+      and answer whether anything did.  Nothing is rendered; use render()
+      for that, once the screen has been cleared.
+    */
+    bool drawChanges();
+
+    /**
+      Render the stack of menus, as last drawn.
+    */
+    void render();
+
     /**
       Reset dialog stack to the main configuration menu.
     */
     void reStack();
 
     /**
-      Return the bottom-most dialog of this container.
+      Return the bottom-most dialog of this container, creating it the
+      first time it's needed.
     */
-    const Dialog* baseDialog() const { return myBaseDialog; }
+    Dialog* baseDialog() const;
 
   private:
     void reset();
@@ -146,9 +159,17 @@ class DialogContainer
     */
     void removeDialog();
 
+  protected:
+    /**
+      Create the bottom-most dialog of this container.  Many dialogs are
+      large and never used in a session, so this is only called when the
+      dialog is actually needed.
+    */
+    virtual Dialog* createBaseDialog() = 0;
+
   protected:
     OSystem& myOSystem;
-    Dialog*  myBaseDialog;
+    mutable Dialog* myBaseDialog;
     Common::FixedStack<Dialog*> myDialogStack;
 
   private:
@@ -206,6 +227,10 @@ class DialogContainer
       uInt64 time; // Time
     } myLastClick;
 
+    // Indicates that dialogs were added or removed since the stack was
+    // last drawn by drawChanges(), so everything must be drawn again
+    bool myStackChanged;
+
   private:
     // Following constructors and assignment operators not supported
     DialogContainer() = delete;
@@ -0,0 +1,90 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2017 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+
+#include "DirectoryLister.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+DirectoryLister::DirectoryLister()
+  : myIsFinished(false),
+    myIsCancelled(false),
+    myIsActive(false)
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+DirectoryLister::~DirectoryLister()
+{
+  cancel();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void DirectoryLister::start(const FilesystemNode& dir,
+                            FilesystemNode::ListMode mode)
+{
+  cancel();
+
+  myEntries.clear();
+  myIsFinished = false;
+  myIsCancelled = false;
+  myIsActive = true;
+
+  myThread = std::thread([this, dir, mode] {
+    dir.listChildren([this](const FilesystemNode& node) {
+      std::lock_guard<std::mutex> lock(myMutex);
+      myEntries.emplace_back(node);
+      return !myIsCancelled;
+    }, mode);
+
+    std::lock_guard<std::mutex> lock(myMutex);
+    myIsFinished = true;
+  });
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void DirectoryLister::cancel()
+{
+  if(myThread.joinable())
+  {
+    myIsCancelled = true;
+    myThread.join();
+  }
+  myEntries.clear();
+  myIsActive = false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool DirectoryLister::fetch(FSList& list)
+{
+  if(!myIsActive)
+    return true;
+
+  bool finished;
+  {
+    std::lock_guard<std::mutex> lock(myMutex);
+    std::move(myEntries.begin(), myEntries.end(), std::back_inserter(list));
+    myEntries.clear();
+    finished = myIsFinished;
+  }
+
+  if(finished)
+  {
+    myThread.join();
+    myIsActive = false;
+  }
+  return finished;
+}
@@ -0,0 +1,91 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2017 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+
+#ifndef DIRECTORY_LISTER_HXX
+#define DIRECTORY_LISTER_HXX
+
+#include <thread>
+#include <mutex>
+#include <atomic>
+
+#include "FSNode.hxx"
+#include "bspf.hxx"
+
+/**
+  This class lists the contents of a directory in a background thread,
+  so that large (or slow, networked) directories don't block the UI.
+  The entries found so far are collected in batches with fetch(), which
+  is normally called once per frame.
+*/
+class DirectoryLister
+{
+  public:
+    DirectoryLister();
+    ~DirectoryLister();
+
+    /**
+      Start listing the given directory, cancelling any listing which is
+      still in progress.
+
+      @param dir   The directory to list
+      @param mode  Which kind of entries to list
+    */
+    void start(const FilesystemNode& dir, FilesystemNode::ListMode mode);
+
+    /**
+      Stop the current listing (if any); entries not yet fetched are lost.
+    */
+    void cancel();
+
+    /**
+      Move the entries found since the last call to the end of the given
+      list.
+
+      @param list  The list to append the entries to
+
+      @return  True if the listing has finished, and all its entries have
+               now been fetched
+    */
+    bool fetch(FSList& list);
+
+    /**
+      Answer whether a listing has been started, and not all of its entries
+      have been fetched yet.
+    */
+    bool isActive() const { return myIsActive; }
+
+  private:
+    std::thread myThread;
+
+    // The lock protects the entries found, and the finished flag
+    std::mutex myMutex;
+    FSList myEntries;
+    bool myIsFinished;
+
+    std::atomic<bool> myIsCancelled;
+    bool myIsActive;
+
+  private:
+    // Following constructors and assignment operators not supported
+    DirectoryLister(const DirectoryLister&) = delete;
+    DirectoryLister(DirectoryLister&&) = delete;
+    DirectoryLister& operator=(const DirectoryLister&) = delete;
+    DirectoryLister& operator=(DirectoryLister&&) = delete;
+};
+
+#endif
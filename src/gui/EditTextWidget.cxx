@@ -37,6 +37,10 @@ EditTextWidget::EditTextWidget(GuiObject* boss, const GUI::Font& font,
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void EditTextWidget::setText(const string& str, bool changed)
 {
+  // Avoid redrawing (and resetting the caret) when nothing changed
+  if(str == _backupString && str == getText() && changed == _changed)
+    return;
+
   EditableWidget::setText(str, changed);
   _backupString = str;
   _changed = changed;
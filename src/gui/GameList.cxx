@@ -29,26 +29,40 @@ void GameList::sortByName()
   if(myArray.size() < 2)
     return;
 
-  auto cmp = [](const Entry& a, const Entry& b)
+  sort(myArray.begin(), myArray.end(), compareNames);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void GameList::sortNewEntries(uInt32 first)
+{
+  if(first >= myArray.size())
+    return;
+
+  // Only the new entries are sorted; they're then merged with the
+  // (already sorted) previous ones in linear time
+  sort(myArray.begin() + first, myArray.end(), compareNames);
+  inplace_merge(myArray.begin(), myArray.begin() + first, myArray.end(),
+                compareNames);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool GameList::compareNames(const Entry& a, const Entry& b)
+{
+  auto it1 = a._name.cbegin(), it2 = b._name.cbegin();
+
+  // Account for ending ']' character in directory entries
+  auto end1 = a._isdir ? a._name.cend() - 1 : a._name.cend();
+  auto end2 = b._isdir ? b._name.cend() - 1 : b._name.cend();
+
+  // Stop when either string's end has been reached
+  while((it1 != end1) && (it2 != end2))
   {
-    auto it1 = a._name.cbegin(), it2 = b._name.cbegin();
-
-    // Account for ending ']' character in directory entries
-    auto end1 = a._isdir ? a._name.cend() - 1 : a._name.cend();
-    auto end2 = b._isdir ? b._name.cend() - 1 : b._name.cend();
-
-    // Stop when either string's end has been reached
-    while((it1 != end1) && (it2 != end2))
-    {
-      if(toupper(*it1) != toupper(*it2)) // letters differ?
-        return toupper(*it1) < toupper(*it2);
-
-      // proceed to the next character in each string
-      ++it1;
-      ++it2;
-    }
-    return a._name.size() < b._name.size();
-  };
-
-  sort(myArray.begin(), myArray.end(), cmp);
+    if(toupper(*it1) != toupper(*it2)) // letters differ?
+      return toupper(*it1) < toupper(*it2);
+
+    // proceed to the next character in each string
+    ++it1;
+    ++it2;
+  }
+  return a._name.size() < b._name.size();
 }
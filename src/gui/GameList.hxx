@@ -52,6 +52,15 @@ class GameList
     }
     void sortByName();
 
+    /**
+      Sort the entries added since the list was last sorted, and merge them
+      into the previous (sorted) ones.  This is used when the list is built
+      incrementally, and is much faster than sorting everything again.
+
+      @param first  The index of the first new entry
+    */
+    void sortNewEntries(uInt32 first);
+
   private:
     struct Entry {
       string _name;
@@ -64,6 +73,9 @@ class GameList
     };
     vector<Entry> myArray;
 
+    // Order entries by name (case-insensitive)
+    static bool compareNames(const Entry& a, const Entry& b);
+
   private:
     // Following constructors and assignment operators not supported
     GameList(const GameList&) = delete;
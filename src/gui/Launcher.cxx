@@ -42,8 +42,12 @@ Launcher::Launcher(OSystem& osystem)
 
   myOSystem.settings().setValue("launcherres",
                                 GUI::Size(myWidth, myHeight));
+}
 
-  myBaseDialog = new LauncherDialog(myOSystem, *this, 0, 0, myWidth, myHeight);
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Dialog* Launcher::createBaseDialog()
+{
+  return new LauncherDialog(myOSystem, *this, 0, 0, myWidth, myHeight);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -56,17 +60,17 @@ FBInitStatus Launcher::initializeVideo()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 const string& Launcher::selectedRomMD5()
 {
-  return (static_cast<LauncherDialog*>(myBaseDialog))->selectedRomMD5();
+  return (static_cast<LauncherDialog*>(baseDialog()))->selectedRomMD5();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 const FilesystemNode& Launcher::currentNode() const
 {
-  return (static_cast<LauncherDialog*>(myBaseDialog))->currentNode();
+  return (static_cast<LauncherDialog*>(baseDialog()))->currentNode();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Launcher::reload()
 {
-  (static_cast<LauncherDialog*>(myBaseDialog))->reload();
+  (static_cast<LauncherDialog*>(baseDialog()))->reload();
 }
@@ -59,6 +59,12 @@ class Launcher : public DialogContainer
     */
     void reload();
 
+  protected:
+    /**
+      Create the dialog shown by this container.
+    */
+    Dialog* createBaseDialog() override;
+
   private:
     // The width and height of this dialog
     uInt32 myWidth;
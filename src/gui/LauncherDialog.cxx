@@ -23,6 +23,7 @@
 #include "ContextMenu.hxx"
 #include "DialogContainer.hxx"
 #include "Dialog.hxx"
+#include "DirectoryLister.hxx"
 #include "EditTextWidget.hxx"
 #include "FSNode.hxx"
 #include "GameList.hxx"
@@ -34,6 +35,7 @@
 #include "OSystem.hxx"
 #include "Props.hxx"
 #include "PropsSet.hxx"
+#include "RomCatalogue.hxx"
 #include "RomInfoWidget.hxx"
 #include "Settings.hxx"
 #include "StringListWidget.hxx"
@@ -53,7 +55,12 @@ LauncherDialog::LauncherDialog(OSystem& osystem, DialogContainer& parent,
     myList(nullptr),
     myPattern(nullptr),
     myRomInfoWidget(nullptr),
-    mySelectedItem(0)
+    myRomInfoItem(0),
+    mySelectedItem(0),
+    mySearchAll(false),
+    mySearchTicks(0),
+    mySelectionPending(false),
+    myListReplaced(false)
 {
   const GUI::Font& font = instance().frameBuffer().launcherFont();
 
@@ -169,6 +176,7 @@ LauncherDialog::LauncherDialog(OSystem& osystem, DialogContainer& parent,
   // Create a game list, which contains all the information about a ROM that
   // the launcher needs
   myGameList = make_unique<GameList>();
+  myLister = make_unique<DirectoryLister>();
 
   addToFocusList(wid);
 
@@ -176,6 +184,7 @@ LauncherDialog::LauncherDialog(OSystem& osystem, DialogContainer& parent,
   VariantList l;
   VarList::push_back(l, "Power-on options", "override");
   VarList::push_back(l, "Filter listing", "filter");
+  VarList::push_back(l, "Search all ROMs", "search");
   VarList::push_back(l, "Reload listing", "reload");
   myMenu = make_unique<ContextMenu>(this, osystem.frameBuffer().font(), l);
 
@@ -256,52 +265,53 @@ void LauncherDialog::loadConfig()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void LauncherDialog::updateListing(const string& nameToSelect)
 {
+  if(mySearchAll)
+  {
+    updateSearchListing();
+    return;
+  }
+
   // Start with empty list
   myGameList->clear();
+  myListReplaced = true;
   myDir->setText("");
 
-  loadDirListing();
-
   // Only hilite the 'up' button if there's a parent directory
   myPrevDirButton->setEnabled(myCurrentNode.hasParent());
 
   // Show current directory
   myDir->setText(myCurrentNode.getShortPath());
 
-  // Now fill the list widget with the contents of the GameList
-  StringList l;
-  for(uInt32 i = 0; i < myGameList->size(); ++i)
-    l.push_back(myGameList->name(i));
-
-  myList->setList(l);
+  // Add '[..]' to indicate previous folder
+  if(myCurrentNode.hasParent())
+    myGameList->appendGame(" [..]", "", "", true);
 
-  // Indicate how many files were found
-  ostringstream buf;
-  buf << (myGameList->size() - 1) << " items found";
-  myRomCount->setLabel(buf.str());
+  // The directory is read in the background, so the UI isn't blocked by
+  // large (or slow) directories; entries are added as they're found
+  if(myCurrentNode.isDirectory())
+    myLister->start(myCurrentNode, FilesystemNode::kListAll);
+  else
+    myLister->cancel();
+  myRomCount->setLabel("Reading directory ...");
 
-  // Restore last selection
-  const string& find =
+  // Restore last selection, once it has been found
+  myPendingSelection =
     nameToSelect == "" ? instance().settings().getString("lastrom") : nameToSelect;
-  myList->setSelected(find);
+  mySelectionPending = true;
+
+  updateDirListing();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void LauncherDialog::loadDirListing()
+void LauncherDialog::updateDirListing()
 {
-  if(!myCurrentNode.isDirectory())
-    return;
-
   FSList files;
-  files.reserve(2048);
-  myCurrentNode.getChildren(files, FilesystemNode::kListAll);
+  bool finished = myLister->fetch(files);
 
-  // Add '[..]' to indicate previous folder
-  if(myCurrentNode.hasParent())
-    myGameList->appendGame(" [..]", "", "", true);
-
-  // Now add the directory entries
+  // Add the directory entries found since the last update
+  const uInt32 first = myGameList->size();
   bool domatch = myPattern && myPattern->getText() != "";
+  bool found = false;
   for(const auto& f: files)
   {
     bool isDir = f.isDirectory();
@@ -323,10 +333,130 @@ void LauncherDialog::loadDirListing()
       continue;
 
     myGameList->appendGame(name, f.getPath(), "", isDir);
+    found = found || name == myPendingSelection;
   }
 
   // Sort the list by rom name (since that's what we see in the listview)
+  // Only the new entries need to be sorted, and merged with the others
+  myGameList->sortNewEntries(first);
+
+  // Now fill the list widget with the contents of the GameList
+  if(myGameList->size() != myList->getList().size() || myListReplaced)
+  {
+    myListReplaced = false;
+    StringList l;
+    l.reserve(myGameList->size());
+    for(uInt32 i = 0; i < myGameList->size(); ++i)
+      l.push_back(myGameList->name(i));
+
+    // The selection may change when the list is updated, which isn't a
+    // choice of the user, so the last selection must still be restored
+    const bool pending = mySelectionPending;
+    myList->updateList(std::move(l));
+    mySelectionPending = pending;
+  }
+
+  if(finished)
+  {
+    // Indicate how many files were found
+    ostringstream buf;
+    buf << (myGameList->size() - 1) << " items found";
+    myRomCount->setLabel(buf.str());
+  }
+
+  // Select the last selection as soon as it appears
+  if(mySelectionPending && (found || finished))
+  {
+    mySelectionPending = false;
+    myList->setSelected(myPendingSelection);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void LauncherDialog::updateSearchListing(bool keepSelection)
+{
+  myLister->cancel();
+  myGameList->clear();
+
+  // 'Go Up' returns to the directory listing
+  myPrevDirButton->setEnabled(true);
+  myDir->setText("Search ROMs in " +
+      FilesystemNode(instance().settings().getString("romdir")).getShortPath());
+
+  vector<const RomCatalogue::Entry*> roms;
+  myCatalogue->search(myPattern ? myPattern->getText() : "", roms);
+  for(const auto* rom: roms)
+    myGameList->appendGame(rom->name, rom->path, "", false);
   myGameList->sortByName();
+
+  StringList l;
+  l.reserve(myGameList->size());
+  for(uInt32 i = 0; i < myGameList->size(); ++i)
+    l.push_back(myGameList->name(i));
+
+  if(keepSelection)
+    myList->updateList(std::move(l));
+  else
+  {
+    myList->setList(l);
+    if(l.size() > 0)
+      myList->setSelected(0);
+    else if(myRomInfoWidget)
+      myRomInfoWidget->clearProperties();
+  }
+
+  if(myCatalogue->isUpdating())
+    myRomCount->setLabel("Indexing ...");
+  else
+  {
+    ostringstream buf;
+    buf << myGameList->size() << " items found";
+    myRomCount->setLabel(buf.str());
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void LauncherDialog::toggleSearch()
+{
+  mySearchAll = !mySearchAll;
+  if(mySearchAll)
+  {
+    if(!myCatalogue)
+      myCatalogue = make_unique<RomCatalogue>(
+          instance().baseDir() + "romcatalogue.cache", instance().propSet());
+
+    // Only ROMs added since the last time have to be read; a scan which
+    // is still running (from before search was switched off) continues
+    const string& romdir = instance().settings().getString("romdir");
+    if(romdir != "" && !myCatalogue->isUpdating())
+    {
+      myCatalogue->update(FilesystemNode(romdir));
+      mySearchTicks = 0;
+    }
+  }
+  updateListing();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void LauncherDialog::handleTick()
+{
+  if(myLister->isActive())
+    updateDirListing();
+
+  // Add the ROMs found to the catalogue every now and then while it's
+  // being updated, since searching and sorting all of them takes a while;
+  // this continues when search is switched off, so that the results are
+  // still saved
+  if(myCatalogue && myCatalogue->isUpdating() && ++mySearchTicks >= 30)
+  {
+    mySearchTicks = 0;
+    myCatalogue->poll();
+    if(mySearchAll)
+      updateSearchListing(true);
+  }
+
+  if(myRomInfoWidget)
+    myRomInfoWidget->updateSnapshot();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -336,22 +466,47 @@ void LauncherDialog::loadRomInfo()
   int item = myList->getSelected();
   if(item < 0) return;
 
-  string extension;
-  const FilesystemNode node(myGameList->path(item));
-  if(!node.isDirectory() && LauncherFilterDialog::isValidRomName(node, extension))
+  Properties props;
+  if(getRomProperties(item, props))
   {
-    // Make sure we have a valid md5 for this ROM
-    if(myGameList->md5(item) == "")
-      myGameList->setMd5(item, MD5::hash(node));
-
-    // Get the properties for this entry
-    Properties props;
-    instance().propSet().getMD5WithInsert(node, myGameList->md5(item), props);
-
     myRomInfoWidget->setProperties(props);
+
+    // The user will most likely continue scrolling in the same direction,
+    // so decode the snapshots of the next few ROMs in the background; the
+    // ROMs aren't read here, since that would stall scrolling
+    const int dir = item >= myRomInfoItem ? 1 : -1;
+    string extension;
+    for(int i = 0, next = item + dir; i < kPrefetchCount &&
+        next >= 0 && next < int(myGameList->size()); ++i, next += dir)
+    {
+      const FilesystemNode node(myGameList->path(next));
+      if(!myGameList->isDir(next) &&
+         LauncherFilterDialog::isValidRomName(node, extension))
+        myRomInfoWidget->prefetch(node, myGameList->md5(next));
+    }
   }
   else
     myRomInfoWidget->clearProperties();
+
+  myRomInfoItem = item;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool LauncherDialog::getRomProperties(int item, Properties& props)
+{
+  string extension;
+  const FilesystemNode node(myGameList->path(item));
+  if(node.isDirectory() || !LauncherFilterDialog::isValidRomName(node, extension))
+    return false;
+
+  // Make sure we have a valid md5 for this ROM
+  if(myGameList->md5(item) == "")
+    myGameList->setMd5(item, MD5::hash(node));
+
+  // Get the properties for this entry
+  instance().propSet().getMD5WithInsert(node, myGameList->md5(item), props);
+
+  return true;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -367,6 +522,10 @@ void LauncherDialog::handleContextMenu()
   {
     myFilters->open();
   }
+  else if(cmd == "search")
+  {
+    toggleSearch();
+  }
   else if(cmd == "reload")
   {
     updateListing();
@@ -498,11 +657,18 @@ void LauncherDialog::handleCommand(CommandSender* sender, int cmd,
 
     case kPrevDirCmd:
     case ListWidget::kPrevDirCmd:
+      if(mySearchAll)
+      {
+        toggleSearch();
+        break;
+      }
       myCurrentNode = myCurrentNode.getParent();
       updateListing(myNodeNames.empty() ? "" : myNodeNames.pop());
       break;
 
     case ListWidget::kSelectionChangedCmd:
+      // Once the user has chosen something, the listing must not change it
+      mySelectionPending = false;
       loadRomInfo();
       break;
 
@@ -24,6 +24,7 @@ class ButtonWidget;
 class CommandSender;
 class ContextMenu;
 class DialogContainer;
+class DirectoryLister;
 class GameList;
 class BrowserDialog;
 class OptionsDialog;
@@ -32,6 +33,7 @@ class LauncherFilterDialog;
 class OSystem;
 class Properties;
 class EditTextWidget;
+class RomCatalogue;
 class RomInfoWidget;
 class StaticTextWidget;
 class StringListWidget;
@@ -80,12 +82,16 @@ class LauncherDialog : public Dialog
     void handleKeyDown(StellaKey key, StellaMod mod) override;
     void handleMouseDown(int x, int y, int button, int clickCount) override;
     void handleCommand(CommandSender* sender, int cmd, int data, int id) override;
+    void handleTick() override;
 
     void loadConfig() override;
     void updateListing(const string& nameToSelect = "");
 
-    void loadDirListing();
+    void updateDirListing();
+    void updateSearchListing(bool keepSelection = false);
+    void toggleSearch();
     void loadRomInfo();
+    bool getRomProperties(int item, Properties& props);
     void handleContextMenu();
     void setListFilters();
     bool matchPattern(const string& s, const string& pattern) const;
@@ -93,6 +99,8 @@ class LauncherDialog : public Dialog
   private:
     unique_ptr<OptionsDialog> myOptions;
     unique_ptr<GameList> myGameList;
+    unique_ptr<DirectoryLister> myLister;
+    unique_ptr<RomCatalogue> myCatalogue;
     unique_ptr<ContextMenu> myMenu;
     unique_ptr<GlobalPropsDialog> myGlobalProps;
     unique_ptr<LauncherFilterDialog> myFilters;
@@ -112,12 +120,34 @@ class LauncherDialog : public Dialog
 
     RomInfoWidget* myRomInfoWidget;
 
+    // The item last shown in the ROM info widget; the snapshots of the
+    // items following it in the direction of scrolling are prefetched
+    int myRomInfoItem;
+
     int mySelectedItem;
     FilesystemNode myCurrentNode;
     Common::FixedStack<string> myNodeNames;
 
     StringList myRomExts;
 
+    // Whether all ROMs in the catalogue are searched, instead of listing
+    // the current directory
+    bool mySearchAll;
+
+    // Ticks since the catalogue was last polled while it's being updated
+    uInt32 mySearchTicks;
+
+    // The item to select once it's been found by the (background) listing,
+    // unless the user selects something else first
+    string myPendingSelection;
+    bool mySelectionPending;
+
+    // Whether the list widget still shows the previous listing
+    bool myListReplaced;
+
+    // Number of snapshots to prefetch when the selection changes
+    static constexpr int kPrefetchCount = 3;
+
     enum {
       kPrevDirCmd = 'PRVD',
       kOptionsCmd = 'OPTI',
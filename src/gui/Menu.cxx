@@ -25,6 +25,11 @@
 Menu::Menu(OSystem& osystem)
   : DialogContainer(osystem)
 {
-  myBaseDialog = new OptionsDialog(myOSystem, *this, 0,
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Dialog* Menu::createBaseDialog()
+{
+  return new OptionsDialog(myOSystem, *this, 0,
       FrameBuffer::kFBMinW, FrameBuffer::kFBMinH, false);
 }
@@ -36,6 +36,12 @@ class Menu : public DialogContainer
     Menu(OSystem& osystem);
     virtual ~Menu() = default;
 
+  protected:
+    /**
+      Create the dialog shown by this container.
+    */
+    Dialog* createBaseDialog() override;
+
   private:
     // Following constructors and assignment operators not supported
     Menu() = delete;
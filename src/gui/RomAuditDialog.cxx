@@ -123,7 +123,7 @@ void RomAuditDialog::auditRoms()
   progress.setRange(0, int(files.size()) - 1, 5);
 
   // Create a entry for the GameList for each file
-  Properties props;
+  PropertiesView props;
   int renamed = 0, notfound = 0;
   for(uInt32 idx = 0; idx < files.size(); idx++)
   {
@@ -137,10 +137,10 @@ void RomAuditDialog::auditRoms()
       const string& md5 = MD5::hash(files[idx]);
       if(instance().propSet().getMD5(md5, props))
       {
-        const string& name = props.get(Cartridge_Name);
+        const char* name = props.get(Cartridge_Name);
 
         // Only rename the file if we found a valid properties entry
-        if(name != "" && name != files[idx].getName())
+        if(*name != 0 && files[idx].getName() != name)
         {
           const string& newfile = node.getPath() + name + "." + extension;
           if(files[idx].getPath() != newfile && files[idx].rename(newfile))
@@ -0,0 +1,296 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2017 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+
+#include <fstream>
+#include <sstream>
+
+#include "LauncherFilterDialog.hxx"
+#include "MD5.hxx"
+#include "Props.hxx"
+#include "PropsSet.hxx"
+#include "RomCatalogue.hxx"
+
+const string RomCatalogue::ourHeader = ";  Stella ROM catalogue (2)";
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+RomCatalogue::RomCatalogue(const string& filename, const PropertiesSet& props)
+  : myFilename(filename),
+    myProperties(props),
+    myIsDirty(false),
+    myIsFinished(false),
+    myIsCancelled(false),
+    myIsUpdating(false)
+{
+  ifstream in(myFilename);
+  string line;
+  if(!in || !getline(in, line) || line != ourHeader)
+    return;
+
+  // Each line contains the MD5, the size and modification time of the
+  // file, and the path (which may contain spaces), separated by a space
+  while(getline(in, line))
+  {
+    istringstream buf(line);
+    FileInfo file;
+    string path;
+    if(buf >> file.md5 >> file.size >> file.mtime && buf.get() == ' ' &&
+       getline(buf, path) && path != "")
+      addEntry(path, file);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+RomCatalogue::~RomCatalogue()
+{
+  // Keep the ROMs found by an unfinished scan, so that they don't have to
+  // be read again next time; nothing is removed, since the scan is
+  // incomplete
+  const bool updating = myIsUpdating;
+  cancel();
+  if(updating)
+  {
+    addRoms(myFound);
+    save();
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomCatalogue::update(const FilesystemNode& dir)
+{
+  cancel();
+
+  // The ROMs already in the catalogue don't have to be read again,
+  // unless their files changed
+  PathMap known;
+  for(const auto& entry: myEntries)
+    if(entry.path != "")
+      known[entry.path] = entry.file;
+
+  myFound.clear();
+  mySeen.clear();
+  myIsFinished = false;
+  myIsCancelled = false;
+  myIsUpdating = true;
+
+  myThread = std::thread([this, dir, known] {
+    scanDirectory(dir, known, 0);
+
+    std::lock_guard<std::mutex> lock(myMutex);
+    myIsFinished = true;
+  });
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool RomCatalogue::poll()
+{
+  if(!myIsUpdating)
+    return false;
+
+  vector<std::pair<string, FileInfo>> found;
+  bool finished;
+  {
+    std::lock_guard<std::mutex> lock(myMutex);
+    found.swap(myFound);
+    finished = myIsFinished;
+  }
+
+  bool changed = addRoms(found);
+  if(finished)
+  {
+    myThread.join();
+    myIsUpdating = false;
+
+    // Anything not found by the (complete) scan no longer exists
+    for(uInt32 id = 0; id < myEntries.size(); ++id)
+    {
+      if(myEntries[id].path != "" && mySeen.count(myEntries[id].path) == 0)
+      {
+        removeEntry(id);
+        changed = myIsDirty = true;
+      }
+    }
+    mySeen.clear();
+    save();
+  }
+  return changed;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool RomCatalogue::addRoms(const vector<std::pair<string, FileInfo>>& found)
+{
+  bool changed = false;
+  for(const auto& rom: found)
+  {
+    mySeen.insert(rom.first);
+
+    const auto& iter = myPaths.find(rom.first);
+    if(iter != myPaths.end())
+    {
+      FileInfo& file = myEntries[iter->second].file;
+      if(file.md5 == rom.second.md5)
+      {
+        // Only the stamp may have changed, which doesn't affect the index
+        if(file.size != rom.second.size || file.mtime != rom.second.mtime)
+        {
+          file = rom.second;
+          myIsDirty = true;
+        }
+        continue;
+      }
+      removeEntry(iter->second);
+    }
+    addEntry(rom.first, rom.second);
+    changed = myIsDirty = true;
+  }
+  return changed;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomCatalogue::search(const string& query,
+                          vector<const Entry*>& result) const
+{
+  vector<uInt32> ids;
+  myIndex.find(query, ids);
+
+  result.clear();
+  result.reserve(ids.size());
+  for(uInt32 id: ids)
+    result.push_back(&myEntries[id]);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomCatalogue::save()
+{
+  if(!myIsDirty)
+    return;
+
+  ofstream out(myFilename);
+  if(!out)
+    return;
+
+  out << ourHeader << endl;
+  for(const auto& entry: myEntries)
+    if(entry.path != "")
+      out << entry.file.md5 << " " << entry.file.size << " "
+          << entry.file.mtime << " " << entry.path << endl;
+
+  myIsDirty = false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomCatalogue::addEntry(const string& path, const FileInfo& file)
+{
+  const uInt32 id = uInt32(myEntries.size());
+
+  // The filename (without extension) can be searched too, and is shown
+  // for ROMs which aren't in the properties
+  string::size_type start = path.find_last_of("/\\");
+  start = start == string::npos ? 0 : start + 1;
+  string::size_type end = path.find_last_of('.');
+  if(end == string::npos || end < start)
+    end = path.length();
+  const string filename = path.substr(start, end - start);
+
+  Entry entry;
+  entry.path = path;
+  entry.file = file;
+
+  string text;
+  PropertiesView view;
+  if(myProperties.getMD5(file.md5, view))
+  {
+    entry.name = view.get(Cartridge_Name);
+    text = entry.name + "\n" + view.get(Cartridge_Manufacturer) + "\n" +
+           view.get(Cartridge_ModelNo) + "\n" + view.get(Cartridge_Rarity) +
+           "\n" + view.get(Cartridge_Note) + "\n" + filename;
+  }
+  else
+    text = entry.name = filename;
+
+  myIndex.add(id, text);
+  myPaths[path] = id;
+  myEntries.push_back(std::move(entry));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomCatalogue::removeEntry(uInt32 id)
+{
+  myIndex.remove(id);
+  myPaths.erase(myEntries[id].path);
+  myEntries[id] = Entry();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomCatalogue::cancel()
+{
+  if(myThread.joinable())
+  {
+    myIsCancelled = true;
+    myThread.join();
+  }
+  myIsUpdating = false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomCatalogue::scanDirectory(const FilesystemNode& dir,
+                                 const PathMap& known, uInt32 depth)
+{
+  FSList dirs;
+  dir.listChildren([&](const FilesystemNode& node) {
+    string ext;
+    if(node.isDirectory())
+      dirs.push_back(node);
+    else if(BSPF::endsWithIgnoreCase(node.getPath(), ".zip"))
+    {
+      // Archives containing several ROMs are scanned like directories
+      const FilesystemNode zip(node.getPath());
+      if(zip.isDirectory())
+        dirs.push_back(zip);
+      else if(zip.isFile())
+        addFound(zip, known);
+    }
+    else if(LauncherFilterDialog::isValidRomName(node, ext))
+      addFound(node, known);
+
+    return !myIsCancelled;
+  }, FilesystemNode::kListAll);
+
+  if(depth < kMaxDepth)
+    for(const auto& d: dirs)
+      if(!myIsCancelled)
+        scanDirectory(d, known, depth + 1);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomCatalogue::addFound(const FilesystemNode& rom, const PathMap& known)
+{
+  FileInfo file;
+  if(!rom.getStamp(file.size, file.mtime))
+    file.size = file.mtime = 0;
+
+  // Without a stamp, a changed file can't be detected, so it's read again
+  const auto& iter = known.find(rom.getPath());
+  if(iter != known.end() && (file.size != 0 || file.mtime != 0) &&
+     iter->second.size == file.size && iter->second.mtime == file.mtime)
+    file.md5 = iter->second.md5;
+  else
+    file.md5 = MD5::hash(rom);
+
+  std::lock_guard<std::mutex> lock(myMutex);
+  myFound.emplace_back(rom.getPath(), file);
+}
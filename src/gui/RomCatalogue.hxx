@@ -0,0 +1,193 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2017 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+
+#ifndef ROM_CATALOGUE_HXX
+#define ROM_CATALOGUE_HXX
+
+class PropertiesSet;
+
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "FSNode.hxx"
+#include "SearchIndex.hxx"
+#include "bspf.hxx"
+
+/**
+  This class keeps a catalogue of all ROMs in the ROM directory (and the
+  directories below it), so they can be searched by the information from
+  their properties (name, manufacturer, model number, rarity and note),
+  or their filename.
+
+  The path and MD5 of each ROM (along with the size and modification time
+  of its file) are stored in a file, so that updating the catalogue only
+  has to read the ROMs which are new or have changed.  ROMs inside ZIP
+  archives are included.  The directories are scanned in a background
+  thread, and the ROMs found are added to the catalogue (and its search
+  index) by calling poll() until the update has finished.
+*/
+class RomCatalogue
+{
+  public:
+    // The file of a ROM, and the md5 calculated from it
+    struct FileInfo {
+      string md5;
+      uInt64 size;   // size and modification time of the file (or of
+      uInt64 mtime;  // the ZIP archive containing it) when it was read
+    };
+
+    // A ROM in the catalogue
+    struct Entry {
+      string path;
+      FileInfo file;
+      string name;  // the name shown for the ROM
+    };
+
+  public:
+    /**
+      Create a catalogue, loading the ROMs from the given file.
+
+      @param filename  The file the catalogue is stored in
+      @param props     The properties used to find the ROMs' information
+    */
+    RomCatalogue(const string& filename, const PropertiesSet& props);
+    ~RomCatalogue();
+
+    /**
+      Start scanning the given directory (and all directories below it)
+      for ROMs; any scan still in progress is cancelled.  ROMs which are
+      no longer found are removed once the scan has finished.
+
+      @param dir  The directory to scan
+    */
+    void update(const FilesystemNode& dir);
+
+    /**
+      Add the ROMs found by the scan since the last call to the catalogue.
+      This should be called periodically while updating.
+
+      @return  True if the catalogue has changed
+    */
+    bool poll();
+
+    /**
+      Answer whether a scan is in progress.
+    */
+    bool isUpdating() const { return myIsUpdating; }
+
+    /**
+      Find the ROMs whose information contains all words of the query;
+      an empty query matches all ROMs.
+
+      @param query   The words to search for
+      @param result  Receives the matching ROMs
+    */
+    void search(const string& query, vector<const Entry*>& result) const;
+
+    /**
+      Save the catalogue to its file, if anything has changed.
+    */
+    void save();
+
+  private:
+    using PathMap = std::unordered_map<string, FileInfo>;
+
+    /**
+      Add a ROM to the catalogue, and to the search index.
+    */
+    void addEntry(const string& path, const FileInfo& file);
+
+    /**
+      Remove the ROM with the given number from the catalogue.
+    */
+    void removeEntry(uInt32 id);
+
+    /**
+      Add the ROMs found by the scan (path and file), replacing those
+      whose files changed.
+
+      @return  True if the catalogue has changed
+    */
+    bool addRoms(const vector<std::pair<string, FileInfo>>& found);
+
+    /**
+      Stop the current scan (if any); ROMs not yet added are lost.
+    */
+    void cancel();
+
+    /**
+      Scan a directory for ROMs; this is used by the background thread.
+
+      @param dir    The directory (or ZIP archive) to scan
+      @param known  The files of the ROMs already in the catalogue
+      @param depth  The number of parent directories scanned
+    */
+    void scanDirectory(const FilesystemNode& dir, const PathMap& known,
+                       uInt32 depth);
+
+    /**
+      Pass a ROM found by the scan on to poll(); its md5 is only
+      calculated if the file isn't known or has changed.
+    */
+    void addFound(const FilesystemNode& rom, const PathMap& known);
+
+  private:
+    // Maximum depth of directories scanned, in case of symlink loops
+    static constexpr uInt32 kMaxDepth = 16;
+
+    // Name of the file the catalogue is stored in
+    string myFilename;
+
+    const PropertiesSet& myProperties;
+
+    // All ROMs, numbered as in the search index (removed ROMs have no path)
+    vector<Entry> myEntries;
+    std::unordered_map<string, uInt32> myPaths;
+    SearchIndex myIndex;
+
+    // Whether ROMs have been added or removed since the file was loaded
+    bool myIsDirty;
+
+    // The background scan; the lock protects the ROMs found (path and
+    // file), and the finished flag
+    std::thread myThread;
+    std::mutex myMutex;
+    vector<std::pair<string, FileInfo>> myFound;
+    bool myIsFinished;
+    std::atomic<bool> myIsCancelled;
+    bool myIsUpdating;
+
+    // The ROMs found by the current scan so far
+    std::unordered_set<string> mySeen;
+
+    // Identifies a catalogue file
+    static const string ourHeader;
+
+  private:
+    // Following constructors and assignment operators not supported
+    RomCatalogue() = delete;
+    RomCatalogue(const RomCatalogue&) = delete;
+    RomCatalogue(RomCatalogue&&) = delete;
+    RomCatalogue& operator=(const RomCatalogue&) = delete;
+    RomCatalogue& operator=(RomCatalogue&&) = delete;
+};
+
+#endif
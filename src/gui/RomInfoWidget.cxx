@@ -16,7 +16,9 @@
 //============================================================================
 
 #include "FrameBuffer.hxx"
+#include "MD5.hxx"
 #include "OSystem.hxx"
+#include "PropsSet.hxx"
 #include "Settings.hxx"
 #include "Widget.hxx"
 
@@ -42,7 +44,27 @@ void RomInfoWidget::loadConfig()
   // by saving a different image or through a change in video renderer,
   // so we reload the properties
   if(myHaveProperties)
+  {
+    mySnapshots.clear();
     parseProperties();
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomInfoWidget::prefetch(const FilesystemNode& rom, const string& md5)
+{
+  // Only the built-in properties are searched, since the others may be
+  // changed by the main thread at any time; this finds the name of all
+  // but (rarely) user-renamed ROMs, for which the prefetch is wasted
+  const string dir = instance().snapshotLoadDir();
+  const PropertiesSet& propset = instance().propSet();
+  mySnapshots.prefetch([rom, md5, dir, &propset] {
+    const string& romMD5 = md5 != "" ? md5 : MD5::hash(rom);
+    Properties props;
+    const string& name = propset.getMD5(romMD5, props, true) ?
+        props.get(Cartridge_Name) : rom.getNameWithExt("");
+    return dir + name + ".png";
+  });
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -60,6 +82,7 @@ void RomInfoWidget::setProperties(const Properties& props)
 void RomInfoWidget::clearProperties()
 {
   myHaveProperties = mySurfaceIsValid = false;
+  myPendingSnapshot = "";
   if(mySurface)
     mySurface->setVisible(mySurfaceIsValid);
 
@@ -85,30 +108,15 @@ void RomInfoWidget::parseProperties()
 
   // Initialize to empty properties entry
   mySurfaceErrorMsg = "";
-  mySurfaceIsValid = true;
   myRomInfo.clear();
 
-  // Get a valid filename representing a snapshot file for this rom
-  const string& filename = instance().snapshotLoadDir() +
-      myProperties.get(Cartridge_Name) + ".png";
-
-  // Read the PNG file
-  try
-  {
-    instance().png().loadImage(filename, *mySurface);
-
-    // Scale surface to available image area
-    const GUI::Rect& src = mySurface->srcRect();
-    float scale = std::min(float(myAvail.w) / src.width(), float(myAvail.h) / src.height());
-    mySurface->setDstSize(uInt32(src.width() * scale), uInt32(src.height() * scale));
-  }
-  catch(const runtime_error& e)
-  {
-    mySurfaceIsValid = false;
-    mySurfaceErrorMsg = e.what();
-  }
-  if(mySurface)
-    mySurface->setVisible(mySurfaceIsValid);
+  // The snapshot is decoded in the background (unless it has already been
+  // decoded), and shown by updateSnapshot() once it's available
+  mySurfaceIsValid = false;
+  mySurface->setVisible(false);
+  myPendingSnapshot = snapshotFilename(myProperties);
+  mySnapshots.load(myPendingSnapshot);
+  updateSnapshot();
 
   // Now add some info for the message box below the image
   myRomInfo.push_back("Name:  " + myProperties.get(Cartridge_Name));
@@ -126,6 +134,42 @@ void RomInfoWidget::parseProperties()
   setDirty();
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomInfoWidget::updateSnapshot()
+{
+  if(myPendingSnapshot == "")
+    return;
+
+  shared_ptr<const SnapshotLoader::Snapshot> snapshot =
+      mySnapshots.get(myPendingSnapshot);
+  if(!snapshot)
+    return;
+  myPendingSnapshot = "";
+
+  if(snapshot->error == "")
+  {
+    instance().png().loadImage(snapshot->image, *mySurface);
+
+    // Scale surface to available image area
+    const GUI::Rect& src = mySurface->srcRect();
+    float scale = std::min(float(myAvail.w) / src.width(), float(myAvail.h) / src.height());
+    mySurface->setDstSize(uInt32(src.width() * scale), uInt32(src.height() * scale));
+    mySurfaceIsValid = true;
+  }
+  else
+    mySurfaceErrorMsg = snapshot->error;
+
+  mySurface->setVisible(mySurfaceIsValid);
+  setDirty();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string RomInfoWidget::snapshotFilename(const Properties& props) const
+{
+  // Get a valid filename representing a snapshot file for this rom
+  return instance().snapshotLoadDir() + props.get(Cartridge_Name) + ".png";
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void RomInfoWidget::drawWidget(bool hilite)
 {
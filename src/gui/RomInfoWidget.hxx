@@ -24,6 +24,7 @@
 #include "Widget.hxx"
 #include "Command.hxx"
 #include "Rect.hxx"
+#include "SnapshotLoader.hxx"
 #include "bspf.hxx"
 
 
@@ -38,11 +39,28 @@ class RomInfoWidget : public Widget
     void clearProperties();
     void loadConfig() override;
 
+    /**
+      Decode the snapshot for the given ROM in the background, since it's
+      likely to be shown soon.  Finding the snapshot's name (which needs
+      the ROM's md5 and properties) is done in the background too.
+
+      @param rom  The ROM file
+      @param md5  The md5 of the ROM, if already known
+    */
+    void prefetch(const FilesystemNode& rom, const string& md5);
+
+    /**
+      Show the snapshot of the current ROM once it has been decoded; this
+      should be called periodically.
+    */
+    void updateSnapshot();
+
   protected:
     void drawWidget(bool hilite) override;
 
   private:
     void parseProperties();
+    string snapshotFilename(const Properties& props) const;
 
   private:
     // Surface pointer holding the PNG image
@@ -51,6 +69,12 @@ class RomInfoWidget : public Widget
     // Whether the surface should be redrawn by drawWidget()
     bool mySurfaceIsValid;
 
+    // Decodes snapshots in the background, and caches the results
+    SnapshotLoader mySnapshots;
+
+    // The snapshot waiting to be shown, once it has been decoded
+    string myPendingSnapshot;
+
     // Some ROM properties info, as well as 'tEXt' chunks from the PNG image
     StringList myRomInfo;
 
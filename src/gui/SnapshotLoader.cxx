@@ -0,0 +1,188 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2017 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+
+#include "SnapshotLoader.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+SnapshotLoader::SnapshotLoader()
+  : myThreadQuit(false),
+    myGeneration(0)
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+SnapshotLoader::~SnapshotLoader()
+{
+  if(myThread.joinable())
+  {
+    {
+      std::lock_guard<std::mutex> lock(myMutex);
+      myThreadQuit = true;
+    }
+    myCondition.notify_one();
+    myThread.join();
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SnapshotLoader::load(const string& filename)
+{
+  std::lock_guard<std::mutex> lock(myMutex);
+
+  // Anything not decoded yet is no longer needed first (or at all)
+  myQueue.clear();
+  if(!isRequested(filename))
+    queueRequest(filename);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SnapshotLoader::prefetch(const string& filename)
+{
+  std::lock_guard<std::mutex> lock(myMutex);
+
+  if(isRequested(filename))
+    return;
+  for(const auto& request: myQueue)
+    if(request.filename == filename)
+      return;
+
+  queueRequest(filename);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SnapshotLoader::prefetch(const Namer& namer)
+{
+  std::lock_guard<std::mutex> lock(myMutex);
+
+  // Duplicates can only be detected once the name is known
+  queueRequest("", namer);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+shared_ptr<const SnapshotLoader::Snapshot>
+SnapshotLoader::get(const string& filename)
+{
+  std::lock_guard<std::mutex> lock(myMutex);
+  return findCached(filename);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SnapshotLoader::clear()
+{
+  std::lock_guard<std::mutex> lock(myMutex);
+  myCache.clear();
+  myCurrentFile = "";
+  ++myGeneration;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+shared_ptr<const SnapshotLoader::Snapshot>
+SnapshotLoader::findCached(const string& filename)
+{
+  for(auto it = myCache.begin(); it != myCache.end(); ++it)
+  {
+    if((*it)->filename == filename)
+    {
+      myCache.splice(myCache.begin(), myCache, it);
+      return myCache.front();
+    }
+  }
+  return nullptr;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool SnapshotLoader::isRequested(const string& filename) const
+{
+  if(filename == myCurrentFile)
+    return true;
+
+  for(const auto& snapshot: myCache)
+    if(snapshot->filename == filename)
+      return true;
+
+  return false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SnapshotLoader::queueRequest(const string& filename, const Namer& namer)
+{
+  myQueue.push_back(Request{filename, namer});
+
+  if(!myThread.joinable())
+    myThread = std::thread([this] { loadThread(); });
+  myCondition.notify_one();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SnapshotLoader::loadThread()
+{
+  std::unique_lock<std::mutex> lock(myMutex);
+  for(;;)
+  {
+    myCondition.wait(lock, [this] {
+      return myThreadQuit || !myQueue.empty();
+    });
+    if(myThreadQuit)
+      break;
+
+    Request request = std::move(myQueue.front());
+    myQueue.pop_front();
+    const uInt32 generation = myGeneration;
+
+    if(request.namer)
+    {
+      lock.unlock();
+      try
+      {
+        request.filename = request.namer();
+      }
+      catch(const runtime_error&)
+      {
+        request.filename = "";
+      }
+      lock.lock();
+
+      // The snapshot may have been requested by name in the meantime
+      if(request.filename == "" || isRequested(request.filename) ||
+         generation != myGeneration)
+        continue;
+    }
+
+    auto snapshot = make_shared<Snapshot>();
+    snapshot->filename = myCurrentFile = request.filename;
+    lock.unlock();
+
+    try
+    {
+      PNGLibrary::readImage(snapshot->filename, snapshot->image);
+    }
+    catch(const runtime_error& e)
+    {
+      snapshot->error = e.what();
+    }
+
+    lock.lock();
+    myCurrentFile = "";
+    if(generation == myGeneration)
+    {
+      myCache.push_front(snapshot);
+      if(myCache.size() > kCacheSize)
+        myCache.pop_back();
+    }
+  }
+}
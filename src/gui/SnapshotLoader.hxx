@@ -0,0 +1,158 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2017 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+
+#ifndef SNAPSHOT_LOADER_HXX
+#define SNAPSHOT_LOADER_HXX
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <list>
+
+#include "Rect.hxx"
+#include "Variant.hxx"
+#include "PNGLibrary.hxx"
+#include "bspf.hxx"
+
+/**
+  This class decodes ROM snapshots in a background thread, so that
+  scrolling through the ROM launcher isn't slowed down by PNG decoding.
+  The most recently used images are kept (in decoded form) in a small
+  cache, which the images of the entries the user is likely to select
+  next can be prefetched into.
+*/
+class SnapshotLoader
+{
+  public:
+    // A decoded snapshot; if it couldn't be loaded, the error is set
+    struct Snapshot {
+      string filename;
+      PNGLibrary::ReadInfoType image;
+      string error;
+    };
+
+  public:
+    SnapshotLoader();
+    ~SnapshotLoader();
+
+    /**
+      Request the given snapshot, which is decoded before any others.
+      All requests still waiting to be decoded are cancelled.
+
+      @param filename  The snapshot (PNG) file
+    */
+    void load(const string& filename);
+
+    /**
+      Decode the given snapshot into the cache, once all earlier requests
+      have been decoded.
+
+      @param filename  The snapshot (PNG) file
+    */
+    void prefetch(const string& filename);
+
+    /**
+      Decode a snapshot into the cache, as above, whose filename is only
+      determined by the background thread (since that may involve reading
+      the ROM it belongs to).
+
+      @param namer  Returns the snapshot (PNG) file; it's called from the
+                    background thread, and may throw a runtime_error
+    */
+    using Namer = std::function<string()>;
+    void prefetch(const Namer& namer);
+
+    /**
+      Get a snapshot from the cache.
+
+      @param filename  The snapshot (PNG) file
+
+      @return  The snapshot, or nullptr if it hasn't been decoded (yet)
+    */
+    shared_ptr<const Snapshot> get(const string& filename);
+
+    /**
+      Remove all snapshots from the cache, since the files may have
+      changed.
+    */
+    void clear();
+
+  private:
+    /**
+      Find a snapshot in the cache, and mark it as most recently used.
+      Must be called with the lock held.
+    */
+    shared_ptr<const Snapshot> findCached(const string& filename);
+
+    /**
+      Answer whether the snapshot is cached, being decoded or waiting to
+      be.  Must be called with the lock held.
+    */
+    bool isRequested(const string& filename) const;
+
+    /**
+      Add a request, starting the background thread if necessary.  Must
+      be called with the lock held.
+    */
+    void queueRequest(const string& filename, const Namer& namer = nullptr);
+
+    /**
+      The background thread; decodes requested snapshots until the loader
+      is destroyed.
+    */
+    void loadThread();
+
+  private:
+    // Maximum number of decoded snapshots kept
+    static constexpr uInt32 kCacheSize = 16;
+
+    // The lock protects all members
+    std::mutex myMutex;
+    std::condition_variable myCondition;
+    std::thread myThread;
+    bool myThreadQuit;
+
+    // A snapshot waiting to be decoded; if the namer is set, the filename
+    // is determined by calling it
+    struct Request {
+      string filename;
+      Namer namer;
+    };
+
+    // Snapshots waiting to be decoded, and the one being decoded now
+    std::deque<Request> myQueue;
+    string myCurrentFile;
+
+    // Decoded snapshots, most recently used first
+    std::list<shared_ptr<const Snapshot>> myCache;
+
+    // Incremented whenever the cache is cleared, so snapshots decoded
+    // from the old files are dropped
+    uInt32 myGeneration;
+
+  private:
+    // Following constructors and assignment operators not supported
+    SnapshotLoader(const SnapshotLoader&) = delete;
+    SnapshotLoader(SnapshotLoader&&) = delete;
+    SnapshotLoader& operator=(const SnapshotLoader&) = delete;
+    SnapshotLoader& operator=(SnapshotLoader&&) = delete;
+};
+
+#endif
@@ -37,6 +37,35 @@ void StringListWidget::setList(const StringList& list)
   ListWidget::recalc();
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void StringListWidget::updateList(StringList list)
+{
+  const string selected = getSelectedString();
+  const int row = _selectedItem - _currentPos;
+
+  _list = std::move(list);
+
+  if(selected != "")
+  {
+    const auto& iter = std::find(_list.cbegin(), _list.cend(), selected);
+    if(iter != _list.cend())
+    {
+      _selectedItem = int(iter - _list.cbegin());
+      _currentPos = _selectedItem - row;
+    }
+  }
+  const int size = int(_list.size());
+  if(_currentPos + _rows > size)
+    _currentPos = size - _rows;
+
+  ListWidget::recalc();
+  scrollBarRecalc();
+  setDirty();
+
+  if(getSelectedString() != selected)
+    sendCommand(ListWidget::kSelectionChangedCmd, _selectedItem, _id);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void StringListWidget::drawWidget(bool hilite)
 {
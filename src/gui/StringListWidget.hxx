@@ -29,6 +29,14 @@ class StringListWidget : public ListWidget
     virtual ~StringListWidget() = default;
 
     void setList(const StringList& list);
+
+    /**
+      Replace the contents of a list which is being built incrementally.
+      Unlike setList(), the currently selected string stays selected (and
+      at the same place in the view); a selection change is only signalled
+      when it isn't in the new list anymore.
+    */
+    void updateList(StringList list);
     bool wantsFocus() const override { return true; }
 
   protected:
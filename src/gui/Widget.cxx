@@ -289,6 +289,27 @@ void Widget::setDirtyInChain(Widget* start)
   }
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool Widget::drawDirtyInChain(Widget* start)
+{
+  bool drawn = false;
+  for(; start; start = start->_next)
+  {
+    if(!start->isVisible() || !start->_boss->isVisible())
+      continue;
+
+    // Drawing a widget also draws its children which are dirty
+    if(start->_dirty)
+    {
+      start->draw();
+      drawn = true;
+    }
+    else if(drawDirtyInChain(start->_firstWidget))
+      drawn = true;
+  }
+  return drawn;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 StaticTextWidget::StaticTextWidget(GuiObject* boss, const GUI::Font& font,
                                    int x, int y, int w, int h,
@@ -326,9 +347,11 @@ void StaticTextWidget::setValue(int value)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void StaticTextWidget::setLabel(const string& label)
 {
-  _label = label;
-
-  setDirty();
+  if(_label != label)
+  {
+    _label = label;
+    setDirty();
+  }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
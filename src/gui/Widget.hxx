@@ -158,6 +158,10 @@ class Widget : public GuiObject
     /** Sets all widgets in this chain to be dirty (must be redrawn) */
     static void setDirtyInChain(Widget* start);
 
+    /** Draw the widgets in this chain (and their children) which are dirty,
+        and answer whether any were drawn */
+    static bool drawDirtyInChain(Widget* start);
+
   private:
     // Following constructors and assignment operators not supported
     Widget() = delete;
@@ -10,6 +10,7 @@ MODULE_OBJS := \
 	src/gui/CommandMenu.o \
 	src/gui/ContextMenu.o \
 	src/gui/DialogContainer.o \
+	src/gui/DirectoryLister.o \
 	src/gui/Dialog.o \
 	src/gui/EditableWidget.o \
 	src/gui/EditTextWidget.o \
@@ -36,7 +37,9 @@ MODULE_OBJS := \
 	src/gui/PopUpWidget.o \
 	src/gui/ProgressDialog.o \
 	src/gui/RomAuditDialog.o \
+	src/gui/RomCatalogue.o \
 	src/gui/RomInfoWidget.o \
+	src/gui/SnapshotLoader.o \
 	src/gui/ScrollBarWidget.o \
 	src/gui/CheckListWidget.o \
 	src/gui/StringListWidget.o \
@@ -144,6 +144,17 @@ sub num_prop_types {
   return keys( %prop_type );
 }
 
+# Get the values of a properties set, with the default values replaced
+# by empty strings
+sub build_prop_values {
+  my @array = @_;
+  my @items = ();
+  for (my $i = 0; $i < @array; $i++) {
+    push(@items, ($prop_defaults[$i] ne $array[$i]) ? $array[$i] : "");
+  }
+  return @items;
+}
+
 # Convert a properties set into a C++ compatible string
 sub build_prop_string {
   my @array = @_;
@@ -0,0 +1,231 @@
+/**
+  Converts an A/V capture file created by Stella (with Alt-a) into a
+  sequence of PNG images and a WAV file.
+
+  Compile with:  g++ -std=c++14 -O2 -o capconv capconv.cxx -lpng -lz
+
+  The images are named <prefix>_<frame number>.png, and are saved with
+  each TIA pixel doubled horizontally, as in 1x mode snapshots.  Frames
+  which were dropped during capture have no image, so there will be gaps
+  in the numbering.
+*/
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <memory>
+#include <vector>
+#include <cstring>
+#include <png.h>
+#include <zlib.h>
+
+using namespace std;
+
+using uInt8 = unsigned char;
+using uInt32 = unsigned int;
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 get16(const uInt8* buf) { return buf[0] | (buf[1] << 8); }
+uInt32 get32(const uInt8* buf) { return get16(buf) | (get16(buf + 2) << 16); }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool inflateData(const uInt8* data, uInt32 size, vector<uInt8>& out)
+{
+  uLongf length = out.size();
+  return uncompress(out.data(), &length, data, size) == Z_OK &&
+         length == out.size();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool savePNG(const string& filename, const vector<uInt8>& frame,
+             uInt32 width, uInt32 height, const uInt8* palette)
+{
+  FILE* out = fopen(filename.c_str(), "wb");
+  if(!out)
+    return false;
+
+  png_structp png_ptr =
+      png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+  png_infop info_ptr = png_create_info_struct(png_ptr);
+  if(setjmp(png_jmpbuf(png_ptr)))
+  {
+    png_destroy_write_struct(&png_ptr, &info_ptr);
+    fclose(out);
+    return false;
+  }
+  png_init_io(png_ptr, out);
+  png_set_IHDR(png_ptr, info_ptr, width * 2, height, 8, PNG_COLOR_TYPE_RGB,
+      PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT);
+  png_write_info(png_ptr, info_ptr);
+
+  vector<uInt8> row(width * 2 * 3);
+  for(uInt32 y = 0; y < height; ++y)
+  {
+    uInt8* p = row.data();
+    for(uInt32 x = 0; x < width; ++x)
+    {
+      const uInt8* rgb = palette + frame[y * width + x] * 3;
+      for(int i = 0; i < 2; ++i)
+      {
+        *p++ = rgb[0];  *p++ = rgb[1];  *p++ = rgb[2];
+      }
+    }
+    png_write_row(png_ptr, row.data());
+  }
+  png_write_end(png_ptr, info_ptr);
+  png_destroy_write_struct(&png_ptr, &info_ptr);
+  fclose(out);
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void writeWAVHeader(ofstream& out, uInt32 rate, uInt32 channels, uInt32 bytes)
+{
+  uInt8 header[44];
+  auto put16 = [&](int pos, uInt32 v) {
+    header[pos] = uInt8(v);  header[pos+1] = uInt8(v >> 8);
+  };
+  auto put32 = [&](int pos, uInt32 v) { put16(pos, v);  put16(pos+2, v >> 16); };
+
+  memcpy(header, "RIFF", 4);       put32(4, 36 + bytes);
+  memcpy(header + 8, "WAVEfmt ", 8);
+  put32(16, 16);                   put16(20, 1);  // PCM
+  put16(22, channels);             put32(24, rate);
+  put32(28, rate * channels * 2);  put16(32, channels * 2);
+  put16(34, 16);
+  memcpy(header + 36, "data", 4);  put32(40, bytes);
+
+  out.seekp(0);
+  out.write(reinterpret_cast<const char*>(header), sizeof(header));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+int main(int ac, char* av[])
+{
+  if(ac < 3)
+  {
+    cout << av[0] << " <CAPTURE_FILE> <OUTPUT_PREFIX>" << endl
+         << endl
+         << "  Convert a Stella A/V capture into <OUTPUT_PREFIX>_<frame>.png" << endl
+         << "  images and <OUTPUT_PREFIX>.wav." << endl
+         << endl;
+    return 0;
+  }
+
+  ifstream in(av[1], ios_base::binary);
+  uInt8 header[16];
+  if(!in.read(reinterpret_cast<char*>(header), sizeof(header)) ||
+     memcmp(header, "StellaAV", 8) != 0 || get32(header + 8) != 1)
+  {
+    cerr << "ERROR: " << av[1] << " is not a (supported) capture file" << endl;
+    return 1;
+  }
+  cout << "Framerate: " << (get32(header + 12) / 1000.0) << endl;
+
+  const string prefix = av[2];
+  uInt8 palette[256 * 3];
+  memset(palette, 0, sizeof(palette));
+  vector<uInt8> frame, delta, data;
+  uInt32 width = 0, height = 0, frames = 0;
+
+  ofstream wav;
+  uInt32 wavRate = 0, wavChannels = 0, wavBytes = 0;
+
+  uInt8 chunk[5];
+  while(in.read(reinterpret_cast<char*>(chunk), sizeof(chunk)))
+  {
+    uInt32 size = get32(chunk + 1);
+    data.resize(size);
+    if(!in.read(reinterpret_cast<char*>(data.data()), size))
+    {
+      cerr << "WARNING: capture file is truncated" << endl;
+      break;
+    }
+
+    switch(chunk[0])
+    {
+      case 'P':
+        if(size == sizeof(palette))
+          memcpy(palette, data.data(), size);
+        break;
+
+      case 'F':
+      {
+        if(size < 9)
+          break;
+        uInt32 number = get32(data.data());
+        uInt32 w = get16(data.data() + 4), h = get16(data.data() + 6);
+        bool keyframe = data[8] != 0;
+        if(!keyframe && (w != width || h != height))
+        {
+          cerr << "WARNING: skipping frame " << number << " (no keyframe)" << endl;
+          break;
+        }
+        delta.resize(w * h);
+        if(!inflateData(data.data() + 9, size - 9, delta))
+        {
+          cerr << "WARNING: frame " << number << " is corrupt" << endl;
+          width = height = 0;  // following frames can't be decoded
+          break;
+        }
+        if(keyframe)
+          frame = delta;
+        else
+          for(uInt32 i = 0; i < w * h; ++i)
+            frame[i] ^= delta[i];
+        width = w;  height = h;
+
+        ostringstream name;
+        name << prefix << "_" << setw(6) << setfill('0') << number << ".png";
+        if(!savePNG(name.str(), frame, width, height, palette))
+        {
+          cerr << "ERROR: couldn't write " << name.str() << endl;
+          return 1;
+        }
+        ++frames;
+        break;
+      }
+
+      case 'A':
+      {
+        if(size < 9)
+          break;
+        uInt32 rate = get32(data.data()), channels = data[4],
+               samples = get32(data.data() + 5);
+        if(!wav.is_open())
+        {
+          wav.open(prefix + ".wav", ios_base::binary);
+          writeWAVHeader(wav, rate, channels, 0);
+          wavRate = rate;  wavChannels = channels;
+        }
+        else if(rate != wavRate || channels != wavChannels)
+        {
+          cerr << "WARNING: sound format changed, skipping sound" << endl;
+          break;
+        }
+        delta.resize(samples * 2);
+        if(!inflateData(data.data() + 9, size - 9, delta))
+        {
+          cerr << "WARNING: sound data is corrupt" << endl;
+          break;
+        }
+        wav.write(reinterpret_cast<const char*>(delta.data()), delta.size());
+        wavBytes += uInt32(delta.size());
+        break;
+      }
+
+      default:  // unknown chunks are skipped
+        break;
+    }
+  }
+
+  if(wav.is_open())
+    writeWAVHeader(wav, wavRate, wavChannels, wavBytes);
+
+  cout << frames << " frames, " << (wavChannels ? wavBytes / (2 * wavChannels) : 0)
+       << " sound samples" << endl;
+
+  return 0;
+}
@@ -30,6 +30,78 @@ my $typesize = PropSet::num_prop_types();
 
 printf "Valid properties found: $setsize\n";
 
+# All distinct values are stored only once, in a string pool, and each
+# property refers to its value by index; the empty string (meaning the
+# default value) is always the first one
+my @strings = ( "" );
+my %string_index = ( "" => 0 );
+my %values = ();
+for my $key ( sort keys %propset )
+{
+  my @items = PropSet::build_prop_values(@{ $propset{$key} });
+  for my $item (@items)
+  {
+    if (!defined($string_index{$item})) {
+      $string_index{$item} = @strings;
+      push(@strings, $item);
+    }
+  }
+  $values{$key} = [ map { $string_index{$_} } @items ];
+}
+
+# The properties are stored in a perfect hash table, keyed by the md5
+# digest; each md5 is assigned to a bucket, and for each bucket a
+# displacement is found which places all its md5s into empty slots
+# The table size is prime, so that all displacements of an md5 reach
+# every slot
+my $tablesize = $setsize;
+$tablesize++ while(!is_prime($tablesize));
+my $buckets = int($setsize / 3) + 1;
+
+my %digest = ();
+my @bucket_keys = ();
+for my $key ( keys %propset )
+{
+  my @bytes = map { hex } (lc($key) =~ /(..)/g);
+  if (@bytes != 16) {
+    die "Invalid md5: $key\n";
+  }
+  $digest{$key} = [ @bytes ];
+  push(@{ $bucket_keys[hash_word(\@bytes, 0) % $buckets] }, $key);
+}
+
+my @displacement = (0) x $buckets;
+my @slot_key = (undef) x $tablesize;
+my @order = sort { scalar(@{ $bucket_keys[$b] || [] }) <=> scalar(@{ $bucket_keys[$a] || [] }) or $a <=> $b } (0 .. $buckets-1);
+for my $bucket (@order)
+{
+  my @keys = sort @{ $bucket_keys[$bucket] || [] };
+  next if (@keys == 0);
+
+  my $d;
+  for ($d = 0; $d < 65536; $d++)
+  {
+    my %used = ();
+    my $ok = 1;
+    for my $key (@keys)
+    {
+      my $slot = hash_slot($digest{$key}, $d, $tablesize);
+      if (defined($slot_key[$slot]) || defined($used{$slot})) {
+        $ok = 0;
+        last;
+      }
+      $used{$slot} = 1;
+    }
+    last if ($ok);
+  }
+  die "No displacement found for bucket $bucket\n" if ($d == 65536);
+
+  $displacement[$bucket] = $d;
+  for my $key (@keys) {
+    $slot_key[hash_slot($digest{$key}, $d, $tablesize)] = $key;
+  }
+}
+
 # Construct the output file in C++ format
 open(OUTFILE, ">$outfile");
 print OUTFILE "//============================================================================\n";
@@ -57,24 +129,55 @@ print OUTFILE "  This code is generated using the 'create_props.pl' script,\n";
 print OUTFILE "  located in the src/tools directory.  All properties changes\n";
 print OUTFILE "  should be made in stella.pro, and then this file should be\n";
 print OUTFILE "  regenerated and the application recompiled.\n";
+print OUTFILE "\n";
+print OUTFILE "  The properties are stored in a perfect hash table, keyed by the md5\n";
+print OUTFILE "  digest.  The first 32 bits of the digest select a bucket, and the\n";
+print OUTFILE "  slot is (second 32 bits + displacement of bucket * (third 32 bits\n";
+print OUTFILE "  % (DEF_PROPS_TABLE_SIZE - 1) + 1)) % DEF_PROPS_TABLE_SIZE, with each\n";
+print OUTFILE "  part reduced modulo the table size.  Each value is an index into\n";
+print OUTFILE "  DefPropsStrings, where index 0 (the empty string) means the default\n";
+print OUTFILE "  value; unused slots have index 0 for their md5.\n";
 print OUTFILE "*/\n";
 print OUTFILE "\n#define DEF_PROPS_SIZE " . $setsize;
+print OUTFILE "\n#define DEF_PROPS_TABLE_SIZE " . $tablesize;
+print OUTFILE "\n#define DEF_PROPS_BUCKETS " . $buckets;
+print OUTFILE "\n#define DEF_PROPS_STRINGS " . @strings;
 print OUTFILE "\n\n";
-print OUTFILE "static const char* const DefProps[DEF_PROPS_SIZE][" . $typesize . "] = {\n";
+print OUTFILE "struct DefPropsEntry {\n";
+print OUTFILE "  uInt8 md5[16];\n";
+print OUTFILE "  uInt16 value[" . $typesize . "];\n";
+print OUTFILE "};\n\n";
 
-# Walk the hash map and print each item in order of md5sum
-my $idx = 0;
-for my $key ( sort keys %propset )
+print OUTFILE "static const char* const DefPropsStrings[DEF_PROPS_STRINGS] = {\n";
+for (my $i = 0; $i < @strings; $i++)
 {
-  print OUTFILE PropSet::build_prop_string(@{ $propset{$key} });
-
-  if ($idx+1 < $setsize) {
-    print OUTFILE ",";
-  }
+  print OUTFILE "  \"$strings[$i]\"";
+  print OUTFILE "," if ($i+1 < @strings);
   print OUTFILE "\n";
-  $idx++;
 }
+print OUTFILE "};\n\n";
+
+print OUTFILE "static const uInt16 DefPropsHash[DEF_PROPS_BUCKETS] = {";
+for (my $i = 0; $i < $buckets; $i++)
+{
+  print OUTFILE (($i % 16 == 0) ? "\n  " : " ");
+  print OUTFILE $displacement[$i];
+  print OUTFILE "," if ($i+1 < $buckets);
+}
+print OUTFILE "\n};\n\n";
+
+print OUTFILE "static const DefPropsEntry DefProps[DEF_PROPS_TABLE_SIZE] = {\n";
+for (my $slot = 0; $slot < $tablesize; $slot++)
+{
+  my $key = $slot_key[$slot];
+  my @bytes = defined($key) ? @{ $digest{$key} } : (0) x 16;
+  my @indices = defined($key) ? @{ $values{$key} } : (0) x $typesize;
 
+  print OUTFILE "  { { " . join(", ", map { sprintf("0x%02x", $_) } @bytes) . " }, { ";
+  print OUTFILE join(", ", @indices) . " } }";
+  print OUTFILE "," if ($slot+1 < $tablesize);
+  print OUTFILE "\n";
+}
 print OUTFILE "};\n";
 print OUTFILE "\n";
 print OUTFILE "#endif\n";
@@ -82,9 +185,33 @@ print OUTFILE "#endif\n";
 close(OUTFILE);
 
 
+# Get the 32-bit little-endian word at the given position of a digest
+sub hash_word {
+  my ($bytes, $pos) = @_;
+  return $bytes->[$pos] | ($bytes->[$pos+1] << 8) |
+         ($bytes->[$pos+2] << 16) | ($bytes->[$pos+3] << 24);
+}
+
+# Get the slot of a digest for the given displacement
+sub hash_slot {
+  my ($bytes, $d, $size) = @_;
+  my $step = hash_word($bytes, 8) % ($size - 1) + 1;
+  return (hash_word($bytes, 4) % $size + $d * $step) % $size;
+}
+
+sub is_prime {
+  my $n = shift;
+  return 0 if ($n < 2);
+  for (my $i = 2; $i * $i <= $n; $i++) {
+    return 0 if ($n % $i == 0);
+  }
+  return 1;
+}
+
 sub usage {
   print "create_props.pl <INPUT properties file> <OUTPUT C++ header>\n";
   print "\n";
-  print "Convert the given properties file into a C++ compatible header file.\n";
+  print "Convert the given properties file into a C++ compatible header file,\n";
+  print "containing a perfect hash table of the properties.\n";
   exit(0);
 }
@@ -93,6 +93,16 @@ string FilesystemNodePOSIX::getShortPath() const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool FilesystemNodePOSIX::getChildren(AbstractFSList& myList, ListMode mode,
                                       bool hidden) const
+{
+  return listChildren([&myList](AbstractFSNode* node) {
+    myList.emplace_back(node);
+    return true;
+  }, mode, hidden);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool FilesystemNodePOSIX::listChildren(const ChildHandler& handler,
+                                       ListMode mode, bool hidden) const
 {
   assert(_isDirectory);
 
@@ -170,7 +180,8 @@ bool FilesystemNodePOSIX::getChildren(AbstractFSList& myList, ListMode mode,
         (mode == FilesystemNode::kListDirectoriesOnly && !entry._isDirectory))
       continue;
 
-    myList.emplace_back(new FilesystemNodePOSIX(entry));
+    if (!handler(new FilesystemNodePOSIX(entry)))
+      break;
   }
   closedir(dirp);
 
@@ -225,6 +236,18 @@ bool FilesystemNodePOSIX::rename(const string& newfile)
     return false;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool FilesystemNodePOSIX::getStamp(uInt64& size, uInt64& mtime) const
+{
+  struct stat st;
+  if(stat(_path.c_str(), &st) != 0)
+    return false;
+
+  size  = uInt64(st.st_size);
+  mtime = uInt64(st.st_mtime);
+  return true;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 AbstractFSNode* FilesystemNodePOSIX::getParent() const
 {
@@ -72,8 +72,11 @@ class FilesystemNodePOSIX : public AbstractFSNode
     bool isWritable() const override  { return access(_path.c_str(), W_OK) == 0; }
     bool makeDir() override;
     bool rename(const string& newfile) override;
+    bool getStamp(uInt64& size, uInt64& mtime) const override;
 
     bool getChildren(AbstractFSList& list, ListMode mode, bool hidden) const override;
+    bool listChildren(const ChildHandler& handler, ListMode mode,
+                      bool hidden) const override;
     AbstractFSNode* getParent() const override;
 
   protected:
@@ -67,6 +67,7 @@ class FilesystemNodeWINDOWS : public AbstractFSNode
     bool isWritable() const override;
     bool makeDir() override;
     bool rename(const string& newfile) override;
+    bool getStamp(uInt64& size, uInt64& mtime) const override;
 
     bool getChildren(AbstractFSList& list, ListMode mode, bool hidden) const override;
     AbstractFSNode* getParent() const override;